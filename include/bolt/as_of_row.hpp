@@ -0,0 +1,61 @@
+#pragma once
+
+#include <optional>
+#include <utility>
+
+#include "tick.hpp"
+#include "quote.hpp"
+
+/**
+* @file as_of_row.hpp
+* @brief Defines AsOfRow class which holds a row of an as-of join, returned by
+*        'Database::AsOfJoin' and 'Database::AsOfJoinQuotes'.
+*/
+
+namespace bolt {
+
+/**
+  * @class AsOfRow
+  * @brief Holds a tick of the left side of an as-of join and the most recent
+  *        row of the right side at or before its timestamp, if any lies within
+  *        the tolerance.
+  *
+  * @tparam RightType The type of the right side rows, Tick or Quote.
+  */
+template <typename RightType>
+class AsOfRow {
+public:
+  AsOfRow(Tick left, std::optional<RightType> right)
+    : left_(std::move(left)), right_(std::move(right)) {}
+
+  /**
+  * @brief Returns the tick of the left side.
+  */
+  auto GetLeft() const noexcept -> const Tick & {
+    return left_;
+  }
+
+  /**
+  * @brief Returns the matched row of the right side, empty if none was found
+  *        within the tolerance.
+  */
+  auto GetRight() const noexcept -> const std::optional<RightType> & {
+    return right_;
+  }
+
+  /**
+  * @brief Whether a row of the right side was matched.
+  */
+  auto HasMatch() const noexcept -> bool {
+    return right_.has_value();
+  }
+
+private:
+  Tick left_;
+  std::optional<RightType> right_;
+};
+
+using JoinedTick = AsOfRow<Tick>;
+using JoinedQuote = AsOfRow<Quote>;
+
+}
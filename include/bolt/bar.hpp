@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "macros.hpp"
+
+/**
+* @file bar.hpp
+* @brief Defines Bar class which holds the OHLCV values of a single time bucket,
+*        returned by 'Database::Bars'.
+*/
+
+namespace bolt {
+
+/**
+  * @class Bar
+  * @brief Holds the open, high, low, close, volume, vwap and count of the
+  *        ticks of one time bucket.
+  */
+class Bar {
+  TEST_FRIEND(BarTest);
+
+public:
+  Bar() = default;
+  Bar(uint64_t timestamp,
+      double open, double high, double low, double close,
+      uint64_t volume, double vwap, size_t count);
+
+  Bar(const Bar &) = default;
+  Bar(Bar &&) = default;
+
+  auto operator=(const Bar &) -> Bar & = default;
+  auto operator=(Bar &&) noexcept -> Bar & = default;
+
+  auto operator==(const Bar &other) const noexcept -> bool;
+  auto operator!=(const Bar &other) const noexcept -> bool;
+
+  /**
+  * @brief Sets the start of the time bucket the bar covers.
+  *
+  * @param timestamp The (inclusive) start timestamp of the bucket.
+  */
+  auto SetTimestamp(uint64_t timestamp) noexcept -> void;
+
+  /**
+  * @brief Sets the price of the earliest tick of the bucket.
+  *
+  * @param open The open price to store.
+  */
+  auto SetOpen(double open) noexcept -> void;
+
+  /**
+  * @brief Sets the highest price of the bucket.
+  *
+  * @param high The high price to store.
+  */
+  auto SetHigh(double high) noexcept -> void;
+
+  /**
+  * @brief Sets the lowest price of the bucket.
+  *
+  * @param low The low price to store.
+  */
+  auto SetLow(double low) noexcept -> void;
+
+  /**
+  * @brief Sets the price of the latest tick of the bucket.
+  *
+  * @param close The close price to store.
+  */
+  auto SetClose(double close) noexcept -> void;
+
+  /**
+  * @brief Sets the sum of the volumes of the bucket.
+  *
+  * @param volume The total volume to store.
+  */
+  auto SetVolume(uint64_t volume) noexcept -> void;
+
+  /**
+  * @brief Sets the Volume Weighted Average Price (VWAP) of the bucket.
+  *
+  * @param vwap The vwap value to store.
+  */
+  auto SetVwap(double vwap) noexcept -> void;
+
+  /**
+  * @brief Sets the number of ticks in the bucket.
+  *
+  * @param count The count of ticks.
+  */
+  auto SetCount(size_t count) noexcept -> void;
+
+  /**
+  * @brief Gets the start of the time bucket the bar covers.
+  *
+  * @return The (inclusive) start timestamp of the bucket.
+  */
+  auto GetTimestamp() const noexcept -> uint64_t;
+
+  /**
+  * @brief Gets the price of the earliest tick of the bucket.
+  *
+  * @return The open price.
+  */
+  auto GetOpen() const noexcept -> double;
+
+  /**
+  * @brief Gets the highest price of the bucket.
+  *
+  * @return The high price.
+  */
+  auto GetHigh() const noexcept -> double;
+
+  /**
+  * @brief Gets the lowest price of the bucket.
+  *
+  * @return The low price.
+  */
+  auto GetLow() const noexcept -> double;
+
+  /**
+  * @brief Gets the price of the latest tick of the bucket.
+  *
+  * @return The close price.
+  */
+  auto GetClose() const noexcept -> double;
+
+  /**
+  * @brief Gets the sum of the volumes of the bucket.
+  *
+  * @return The total volume.
+  */
+  auto GetVolume() const noexcept -> uint64_t;
+
+  /**
+  * @brief Gets the Volume Weighted Average Price of the bucket.
+  *
+  * @return The vwap value.
+  */
+  auto GetVwap() const noexcept -> double;
+
+  /**
+  * @brief Gets the number of ticks in the bucket.
+  *
+  * @return The count of ticks.
+  */
+  auto GetCount() const noexcept -> size_t;
+
+private:
+  uint64_t timestamp_ {};
+  double open_ {};
+  double high_ {};
+  double low_ {};
+  double close_ {};
+  uint64_t volume_ {};
+  double vwap_ {};
+  size_t count_ {};
+
+  auto EqualityCheck_(const Bar &other) const noexcept -> bool;
+};
+
+}
@@ -7,6 +7,18 @@
 
 #include "database.hpp"
 #include "tick.hpp"
-#include "database.hpp"
+#include "quote.hpp"
+#include "config.hpp"
+#include "range_cursor.hpp"
+#include "tick_page.hpp"
+#include "continuous_query.hpp"
+#include "rolling_series.hpp"
+#include "quantile_result.hpp"
+#include "as_of_row.hpp"
+#include "tick_columns.hpp"
 #include "trade_conditions.hpp"
 #include "aggregate_result.hpp"
+#include "bar.hpp"
+#include "predicate.hpp"
+#include "quote_aggregate_result.hpp"
+#include "table.hpp"
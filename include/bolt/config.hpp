@@ -0,0 +1,180 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "macros.hpp"
+
+/**
+* @file config.hpp
+* @brief Defines Config class which holds the tunable settings of a 'Database' instance.
+*/
+
+namespace bolt {
+
+/**
+  * @class Config
+  * @brief Holds the settings used to construct a Database.
+  *
+  * A default constructed object holds sensible defaults, every setting
+  * can then be overridden individually before passing it to the Database.
+  */
+class Config {
+  TEST_FRIEND(ConfigTest);
+
+public:
+  Config();
+
+  Config(const Config &) = default;
+  Config(Config &&) = default;
+
+  auto operator=(const Config &) -> Config & = default;
+  auto operator=(Config &&) noexcept -> Config & = default;
+
+  /**
+  * @brief Sets the memory budget (in bytes) for the stored data.
+  *
+  * The budget covers the sealed buffers, the active buffers and the
+  * indexing structures attached to them, of the ticks, the quotes and the
+  * tables created by 'Database::CreateTable' together. It is split between
+  * them (see SetQuoteMemoryShare and SetTableMemoryShare), each table
+  * evicting its own oldest sealed buffers first once its part is
+  * exceeded. The active buffers are never evicted, so the budget should
+  * leave room for at least one buffer per table.
+  *
+  * @param memory_budget The maximum number of bytes the stored data can occupy.
+  */
+  auto SetMemoryBudget(size_t memory_budget) noexcept -> void;
+
+  /**
+  * @brief Gets the memory budget (in bytes) for the stored data.
+  *
+  * @return The maximum number of bytes the stored data can occupy.
+  */
+  auto GetMemoryBudget() const noexcept -> size_t;
+
+  /**
+  * @brief Sets the fraction of the memory budget reserved for the quotes.
+  *
+  * The ticks get the rest of the budget, e.g. with a share of 0.25 and a
+  * budget of 64MB the quotes may occupy up to 16MB and the ticks up to 48MB.
+  *
+  * @param quote_memory_share The fraction of the budget for the quotes, in [0, 1].
+  */
+  auto SetQuoteMemoryShare(double quote_memory_share) noexcept -> void;
+
+  /**
+  * @brief Gets the fraction of the memory budget reserved for the quotes.
+  *
+  * @return The fraction of the budget for the quotes, in [0, 1].
+  */
+  auto GetQuoteMemoryShare() const noexcept -> double;
+
+  /**
+  * @brief Sets the fraction of the memory budget given to each table created
+  *        by 'Database::CreateTable'.
+  *
+  * The part of every table is taken from the one of the ticks, e.g. with the
+  * default shares and a budget of 64MB, after creating one table the quotes
+  * may occupy up to 16MB, the table up to 6.4MB and the ticks up to 41.6MB.
+  * A table never takes more than what is left to the ticks.
+  *
+  * @param table_memory_share The fraction of the budget per table, in [0, 1].
+  */
+  auto SetTableMemoryShare(double table_memory_share) noexcept -> void;
+
+  /**
+  * @brief Gets the fraction of the memory budget given to each user defined table.
+  *
+  * @return The fraction of the budget per table, in [0, 1].
+  */
+  auto GetTableMemoryShare() const noexcept -> double;
+
+  /**
+  * @brief Sets the time-to-live of the stored data.
+  *
+  * The period is expressed in the same unit as the tick timestamps and is
+  * measured back from the newest timestamp ingested, e.g. to keep the last
+  * 4 hours of nanosecond timestamps pass (4h in ns). Sealed buffers which
+  * lie entirely before that horizon are dropped in the background (see
+  * SetExpiryInterval), the boundary buffer is only trimmed (lazily) when
+  * it is queried.
+  *
+  * @param retention_period The period to keep the data for, 0 disables the expiry.
+  */
+  auto SetRetentionPeriod(uint64_t retention_period) noexcept -> void;
+
+  /**
+  * @brief Gets the time-to-live of the stored data.
+  *
+  * @return The period to keep the data for, 0 if the expiry is disabled.
+  */
+  auto GetRetentionPeriod() const noexcept -> uint64_t;
+
+  /**
+  * @brief Sets how often (in milliseconds) a background task expires the stored data.
+  *
+  * Without it the data only expires as newer timestamps are ingested, so the
+  * data of an idle feed is kept. While the task is enabled, the horizon also
+  * advances with the wall clock time (in nanoseconds, like the timestamps)
+  * passed since the newest timestamp was ingested, and the task publishes
+  * the trimmed state on its own.
+  *
+  * @param expiry_interval The period of the expiry task, 0 disables it.
+  */
+  auto SetExpiryInterval(uint64_t expiry_interval) noexcept -> void;
+
+  /**
+  * @brief Gets how often (in milliseconds) a background task expires the stored data.
+  *
+  * @return The period of the expiry task, 0 if it is disabled.
+  */
+  auto GetExpiryInterval() const noexcept -> uint64_t;
+
+  /**
+  * @brief Sets the fixed-point scale the prices are stored with.
+  *
+  * With a scale (e.g. 1e-4) the prices are stored as integer multiples of it,
+  * which keeps the aggregates (sums, VWAP) exact and reproducible. Prices are
+  * only converted from and to double at the API boundary.
+  *
+  * @param price_scale The smallest price increment, 0 stores the prices as double.
+  */
+  auto SetPriceScale(double price_scale) noexcept -> void;
+
+  /**
+  * @brief Gets the fixed-point scale the prices are stored with.
+  *
+  * @return The smallest price increment, 0 if the prices are stored as double.
+  */
+  auto GetPriceScale() const noexcept -> double;
+
+  /**
+  * @brief Sets the number of rows above which a query is split across the thread pool.
+  *
+  * Range and aggregate queries covering at least that many rows of the sealed
+  * buffers are split by buffer, the parts are processed by the pool workers (and
+  * the calling thread) and their results combined. Smaller queries run inline,
+  * as do the ones issued while the pool still has queued work (e.g. during ingest).
+  *
+  * @param parallel_query_threshold The minimum number of rows to split a query at.
+  */
+  auto SetParallelQueryThreshold(size_t parallel_query_threshold) noexcept -> void;
+
+  /**
+  * @brief Gets the number of rows above which a query is split across the thread pool.
+  *
+  * @return The minimum number of rows to split a query at.
+  */
+  auto GetParallelQueryThreshold() const noexcept -> size_t;
+
+private:
+  size_t memory_budget_ {};
+  double quote_memory_share_ {};
+  double table_memory_share_ {};
+  uint64_t retention_period_ {};
+  uint64_t expiry_interval_ {};
+  double price_scale_ {};
+  size_t parallel_query_threshold_ {};
+};
+
+}
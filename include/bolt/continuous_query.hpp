@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "macros.hpp"
+
+/**
+* @file continuous_query.hpp
+* @brief Defines the ContinuousQuery class, returned by 'Database::RegisterContinuousQuery'.
+*/
+
+namespace bolt {
+
+class AggregateResult;
+class Subscription;
+
+/**
+  * @class ContinuousQuery
+  * @brief A handle to the aggregate values of a sliding window, kept up to date on ingest.
+  *
+  * The window covers the 'window' timestamps up to the latest ingested one, i.e.
+  * the same ticks as 'Aggregate(latest - window, latest, predicate)', but the
+  * values are updated incrementally by the ingest thread for every tick instead
+  * of being recomputed by a scan. Only the ticks ingested after the registration
+  * are taken into account.
+  *
+  * The query is unregistered once the last handle to it is destroyed.
+  */
+class ContinuousQuery {
+  friend class Database;
+
+public:
+  /**
+  * @brief Called by the ingest thread with the new values after every change,
+  *        so it should return quickly.
+  */
+  using callback_func = std::function<void(const AggregateResult &)>;
+
+  ContinuousQuery() = default;
+
+  /**
+  * @brief Returns the current aggregate values of the window.
+  *
+  * The values are read without any lock, as a consistent snapshot.
+  *
+  * @return A object of AggregateResult, empty for a default constructed handle.
+  *
+  * @note This function is thread safe.
+  */
+  auto GetResult() const noexcept -> AggregateResult;
+
+  /**
+  * @brief Returns the length of the window, in timestamps.
+  */
+  auto GetWindow() const noexcept -> uint64_t;
+
+private:
+  std::shared_ptr<const Subscription> subscription_;
+
+  explicit ContinuousQuery(std::shared_ptr<const Subscription> subscription);
+};
+
+}
@@ -2,8 +2,24 @@
 #include <condition_variable>
 #include <atomic>
 #include <functional>
+#include <map>
+#include <optional>
+#include <type_traits>
 
 #include "macros.hpp"
+#include "config.hpp"
+#include "schema.hpp"
+#include "tick.hpp"
+#include "aggregate_result.hpp"
+#include "range_cursor.hpp"
+#include "tick_page.hpp"
+#include "continuous_query.hpp"
+#include "rolling_series.hpp"
+#include "quantile_result.hpp"
+#include "as_of_row.hpp"
+#include "tick_columns.hpp"
+#include "predicate.hpp"
+#include "table.hpp"
 
 /**
 * @file database.hpp
@@ -11,30 +27,71 @@
 */
 
 namespace bolt {
-class RingBuffer;
 class ThreadPool;
-class BufferManager;
 class Tick;
-class State;
+class Quote;
 class Buffer;
 class AggregateResult;
+class QuoteAggregateResult;
+class Bar;
+class Subscription;
+
+template <typename RecordType> class BasicRingBuffer;
+template <typename SchemaType> class BasicBuffer;
+template <typename BufferType> class BasicState;
+template <typename BufferType, typename RecordType> class BasicBufferManager;
+
+using QuoteBuffer = BasicBuffer<QuoteSchema>;
+
+using RingBuffer = BasicRingBuffer<Tick>;
+using QuoteRingBuffer = BasicRingBuffer<Quote>;
+
+using State = BasicState<Buffer>;
+using QuoteState = BasicState<QuoteBuffer>;
+
+using BufferManager = BasicBufferManager<Buffer, Tick>;
+using QuoteBufferManager = BasicBufferManager<QuoteBuffer, Quote>;
+
+// Any callable filter of ticks (or TickViews) other than a Database::filter_func
+// itself, which keeps its own (ABI stable) overloads. The Tick form is checked
+// first: checking a generic lambda against TickView instantiates its body, which
+// is a hard error if it uses members only a Tick has.
+template <typename Filter>
+concept TickFilter =
+  !std::is_same_v<std::remove_cvref_t<Filter>, std::function<bool(const Tick &)>> &&
+  (std::is_invocable_r_v<bool, Filter &, const Tick &> ||
+   std::is_invocable_r_v<bool, Filter &, const TickView &>);
 
 /**
   * @class Database
-  * @brief Manages the in-memory storage, retrieval and aggregation of Tick data.
+  * @brief Manages the in-memory storage, retrieval and aggregation of Tick and Quote data.
   *
   * This class provides a thread-safe interface for inserting and querying time-series
   * data. All insertion operations are batched and handled by a background thread to
   * achieve high throughput.
+  *
+  * Ticks and quotes are kept in separate tables, both are fed by the same ingest
+  * thread and share the same thread pool for sealing and compaction. The
+  * retention period of the Config applies to each table, the memory budget is
+  * split between them (see Config::SetQuoteMemoryShare).
   */
 class Database {
   TEST_FRIEND(DatabaseTest);
+  TEST_FRIEND(TableTest);
 
 public:
   using filter_func = std::function<bool(const Tick &)>;
+  using quote_filter_func = std::function<bool(const Quote &)>;
 
   Database();
 
+  /**
+  * @brief Creates a database using the provided settings.
+  *
+  * @param config The settings (e.g. memory budget) to construct the database with.
+  */
+  explicit Database(const Config &config);
+
   Database(const Database &) = delete;
   Database(Database &&) = delete;
 
@@ -64,6 +121,24 @@ public:
   */
   auto Insert(const Tick &tick) noexcept -> void;
 
+  /**
+  * @brief Inserts a batch of quotes into the database.
+  *
+  * The quotes are ingested asynchronously, in the same way as the ticks.
+  *
+  * @param quotes A vector of Quote objects to be stored.
+  * @note This function is thread safe.
+  */
+  auto Insert(const std::vector<Quote> &quotes) noexcept -> void;
+
+  /**
+  * @brief Inserts a single quote object to database.
+  *
+  * @param quote A single Quote object to store.
+  * @note This function is thread safe.
+  */
+  auto Insert(const Quote &quote) noexcept -> void;
+
   /**
   * @brief Fetches all the data for the provided time range (inclusive).
   *
@@ -103,12 +178,136 @@ public:
   * @param filter A callable type in which a Tick object can be passed and returns a boolean value.
   * @return A vector of Tick object.
   *
-  * @note This function is thread safe.
+  * @note This function is thread safe. Above the parallel query threshold
+  *       (see Config) the filter is called from several threads at once.
   */
   auto GetForRange(uint64_t start_ts,
                    uint64_t end_ts,
                    const filter_func &filter) -> std::vector<Tick>;
 
+  /**
+  * @brief Fetches all the data for the provided time range (inclusive)
+  *        which matches the provided predicate.
+  *
+  * The predicate is evaluated over the stored columns, blocks of rows which
+  * can not match are skipped entirely, so unlike a filter callable no Tick
+  * is built for the rows that are discarded.
+  *
+  * @param start_ts The start of the time range (inclusive).
+  * @param end_ts The end of the time range (inclusive).
+  * @param predicate The Predicate the ticks have to match.
+  * @return A vector of Tick object.
+  *
+  * @note This function is thread safe.
+  */
+  auto GetForRange(uint64_t start_ts,
+                   uint64_t end_ts,
+                   const Predicate &predicate) -> std::vector<Tick>;
+
+  /**
+  * @brief Fetches all the data for the provided time range (inclusive)
+  *        which passes the provided filter, inlined into the scan.
+  *
+  * Same as the 'filter_func' overload, except that the filter keeps its own
+  * type: the loop over the rows is instantiated for it, so a simple filter is
+  * inlined (and possibly vectorized) instead of called through a std::function
+  * per row. Only a filter taking a TickView avoids copying the rows: it reads
+  * the stored columns directly, while one taking a Tick (or a generic
+  * 'const auto &') gets a Tick built from every row of the range.
+  *
+  * @param start_ts The start of the time range (inclusive).
+  * @param end_ts The end of the time range (inclusive).
+  * @param filter A callable taking a TickView or a Tick and returning a boolean value.
+  * @return A vector of Tick object.
+  *
+  * @note This function is thread safe. Above the parallel query threshold
+  *       (see Config) the filter is called from several threads at once.
+  */
+  template <TickFilter Filter>
+  auto GetForRange(uint64_t start_ts,
+                   uint64_t end_ts,
+                   Filter &&filter) -> std::vector<Tick>;
+
+  /**
+  * @brief Returns a cursor over the rows of the time range (inclusive),
+  *        without copying them.
+  *
+  * The cursor references the stored columns directly and keeps the current
+  * snapshot alive for its lifetime, so later inserts are not visible through it.
+  * Unlike GetForRange the rows are yielded per buffer and are therefore not
+  * necessarily in timestamp order (see RangeCursor::IsSorted).
+  *
+  * @param start_ts The start of the time range (inclusive).
+  * @param end_ts The end of the time range (inclusive).
+  * @return A RangeCursor over the matching rows.
+  *
+  * @note This function is thread safe.
+  */
+  auto GetRangeCursor(uint64_t start_ts,
+                      uint64_t end_ts) const -> RangeCursor;
+
+  /**
+  * @brief Fetches the first 'limit' ticks of the time range (inclusive),
+  *        in timestamp order.
+  *
+  * The buffers of the range are merged lazily and the scan stops as soon as
+  * the page is full, the returned page carries a ContinuationToken to fetch
+  * the following ticks with, e.g.
+  *
+  *   auto page = db.GetPage(start, end, 1000);
+  *   while (page.HasMore()) page = db.GetPage(page.GetContinuationToken());
+  *
+  * All the pages are read from the snapshot of the first call, see ContinuationToken.
+  *
+  * @warning A token keeps the buffers of its range in memory, past the retention
+  *          period and the memory budget, until it is released.
+  *
+  * @param start_ts The start of the time range (inclusive).
+  * @param end_ts The end of the time range (inclusive).
+  * @param limit The maximum number of ticks per page, a limit of 0 yields an
+  *              empty page without a continuation token.
+  * @param descending Whether to return the latest ticks first.
+  * @return A TickPage holding at most 'limit' ticks.
+  *
+  * @note This function is thread safe.
+  */
+  auto GetPage(uint64_t start_ts,
+               uint64_t end_ts,
+               size_t limit,
+               bool descending = false) const -> TickPage;
+
+  /**
+  * @brief Fetches the page following the one the token was returned with.
+  *
+  * The limit and the order of the first call are kept.
+  *
+  * @param token The ContinuationToken of the previous page.
+  * @return The next TickPage, empty if the token is exhausted.
+  *
+  * @note This function is thread safe, a token may be resumed from any thread.
+  */
+  auto GetPage(const ContinuationToken &token) const -> TickPage;
+
+  /**
+  * @brief Fetches the requested columns of the time range (inclusive) as
+  *        contiguous arrays, sorted by the timestamps.
+  *
+  * The columns are bulk copied out of the stored buffers, so no Tick
+  * object is built, e.g.
+  *
+  *   db.GetColumnsForRange(start, end, TickColumn::kPrice | TickColumn::kVolume);
+  *
+  * @param start_ts The start of the time range (inclusive).
+  * @param end_ts The end of the time range (inclusive).
+  * @param columns The columns to fetch, all of them by default.
+  * @return A TickColumns object holding the requested columns.
+  *
+  * @note This function is thread safe.
+  */
+  auto GetColumnsForRange(uint64_t start_ts,
+                          uint64_t end_ts,
+                          TickColumn columns = TickColumn::kAll) const -> TickColumns;
+
   /**
   * @brief Provides useful and commonly used aggregate values.
   *
@@ -142,12 +341,427 @@ public:
   * @param filter A callable type in which a Tick object can be passed and returns a boolean value.
   * @return A object of AggregateResult.
   *
-  * @note This function is thread safe.
+  * @note This function is thread safe. Above the parallel query threshold
+  *       (see Config) the filter is called from several threads at once.
   */
   auto Aggregate(uint64_t start_ts,
                  uint64_t end_ts,
                  const filter_func &filter) -> AggregateResult;
 
+  /**
+  * @brief Provides the aggregate values of the ticks matching the provided predicate.
+  *
+  * The predicate is evaluated over the stored columns, blocks of rows which
+  * it matches entirely contribute their precomputed summaries and the ones
+  * it can not match are skipped.
+  *
+  * @param start_ts The start of the time range (inclusive).
+  * @param end_ts The end of the time range (inclusive).
+  * @param predicate The Predicate the ticks have to match.
+  * @return A object of AggregateResult.
+  *
+  * @note This function is thread safe.
+  */
+  auto Aggregate(uint64_t start_ts,
+                 uint64_t end_ts,
+                 const Predicate &predicate) -> AggregateResult;
+
+  /**
+  * @brief Provides the aggregate values of the ticks passing the provided filter,
+  *        inlined into the scan.
+  *
+  * See the templated 'GetForRange' for how the filter is applied.
+  *
+  * @param start_ts The start of the time range (inclusive).
+  * @param end_ts The end of the time range (inclusive).
+  * @param filter A callable taking a TickView or a Tick and returning a boolean value.
+  * @return A object of AggregateResult.
+  *
+  * @note This function is thread safe. Above the parallel query threshold
+  *       (see Config) the filter is called from several threads at once.
+  */
+  template <TickFilter Filter>
+  auto Aggregate(uint64_t start_ts,
+                 uint64_t end_ts,
+                 Filter &&filter) -> AggregateResult;
+
+  /**
+  * @brief Provides the aggregate values of every symbol in the time range (inclusive).
+  *
+  * All the symbols are aggregated in a single pass over the range, instead
+  * of a filtered 'Aggregate' call (and scan) per symbol.
+  *
+  * @param start_ts The start of the time range (inclusive).
+  * @param end_ts The end of the time range (inclusive).
+  * @return The AggregateResult of every symbol with ticks in the range, keyed by symbol id.
+  *
+  * @note This function is thread safe.
+  */
+  auto AggregateBySymbol(uint64_t start_ts,
+                         uint64_t end_ts) -> std::map<uint32_t, AggregateResult>;
+
+  /**
+  * @brief Provides the aggregate values of every exchange in the time range (inclusive).
+  *
+  * @param start_ts The start of the time range (inclusive).
+  * @param end_ts The end of the time range (inclusive).
+  * @return The AggregateResult of every exchange with ticks in the range, keyed by exchange id.
+  *
+  * @note This function is thread safe.
+  */
+  auto AggregateByExchange(uint64_t start_ts,
+                           uint64_t end_ts) -> std::map<uint32_t, AggregateResult>;
+
+  /**
+  * @brief Provides the OHLCV bars of the time range, one per bucket of the interval.
+  *
+  * The range is split into buckets of 'interval' timestamps starting at start_ts,
+  * every bucket holding at least one tick produces a Bar with its open (earliest
+  * tick), high, low, close (latest tick), volume, vwap and count. All the bars
+  * are computed in a single pass over the stored rows.
+  *
+  * @param start_ts The start of the time range (inclusive), also the start of the first bucket.
+  * @param end_ts The end of the time range (inclusive).
+  * @param interval The length of a bucket, no bars are returned for an interval of 0.
+  * @return A vector of Bar objects sorted by their timestamps, empty buckets are skipped.
+  *
+  * @note This function is thread safe.
+  */
+  auto Bars(uint64_t start_ts,
+            uint64_t end_ts,
+            uint64_t interval) -> std::vector<Bar>;
+
+  /**
+  * @brief Provides the OHLCV bars of a single symbol, one per bucket of the interval.
+  *
+  * @param start_ts The start of the time range (inclusive), also the start of the first bucket.
+  * @param end_ts The end of the time range (inclusive).
+  * @param interval The length of a bucket, no bars are returned for an interval of 0.
+  * @param symbol_id The symbol the ticks have to belong to.
+  * @return A vector of Bar objects sorted by their timestamps, empty buckets are skipped.
+  *
+  * @note This function is thread safe.
+  */
+  auto Bars(uint64_t start_ts,
+            uint64_t end_ts,
+            uint64_t interval,
+            uint32_t symbol_id) -> std::vector<Bar>;
+
+  /**
+  * @brief Provides the price and trade size (volume) quantiles of the ticks in
+  *        the time range (inclusive), e.g. the median and the p95 / p99.
+  *
+  * Every sealed buffer carries mergeable quantile sketches of its prices and
+  * volumes, so the buffers entirely inside the range are merged instead of
+  * read and only the rows at the edges of the range are scanned. The values
+  * are approximate, within about 1% of the requested rank, and exact for
+  * ranges of up to 200 ticks.
+  *
+  * @param start_ts The start of the time range (inclusive).
+  * @param end_ts The end of the time range (inclusive).
+  * @param quantiles The quantiles to compute, each in [0, 1].
+  * @return A object of QuantileResult, holding 0 for every quantile of an empty range.
+  *
+  * @note This function is thread safe.
+  */
+  auto Quantiles(uint64_t start_ts,
+                 uint64_t end_ts,
+                 const std::vector<double> &quantiles) -> QuantileResult;
+
+  /**
+  * @brief Counts the distinct symbols traded in the time range (inclusive).
+  *
+  * Every sealed buffer carries sketches (HyperLogLog) of its distinct symbols,
+  * so the buffers entirely inside the range are merged instead of read and
+  * only the rows at the edges of the range are scanned, making the cost
+  * independent of the number of ticks in the range. Counts of up to about a
+  * thousand are exact, larger ones are estimated within about 2%.
+  *
+  * @param start_ts The start of the time range (inclusive).
+  * @param end_ts The end of the time range (inclusive).
+  * @return The number of distinct symbol ids.
+  *
+  * @note This function is thread safe.
+  */
+  auto CountDistinctSymbols(uint64_t start_ts,
+                            uint64_t end_ts) -> size_t;
+
+  /**
+  * @brief Counts the distinct symbols traded on an exchange in the time range
+  *        (inclusive), e.g. the breadth of a venue.
+  *
+  * @param start_ts The start of the time range (inclusive).
+  * @param end_ts The end of the time range (inclusive).
+  * @param exchange_id The exchange the ticks are traded on.
+  * @return The number of distinct symbol ids.
+  *
+  * @note This function is thread safe.
+  */
+  auto CountDistinctSymbols(uint64_t start_ts,
+                            uint64_t end_ts,
+                            uint32_t exchange_id) -> size_t;
+
+  /**
+  * @brief Counts the distinct exchanges traded on in the time range (inclusive).
+  *
+  * @param start_ts The start of the time range (inclusive).
+  * @param end_ts The end of the time range (inclusive).
+  * @return The number of distinct exchange ids.
+  *
+  * @note This function is thread safe.
+  */
+  auto CountDistinctExchanges(uint64_t start_ts,
+                              uint64_t end_ts) -> size_t;
+
+  /**
+  * @brief Computes rolling window metrics (moving averages, vwap, volatility,
+  *        min, max and volume) over the ticks of the time range.
+  *
+  * A point is emitted for every tick of the range, holding the metrics of the
+  * window [timestamp - window, timestamp]. All of them are computed in a single
+  * pass over the stored rows in timestamp order, every tick being added to and
+  * later retired from the window in O(1) (amortized), without building the
+  * list of ticks first. The ticks up to 'window' before start_ts are read as
+  * well, so the first points already cover a full window.
+  *
+  * @param start_ts The start of the time range (inclusive).
+  * @param end_ts The end of the time range (inclusive).
+  * @param window The length of the window, in timestamps.
+  * @param metrics The metrics to compute, all of them by default.
+  * @return A RollingSeries holding a point per tick of the range.
+  *
+  * @note This function is thread safe.
+  */
+  auto Rolling(uint64_t start_ts,
+               uint64_t end_ts,
+               uint64_t window,
+               RollingMetric metrics = RollingMetric::kAll) -> RollingSeries;
+
+  /**
+  * @brief Computes rolling window metrics over the ticks of a single symbol.
+  *
+  * @param start_ts The start of the time range (inclusive).
+  * @param end_ts The end of the time range (inclusive).
+  * @param window The length of the window, in timestamps.
+  * @param metrics The metrics to compute.
+  * @param symbol_id The symbol the ticks have to belong to.
+  * @return A RollingSeries holding a point per tick of the symbol in the range.
+  *
+  * @note This function is thread safe.
+  */
+  auto Rolling(uint64_t start_ts,
+               uint64_t end_ts,
+               uint64_t window,
+               RollingMetric metrics,
+               uint32_t symbol_id) -> RollingSeries;
+
+  /**
+  * @brief Joins every tick of the left side with the most recent tick of the
+  *        right side at or before its timestamp (as-of join), e.g. the trades
+  *        of a symbol with the latest trade of another one.
+  *
+  * Both sides are read in a single ordered pass over the stored columns, so
+  * neither is materialized. Sealed buffers which can hold no tick of either
+  * side (according to their zone maps) are skipped.
+  *
+  * @param start_ts The start of the time range of the left side (inclusive).
+  * @param end_ts The end of the time range of the left side (inclusive).
+  * @param left The predicate selecting the ticks of the left side.
+  * @param right The predicate selecting the ticks of the right side.
+  * @param tolerance How far back (in timestamps) the right tick may lie,
+  *                  older ones are not matched.
+  * @return A JoinedTick per tick of the left side, in ascending timestamp
+  *         order, without a right tick if none lies within the tolerance.
+  *
+  * @note This function is thread safe.
+  */
+  auto AsOfJoin(uint64_t start_ts,
+                uint64_t end_ts,
+                const Predicate &left,
+                const Predicate &right,
+                uint64_t tolerance) -> std::vector<JoinedTick>;
+
+  /**
+  * @brief Registers a query kept up to date by the ingest thread, over a
+  *        sliding window ending at the latest ingested timestamp.
+  *
+  * Instead of polling 'Aggregate' over the last 'window' timestamps, the
+  * returned ContinuousQuery holds the same values, updated incrementally as
+  * the ticks are ingested (adding the new ticks and retiring the ones which
+  * fell out of the window), e.g. the rolling vwap of a symbol:
+  *
+  *   auto query = db.RegisterContinuousQuery(60'000'000'000, Predicate::SymbolIs(1));
+  *   auto vwap = query.GetResult().GetVwap();
+  *
+  * @param window The length of the window, in timestamps.
+  * @param predicate The Predicate the ticks have to match, all of them by default.
+  * @param callback Optionally called by the ingest thread whenever the values change.
+  * @return A ContinuousQuery handle, the query is dropped with its last handle.
+  *
+  * @note This function is thread safe.
+  */
+  auto RegisterContinuousQuery(uint64_t window,
+                               const Predicate &predicate = Predicate(),
+                               ContinuousQuery::callback_func callback = nullptr) -> ContinuousQuery;
+
+  /**
+  * @brief Fetches all the quotes for the provided time range (inclusive).
+  *
+  * @param start_ts The start of the time range (inclusive).
+  * @param end_ts The end of the time range (inclusive).
+  * @return A vector of Quote objects sorted by their timestamps.
+  *
+  * @note This function is thread safe.
+  */
+  auto GetQuotesForRange(uint64_t start_ts,
+                         uint64_t end_ts) -> std::vector<Quote>;
+
+  /**
+  * @brief Fetches all the quotes for the provided time range (inclusive)
+  *        which pass the provided filter.
+  *
+  * @param start_ts The start of the time range (inclusive).
+  * @param end_ts The end of the time range (inclusive).
+  * @param filter A callable type in which a Quote object can be passed and returns a boolean value.
+  * @return A vector of Quote objects sorted by their timestamps.
+  *
+  * @note This function is thread safe.
+  */
+  auto GetQuotesForRange(uint64_t start_ts,
+                         uint64_t end_ts,
+                         const quote_filter_func &filter) -> std::vector<Quote>;
+
+  /**
+  * @brief Provides the spread statistics of the quotes in the time range (inclusive).
+  *
+  * The spread of every quote is weighted by the time until the next quote of the
+  * range, so it is usually combined with a filter selecting a single symbol.
+  *
+  * @param start_ts The start of the time range (inclusive).
+  * @param end_ts The end of the time range (inclusive).
+  * @return A object of QuoteAggregateResult.
+  *
+  * @note This function is thread safe.
+  */
+  auto AggregateQuotes(uint64_t start_ts,
+                       uint64_t end_ts) -> QuoteAggregateResult;
+
+  /**
+  * @brief Provides the spread statistics of the quotes in the time range (inclusive)
+  *        which pass the provided filter.
+  *
+  * @param start_ts The start of the time range (inclusive).
+  * @param end_ts The end of the time range (inclusive).
+  * @param filter A callable type in which a Quote object can be passed and returns a boolean value.
+  * @return A object of QuoteAggregateResult.
+  *
+  * @note This function is thread safe.
+  */
+  auto AggregateQuotes(uint64_t start_ts,
+                       uint64_t end_ts,
+                       const quote_filter_func &filter) -> QuoteAggregateResult;
+
+  /**
+  * @brief Joins every trade (tick) of the left side with the most recent quote
+  *        at or before its timestamp (as-of join), e.g. for transaction cost
+  *        analysis against the prevailing bid and ask.
+  *
+  * The ticks are read in a single ordered pass over the stored columns, only
+  * the quotes passing the filter are collected.
+  *
+  * @param start_ts The start of the time range of the trades (inclusive).
+  * @param end_ts The end of the time range of the trades (inclusive).
+  * @param trades The predicate selecting the ticks of the left side.
+  * @param quotes A callable type selecting the quotes of the right side.
+  * @param tolerance How far back (in timestamps) the quote may lie, older ones
+  *                  are not matched.
+  * @return A JoinedQuote per selected tick, in ascending timestamp order,
+  *         without a quote if none lies within the tolerance.
+  *
+  * @note This function is thread safe.
+  */
+  auto AsOfJoinQuotes(uint64_t start_ts,
+                      uint64_t end_ts,
+                      const Predicate &trades,
+                      const quote_filter_func &quotes,
+                      uint64_t tolerance) -> std::vector<JoinedQuote>;
+
+  /**
+  * @brief Creates a table storing the records of a user defined Schema next
+  *        to the ticks and quotes (see table.hpp).
+  *
+  * The ticks keep their own storage, it additionally carries the fixed-point
+  * prices, the summaries and the sketches the tick queries are answered from.
+  *
+  * The table keeps the retention period of the Database. Its memory budget
+  * is the table share of the Database budget (see Config::SetTableMemoryShare),
+  * taken from the part of the ticks, which evict their oldest buffers to fit.
+  *
+  * @return A Table handle, usable while the Database is alive. Its rows are
+  *         readable once published by the background threads, see 'Flush'.
+  *
+  * @note This function is thread safe.
+  */
+  template <typename SchemaType>
+  auto CreateTable() -> Table<SchemaType> {
+    return Table<SchemaType>(CreateRawTable_(SchemaType::GetColumnWidths()));
+  }
+
+  /**
+  * @brief Returns the most recent tick (highest timestamp) of a symbol.
+  *
+  * The latest tick of every symbol is kept in a table maintained by the ingest
+  * path, so unlike a range query this is a single lock-free lookup. The tick
+  * is returned as soon as it is ingested and stays available regardless of
+  * the retention period or the memory budget.
+  *
+  * @param symbol_id The symbol to look up.
+  * @return The latest tick, or an empty optional if none was ingested.
+  *
+  * @note This function is thread safe.
+  */
+  auto GetLatestTick(uint32_t symbol_id) const noexcept -> std::optional<Tick>;
+
+  /**
+  * @brief Returns the most recent tick (highest timestamp) of a symbol on an exchange.
+  *
+  * @param symbol_id The symbol to look up.
+  * @param exchange_id The exchange the tick has to be traded on.
+  * @return The latest tick, or an empty optional if none was ingested.
+  *
+  * @note This function is thread safe.
+  */
+  auto GetLatestTick(uint32_t symbol_id,
+                     uint32_t exchange_id) const noexcept -> std::optional<Tick>;
+
+  /**
+  * @brief Returns the most recent quote (highest timestamp) of a symbol.
+  *
+  * Like the latest ticks, the latest quote of every symbol is kept in a table
+  * maintained by the ingest path and looked up without scanning the quotes.
+  * The quote is returned as soon as it is ingested and stays available when
+  * its buffer is evicted for the memory budget, until it is behind the
+  * retention period.
+  *
+  * @param symbol_id The symbol to look up.
+  * @return The latest quote, or an empty optional if the symbol has none retained.
+  *
+  * @note This function is thread safe.
+  */
+  auto GetLatestQuote(uint32_t symbol_id) -> std::optional<Quote>;
+
+  /**
+  * @brief Returns the most recent quote (highest timestamp) of a symbol on an exchange.
+  *
+  * @param symbol_id The symbol to look up.
+  * @param exchange_id The exchange the quote has to be published by.
+  * @return The latest quote, or an empty optional if none is retained.
+  *
+  * @note This function is thread safe.
+  */
+  auto GetLatestQuote(uint32_t symbol_id,
+                      uint32_t exchange_id) -> std::optional<Quote>;
+
   /**
   * @brief Provides the total number of data objects or rows currently present (in-memory).
   *
@@ -158,14 +772,27 @@ public:
   */
   auto Size() const noexcept -> size_t;
 
+  /**
+  * @brief Provides the number of bytes currently occupied by the stored data.
+  *
+  * This covers the sealed buffers, the active buffer and their indexing
+  * structures of the tick and the quote table, and of the tables created
+  * by 'CreateTable'.
+  *
+  * @return The memory footprint of the stored data in bytes.
+  */
+  auto MemoryUsage() const noexcept -> size_t;
+
   /**
   * @brief Makes sure that all the background threads have finished storing data
   *
   * This method will essentially will force the background threads to first
   * finish the ingestion task (if pending), then once done the thread pool is
-  * refreshed to accept in new tasks.
+  * refreshed to accept in new tasks. The rows inserted into the tables
+  * created by 'CreateTable' are published as well.
   *
-  * @note This is a blocking call, and will halt the ingestion task.
+  * @note This is a blocking call, and will halt the ingestion task until
+  *       all the pending data is stored.
   */
   auto Flush() noexcept -> void;
 
@@ -178,38 +805,182 @@ private:
   std::condition_variable data_added_to_buffer_;
 
   std::shared_ptr<RingBuffer> data_buffer_;
+  std::shared_ptr<QuoteRingBuffer> quote_buffer_;
   std::shared_ptr<ThreadPool> thread_pool_;
   std::shared_ptr<BufferManager> storage_handler_;
+  std::shared_ptr<QuoteBufferManager> quote_storage_handler_;
+  size_t parallel_query_threshold_ {};
+  Config config_;
+
+  // Registered by any thread, picked up by the insert thread which then
+  // owns them until their last handle is gone.
+  std::mutex subscriptions_mutex_;
+  std::vector<std::shared_ptr<Subscription>> pending_subscriptions_;
+  std::atomic<bool> subscriptions_pending_ {false};
+  std::vector<std::shared_ptr<Subscription>> subscriptions_;
+
+  // Kept until the thread pool is shut down, their pending tasks reference them.
+  // Their budgets are taken from the one of the ticks, guarded by the same mutex.
+  mutable std::mutex tables_mutex_;
+  std::vector<std::shared_ptr<RawTable>> tables_;
+  size_t tick_memory_budget_ {};
 
   auto StartInsertThread_() noexcept -> void;
+  auto CreateRawTable_(const std::vector<size_t> &column_widths) -> std::shared_ptr<RawTable>;
   auto InsertBase_(const std::vector<Tick> &ticks) noexcept -> void;
+  auto InsertBase_(const std::vector<Quote> &quotes) noexcept -> void;
+  auto UpdateSubscriptions_(const Tick &tick) -> void;
+
+  auto ClampToRetention_(const std::shared_ptr<const State> &state,
+                         uint64_t start_ts) const noexcept -> uint64_t;
+
+  auto ClampToRetention_(const std::shared_ptr<const QuoteState> &state,
+                         uint64_t start_ts) const noexcept -> uint64_t;
+
+  // Appends the selected rows of buffer[begin, end) to the ticks
+  using collect_func = std::function<void(const Buffer &buffer, size_t begin, size_t end,
+                                          bool is_sorted, std::vector<Tick> &ticks)>;
 
   auto GetTicksFromActiveBuffer_(
     const std::shared_ptr<const State> &state,
     uint64_t start_ts,
     uint64_t end_ts,
-    const filter_func &filter = [](const Tick &){ return true;})
-    -> std::pair<bool, std::vector<Tick>>;
+    const collect_func &collect) -> std::pair<bool, std::vector<Tick>>;
 
   auto GetTicksFromSealedBuffer_(
     const std::shared_ptr<const State> &state,
     uint64_t start_ts,
     uint64_t end_ts,
-    const filter_func &filter = [](const Tick &){ return true;})
-    -> std::pair<bool, std::vector<Tick>>;
-
-  auto CheckAndSetTick_(std::vector<Tick> &ticks,
-                        size_t index,
-                        const std::shared_ptr<Buffer> &buffer,
-                        const filter_func &filter) -> void;
+    const collect_func &collect) -> std::pair<bool, std::vector<Tick>>;
 
   auto GetSortedTicks_(
     uint64_t start_ts, uint64_t end_ts,
     const std::shared_ptr<const State> &state,
-    const filter_func &filter = [](const Tick &){ return true;}) -> std::vector<Tick>;
+    const collect_func &collect) -> std::vector<Tick>;
+
+  // Sets mask[i] to whether the row i of the slice is selected, called once
+  // per slice by the templated filter overloads.
+  using select_func = std::function<void(const TickSlice &slice, uint8_t *mask)>;
+
+  auto GetSelected_(uint64_t start_ts,
+                    uint64_t end_ts,
+                    const select_func &select) -> std::vector<Tick>;
+
+  auto AggregateSelected_(uint64_t start_ts,
+                          uint64_t end_ts,
+                          const select_func &select) -> AggregateResult;
+
+  template <typename Filter>
+  static auto SelectRows_(Filter &filter, const TickSlice &slice, uint8_t *mask) -> void;
+
+  // Call func(buffer, begin, end, is_sorted) for every contiguous run of rows
+  // of the range, defined in (and only used by) the translation unit.
+  template <typename StateType, typename Func>
+  auto ForEachSealedSlice_(const std::shared_ptr<const StateType> &state,
+                           uint64_t start_ts,
+                           uint64_t end_ts,
+                           Func &&func) const -> void;
+
+  template <typename Func>
+  auto ForEachActiveRun_(const std::shared_ptr<const State> &state,
+                         uint64_t start_ts,
+                         uint64_t end_ts,
+                         Func &&func) const -> void;
 
-  auto SetAggregateObj_(AggregateResult &result,
-                        const std::vector<Tick> &sorted_ticks) const noexcept -> void;
+  template <typename Func>
+  auto ForEachSlice_(const std::shared_ptr<const State> &state,
+                     uint64_t start_ts,
+                     uint64_t end_ts,
+                     Func &&func) const -> void;
+
+  // Splits the sealed slices of the range into groups of buffers and returns
+  // func(group) of every group, computed on the thread pool for large ranges.
+  template <typename Func>
+  auto FanOutSealed_(const std::shared_ptr<const State> &state,
+                     uint64_t start_ts,
+                     uint64_t end_ts,
+                     Func &&func) const -> auto;
+
+  // The rows of the range per buffer (of the ticks or the quotes), the ones
+  // of the active buffer sorted
+  template <typename BufferType>
+  auto GetRowSources_(const std::shared_ptr<const BasicState<BufferType>> &state,
+                      uint64_t start_ts,
+                      uint64_t end_ts) const -> std::vector<RowSource<BufferType>>;
+
+  // Merges the sources from the cursors on, calling func(buffer, row) in
+  // timestamp order until it returns false. Returns whether rows are left.
+  template <typename BufferType, typename Func>
+  static auto ForEachRowInOrder_(const std::vector<RowSource<BufferType>> &sources,
+                                 std::vector<size_t> &cursors,
+                                 bool descending,
+                                 Func &&func) -> bool;
+
+  auto GetNextPage_(ContinuationToken &&token) const -> TickPage;
+
+  auto AggregateBy_(uint64_t start_ts,
+                    uint64_t end_ts,
+                    TickColumn key_column) -> std::map<uint32_t, AggregateResult>;
+
+  auto Bars_(uint64_t start_ts,
+             uint64_t end_ts,
+             uint64_t interval,
+             std::optional<uint32_t> symbol_id) -> std::vector<Bar>;
+
+  auto CountDistinct_(uint64_t start_ts,
+                      uint64_t end_ts,
+                      TickColumn key_column,
+                      std::optional<uint32_t> exchange_id) -> size_t;
+
+  auto Rolling_(uint64_t start_ts,
+                uint64_t end_ts,
+                uint64_t window,
+                RollingMetric metrics,
+                std::optional<uint32_t> symbol_id) -> RollingSeries;
+
+  auto GetSortedQuotes_(
+    uint64_t start_ts, uint64_t end_ts,
+    const std::shared_ptr<const QuoteState> &state,
+    const quote_filter_func &filter = [](const Quote &){ return true;}) -> std::vector<Quote>;
+
+  auto SetQuoteAggregateObj_(QuoteAggregateResult &result,
+                             const std::vector<Quote> &sorted_quotes) const noexcept -> void;
+
+  // The quote unless it is behind the retention horizon of the quotes
+  auto GetRetainedQuote_(std::optional<Quote> &&quote) const noexcept -> std::optional<Quote>;
 };
 
+
+template <typename Filter>
+auto Database::SelectRows_(Filter &filter, const TickSlice &slice, uint8_t *mask) -> void {
+  // Only filters declared on a TickView read the columns in place, see TickFilter
+  if constexpr (std::is_invocable_r_v<bool, Filter &, const Tick &>) {
+    for (size_t i = 0; i < slice.Size(); i++) {
+      mask[i] = filter(slice[i].ToTick());
+    }
+  } else {
+    for (size_t i = 0; i < slice.Size(); i++) {
+      mask[i] = filter(slice[i]);
+    }
+  }
+}
+
+template <TickFilter Filter>
+auto Database::GetForRange(uint64_t start_ts,
+                           uint64_t end_ts,
+                           Filter &&filter) -> std::vector<Tick> {
+  return GetSelected_(start_ts, end_ts, [&filter](const TickSlice &slice, uint8_t *mask) {
+    SelectRows_(filter, slice, mask);
+  });
+}
+
+template <TickFilter Filter>
+auto Database::Aggregate(uint64_t start_ts,
+                         uint64_t end_ts,
+                         Filter &&filter) -> AggregateResult {
+  return AggregateSelected_(start_ts, end_ts, [&filter](const TickSlice &slice, uint8_t *mask) {
+    SelectRows_(filter, slice, mask);
+  });
+}
+
 }
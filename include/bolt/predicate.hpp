@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "macros.hpp"
+#include "trade_conditions.hpp"
+
+/**
+* @file predicate.hpp
+* @brief Defines Predicate class, a structured tick filter which the database
+*        evaluates directly over the stored columns.
+*/
+
+namespace bolt {
+
+class Tick;
+
+/**
+  * @class Predicate
+  * @brief A condition on the symbol, exchange, price, volume and trade condition
+  *        of a tick, built from simple terms combined with AND / OR.
+  *
+  * Unlike a 'Database::filter_func' the terms are known to the database, so a
+  * query evaluates them as tight loops over whole columns and skips the blocks
+  * of rows whose ranges (zone maps) can not match, without building a Tick per row.
+  *
+  * @code
+  * auto predicate = Predicate::SymbolIn({1, 2}) && Predicate::VolumeAtLeast(100);
+  * @endcode
+  */
+class Predicate {
+  TEST_FRIEND(PredicateTest);
+  friend class PredicateEvaluator;
+
+public:
+  /**
+  * @brief Constructs a predicate which matches every tick.
+  */
+  Predicate();
+
+  Predicate(const Predicate &) = default;
+  Predicate(Predicate &&) = default;
+
+  auto operator=(const Predicate &) -> Predicate & = default;
+  auto operator=(Predicate &&) noexcept -> Predicate & = default;
+
+  /**
+  * @brief Matches the ticks whose symbol is one of the provided ones.
+  *
+  * @param symbol_ids The accepted symbol ids.
+  * @return The predicate.
+  */
+  static auto SymbolIn(std::vector<uint32_t> symbol_ids) -> Predicate;
+
+  /**
+  * @brief Matches the ticks of a single symbol.
+  *
+  * @param symbol_id The accepted symbol id.
+  * @return The predicate.
+  */
+  static auto SymbolIs(uint32_t symbol_id) -> Predicate;
+
+  /**
+  * @brief Matches the ticks published by a single exchange.
+  *
+  * @param exchange_id The accepted exchange id.
+  * @return The predicate.
+  */
+  static auto ExchangeIs(uint32_t exchange_id) -> Predicate;
+
+  /**
+  * @brief Matches the ticks whose price lies within the range.
+  *
+  * @param low The lowest accepted price (inclusive).
+  * @param high The highest accepted price (inclusive).
+  * @return The predicate.
+  */
+  static auto PriceBetween(double low, double high) -> Predicate;
+
+  /**
+  * @brief Matches the ticks with at least the provided volume.
+  *
+  * @param volume The lowest accepted volume (inclusive).
+  * @return The predicate.
+  */
+  static auto VolumeAtLeast(uint32_t volume) -> Predicate;
+
+  /**
+  * @brief Matches the ticks whose trade condition is none of the provided ones.
+  *
+  * @param conditions The rejected trade conditions.
+  * @return The predicate.
+  */
+  static auto ConditionNotIn(const std::vector<TradeConditions> &conditions) -> Predicate;
+
+  /**
+  * @brief Combines two predicates, matching the ticks both of them match.
+  *
+  * @param other The other predicate.
+  * @return The combined predicate.
+  */
+  auto And(const Predicate &other) const -> Predicate;
+
+  /**
+  * @brief Combines two predicates, matching the ticks any of them matches.
+  *
+  * @param other The other predicate.
+  * @return The combined predicate.
+  */
+  auto Or(const Predicate &other) const -> Predicate;
+
+  auto operator&&(const Predicate &other) const -> Predicate;
+  auto operator||(const Predicate &other) const -> Predicate;
+
+  /**
+  * @brief Evaluates the predicate for a single tick.
+  *
+  * @param tick The tick to check.
+  * @return Whether the tick matches the predicate.
+  */
+  auto Matches(const Tick &tick) const noexcept -> bool;
+
+private:
+  enum class Kind : uint8_t {
+    kAll,
+    kSymbolIn,
+    kExchangeIn,
+    kPriceBetween,
+    kVolumeAtLeast,
+    kConditionNotIn,
+    kAnd,
+    kOr
+  };
+
+  // Immutable once built, so combined predicates share their operands
+  struct Node {
+    Kind kind {Kind::kAll};
+    std::vector<uint32_t> ids;  // sorted
+    double low {};
+    double high {};
+    uint32_t volume {};
+    uint64_t conditions {};  // a bit per rejected TradeConditions value
+    std::shared_ptr<const Node> left;
+    std::shared_ptr<const Node> right;
+  };
+
+  std::shared_ptr<const Node> node_;
+
+  explicit Predicate(Node &&node);
+
+  auto Combine_(Kind kind, const Predicate &other) const -> Predicate;
+
+  static auto Matches_(const Node &node, const Tick &tick) noexcept -> bool;
+};
+
+}
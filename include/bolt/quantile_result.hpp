@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+* @file quantile_result.hpp
+* @brief Defines QuantileResult class which holds the price and volume
+*        quantiles of a time range, returned by 'Database::Quantiles'.
+*/
+
+namespace bolt {
+
+/**
+  * @class QuantileResult
+  * @brief Holds the (approximate) price and volume of every requested quantile.
+  */
+class QuantileResult {
+public:
+  QuantileResult() = default;
+  QuantileResult(std::vector<double> quantiles,
+                 std::vector<double> prices,
+                 std::vector<double> volumes,
+                 size_t count);
+
+  /**
+  * @brief Returns the requested quantiles, e.g. {0.5, 0.95, 0.99}.
+  */
+  auto GetQuantiles() const noexcept -> const std::vector<double> &;
+
+  /**
+  * @brief Returns the trade price at every requested quantile.
+  */
+  auto GetPrices() const noexcept -> const std::vector<double> &;
+
+  /**
+  * @brief Returns the trade size (volume) at every requested quantile.
+  */
+  auto GetVolumes() const noexcept -> const std::vector<double> &;
+
+  /**
+  * @brief Returns the number of ticks the quantiles were computed over.
+  */
+  auto GetCount() const noexcept -> size_t;
+
+private:
+  std::vector<double> quantiles_;
+  std::vector<double> prices_;
+  std::vector<double> volumes_;
+  size_t count_ {};
+};
+
+}
@@ -0,0 +1,181 @@
+#pragma once
+#include "macros.hpp"
+#include "schema.hpp"
+#include <type_traits>
+#include <cstddef>
+
+/**
+* @file quote.hpp
+* @brief Defines the top of book quote record that is stored alongside the ticks.
+*/
+namespace bolt {
+
+/**
+  * @class Quote
+  * @brief Holds the best bid and ask (price and size) of a symbol on an
+  *        exchange at a given point in time.
+  */
+class Quote {
+  TEST_FRIEND(QuoteTest);
+
+public:
+  Quote() = default;
+  Quote(uint64_t timestamp,
+        double bid_price, uint32_t bid_size,
+        double ask_price, uint32_t ask_size);
+
+  Quote(uint64_t timestamp,
+        double bid_price, uint32_t bid_size,
+        double ask_price, uint32_t ask_size,
+        uint32_t symbol_id, uint32_t exchange_id);
+
+  explicit Quote(const Record<QuoteSchema> &record);
+
+  Quote(const Quote &other) = default;
+  Quote(Quote &&other) noexcept = default;
+
+  auto operator=(const Quote &other) -> Quote & = default;
+  auto operator=(Quote &&other) -> Quote & = default;
+
+  auto operator==(const Quote &other) const noexcept -> bool;
+  auto operator!=(const Quote &other) const noexcept -> bool;
+
+  /**
+  * @brief Returns the stored timestamp (when the quote was observed).
+  *
+  * @return A numeric timestamp value.
+  */
+  auto GetTimestamp() const noexcept -> uint64_t;
+
+  /**
+  * @brief Returns the best bid price.
+  *
+  * @return A numeric price value.
+  */
+  auto GetBidPrice() const noexcept -> double;
+
+  /**
+  * @brief Returns the size available at the best bid.
+  *
+  * @return A numeric size value.
+  */
+  auto GetBidSize() const noexcept -> uint32_t;
+
+  /**
+  * @brief Returns the best ask price.
+  *
+  * @return A numeric price value.
+  */
+  auto GetAskPrice() const noexcept -> double;
+
+  /**
+  * @brief Returns the size available at the best ask.
+  *
+  * @return A numeric size value.
+  */
+  auto GetAskSize() const noexcept -> uint32_t;
+
+  /**
+  * @brief Returns the symbol id the quote belongs to.
+  *
+  * @return A numeric value of symbol id.
+  */
+  auto GetSymbolId() const noexcept -> uint32_t;
+
+  /**
+  * @brief Returns the exchange id the quote was published by.
+  *
+  * @return A numeric value of exchange id.
+  */
+  auto GetExchangeId() const noexcept -> uint32_t;
+
+  /**
+  * @brief Returns the difference between the ask and the bid price.
+  *
+  * @return The quoted spread.
+  */
+  auto GetSpread() const noexcept -> double;
+
+  /**
+  * @brief Sets the timestamp of the current Quote object.
+  *
+  * @param timestamp The timestamp to store.
+  */
+  auto SetTimeStamp(uint64_t timestamp) noexcept -> void;
+
+  /**
+  * @brief Sets the best bid price and the size available at it.
+  *
+  * @param price The bid price to store.
+  * @param size The bid size to store.
+  */
+  auto SetBid(double price, uint32_t size) noexcept -> void;
+
+  /**
+  * @brief Sets the best ask price and the size available at it.
+  *
+  * @param price The ask price to store.
+  * @param size The ask size to store.
+  */
+  auto SetAsk(double price, uint32_t size) noexcept -> void;
+
+  /**
+  * @brief Sets the symbol id of the current Quote object.
+  *
+  * @param symbol_id The symbol id value to store.
+  */
+  auto SetSymbolId(uint32_t symbol_id) noexcept -> void;
+
+  /**
+  * @brief Sets the exchange id of the current Quote object.
+  *
+  * @param exchange_id The exchange id value to store.
+  */
+  auto SetExchangeId(uint32_t exchange_id) noexcept -> void;
+
+  /**
+  * @brief Converts the current object to a generic record of the Quote schema.
+  *
+  * @return A Record<QuoteSchema> holding the same values.
+  */
+  auto ToRecord() const noexcept -> Record<QuoteSchema>;
+
+  /**
+  * @brief Serializes the current object into the char * format.
+  *
+  * @param buffer A mutable char pointer (char *) in which the serialization will be stored.
+  */
+  auto Serialize(char *buffer) const -> void;
+
+  /**
+  * @brief Deserializes provided serialized Quote buffer to object.
+  *
+  * @param buffer A immutable char pointer (const char *) which holds a Quote object serialization.
+  */
+  auto Deserialize(const char *buffer) -> void;
+
+  /**
+  * @brief Returns the total minimum size occupied by the Quote object.
+  *
+  * @return The minimum size occupied by the Quote object.
+  */
+  static constexpr auto GetSerializedSize() noexcept -> size_t {
+    return QuoteSchema::kRowSize;
+  }
+
+private:
+  uint64_t timestamp_ {};
+  uint32_t symbol_id_ {};
+  uint32_t exchange_id_ {};
+  double bid_price_ {};
+  double ask_price_ {};
+  uint32_t bid_size_ {};
+  uint32_t ask_size_ {};
+
+  auto check_equality_(const Quote &quote) const noexcept -> bool;
+};
+
+static_assert(std::is_standard_layout_v<Quote> && std::is_trivially_copyable_v<Quote>,
+              "Quote must be a standard-layout and trivially copyable type for safe serialization");
+
+}
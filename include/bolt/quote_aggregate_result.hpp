@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "macros.hpp"
+
+/**
+* @file quote_aggregate_result.hpp
+* @brief Defines the result class returned by the 'Database' quote aggregate methods.
+*/
+
+namespace bolt {
+
+/**
+  * @class QuoteAggregateResult
+  * @brief Handles the data obtained from the quote aggregate queries.
+  *
+  * The time weighted spread weights the spread of every quote by the time
+  * it was in force, i.e. until the next quote of the range arrived.
+  */
+class QuoteAggregateResult {
+  TEST_FRIEND(QuoteAggregateResultTest);
+
+public:
+  QuoteAggregateResult() = default;
+  QuoteAggregateResult(size_t count,
+                       double max_spread, double min_spread,
+                       double avg_spread, double time_weighted_spread);
+
+  QuoteAggregateResult(const QuoteAggregateResult &) = default;
+  QuoteAggregateResult(QuoteAggregateResult &&) = default;
+
+  auto operator=(const QuoteAggregateResult &) -> QuoteAggregateResult & = default;
+  auto operator=(QuoteAggregateResult &&) noexcept -> QuoteAggregateResult & = default;
+
+  auto operator==(const QuoteAggregateResult &other) const noexcept -> bool;
+  auto operator!=(const QuoteAggregateResult &other) const noexcept -> bool;
+
+  /**
+  * @brief Sets the total quotes the aggregate result is computed over.
+  *
+  * @param count The count of total quotes.
+  */
+  auto SetCount(size_t count) noexcept -> void;
+
+  /**
+  * @brief Sets the maximum spread value.
+  *
+  * @param max_spread The maximum spread value to store.
+  */
+  auto SetMaxSpread(double max_spread) noexcept -> void;
+
+  /**
+  * @brief Sets the minimum spread value.
+  *
+  * @param min_spread The minimum spread value to store.
+  */
+  auto SetMinSpread(double min_spread) noexcept -> void;
+
+  /**
+  * @brief Sets the (per quote) average spread.
+  *
+  * @param avg_spread The average spread to store.
+  */
+  auto SetAvgSpread(double avg_spread) noexcept -> void;
+
+  /**
+  * @brief Sets the time weighted average spread.
+  *
+  * @param time_weighted_spread The time weighted spread to store.
+  */
+  auto SetTimeWeightedSpread(double time_weighted_spread) noexcept -> void;
+
+  /**
+  * @brief Gets the number of quotes in the aggregated range.
+  *
+  * @return The count of quotes.
+  */
+  auto GetCount() const noexcept -> size_t;
+
+  /**
+  * @brief Gets the maximum spread of the range.
+  *
+  * @return The maximum spread value.
+  */
+  auto GetMaxSpread() const noexcept -> double;
+
+  /**
+  * @brief Gets the minimum spread of the range.
+  *
+  * @return The minimum spread value.
+  */
+  auto GetMinSpread() const noexcept -> double;
+
+  /**
+  * @brief Gets the (per quote) average spread of the range.
+  *
+  * @return The average spread value.
+  */
+  auto GetAvgSpread() const noexcept -> double;
+
+  /**
+  * @brief Gets the time weighted average spread of the range.
+  *
+  * @return The time weighted spread value.
+  */
+  auto GetTimeWeightedSpread() const noexcept -> double;
+
+private:
+  size_t count_ {};
+  double max_spread_ {};
+  double min_spread_ {};
+  double avg_spread_ {};
+  double time_weighted_spread_ {};
+
+  auto EqualityCheck_(const QuoteAggregateResult &other) const noexcept -> bool;
+};
+
+}
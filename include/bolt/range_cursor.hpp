@@ -0,0 +1,263 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "macros.hpp"
+#include "trade_conditions.hpp"
+
+/**
+* @file range_cursor.hpp
+* @brief Defines the zero-copy views over the stored Tick columns, returned by
+*        'Database::GetRangeCursor'.
+*/
+
+namespace bolt {
+
+class Tick;
+class Buffer;
+class Database;
+class TickSlice;
+
+template <typename BufferType>
+class BasicState;
+
+using State = BasicState<Buffer>;
+
+/**
+  * @class TickView
+  * @brief A lightweight reference to a single stored row.
+  *
+  * The values are read straight from the columns of the slice it belongs to,
+  * so a TickView is only valid for as long as the RangeCursor it came from.
+  */
+class TickView {
+public:
+  TickView(const TickSlice &slice, size_t index) noexcept
+    : slice_(&slice), index_(index) {}
+
+  auto GetTimestamp() const noexcept -> uint64_t;
+  auto GetPrice() const noexcept -> double;
+  auto GetVolume() const noexcept -> uint32_t;
+  auto GetSymbolId() const noexcept -> uint32_t;
+  auto GetExchangeId() const noexcept -> uint32_t;
+  auto GetTradeCondition() const noexcept -> TradeConditions;
+
+  /**
+  * @brief Copies the referenced row into an owning Tick object.
+  *
+  * @return The row as a Tick.
+  */
+  auto ToTick() const -> Tick;
+
+private:
+  const TickSlice *slice_;
+  size_t index_;
+};
+
+/**
+  * @class TickSlice
+  * @brief A contiguous run of rows of a single buffer, exposed as column spans.
+  *
+  * With a fixed-point price scale the prices are stored as integer ticks, in that
+  * case 'GetPrices' is empty and 'GetPriceTicks' holds the prices instead.
+  */
+class TickSlice {
+  TEST_FRIEND(RangeCursorTest);
+  friend class Database;
+
+public:
+  class iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = TickView;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = TickView;
+
+    iterator() = default;
+    iterator(const TickSlice *slice, size_t index) noexcept
+      : slice_(slice), index_(index) {}
+
+    auto operator*() const noexcept -> TickView { return {*slice_, index_}; }
+    auto operator++() noexcept -> iterator & { index_++; return *this; }
+    auto operator++(int) noexcept -> iterator { auto it = *this; index_++; return it; }
+    auto operator==(const iterator &other) const noexcept -> bool = default;
+
+  private:
+    const TickSlice *slice_ {};
+    size_t index_ {};
+  };
+
+  TickSlice() = default;
+
+  auto Size() const noexcept -> size_t { return timestamps_.size(); }
+  auto Empty() const noexcept -> bool { return timestamps_.empty(); }
+
+  /**
+  * @brief Whether the rows of the slice are in ascending timestamp order.
+  */
+  auto IsSorted() const noexcept -> bool { return is_sorted_; }
+
+  /**
+  * @brief Whether the prices are stored as fixed-point ticks ('GetPriceTicks').
+  */
+  auto IsFixedPoint() const noexcept -> bool { return is_fixed_point_; }
+
+  auto GetTimestamps() const noexcept -> std::span<const uint64_t> { return timestamps_; }
+  auto GetSymbolIds() const noexcept -> std::span<const uint32_t> { return symbol_ids_; }
+  auto GetExchangeIds() const noexcept -> std::span<const uint32_t> { return exchange_ids_; }
+  auto GetPrices() const noexcept -> std::span<const double> { return prices_; }
+  auto GetPriceTicks() const noexcept -> std::span<const int64_t> { return price_ticks_; }
+  auto GetVolumes() const noexcept -> std::span<const uint32_t> { return volumes_; }
+
+  auto GetTradeConditions() const noexcept -> std::span<const TradeConditions> {
+    return trade_conditions_;
+  }
+
+  /**
+  * @brief Returns the price of a row, converted back from ticks if stored as fixed-point.
+  *
+  * @param index The row within the slice.
+  * @return The price of the row.
+  */
+  auto GetPrice(size_t index) const noexcept -> double {
+    if (is_fixed_point_) return double(price_ticks_[index]) / ticks_per_unit_;
+    return prices_[index];
+  }
+
+  auto operator[](size_t index) const noexcept -> TickView { return {*this, index}; }
+
+  auto begin() const noexcept -> iterator { return {this, 0}; }
+  auto end() const noexcept -> iterator { return {this, Size()}; }
+
+private:
+  std::span<const uint64_t> timestamps_;
+  std::span<const uint32_t> symbol_ids_;
+  std::span<const uint32_t> exchange_ids_;
+  std::span<const double> prices_;
+  std::span<const int64_t> price_ticks_;
+  std::span<const uint32_t> volumes_;
+  std::span<const TradeConditions> trade_conditions_;
+
+  double ticks_per_unit_ {1.0};
+  bool is_fixed_point_ {};
+  bool is_sorted_ {true};
+
+  TickSlice(const Buffer &buffer, size_t begin, size_t end, bool is_sorted);
+};
+
+/**
+  * @class RangeCursor
+  * @brief Iterates the rows of a time range without copying them.
+  *
+  * The cursor keeps the snapshot (State) it was created from alive, so the
+  * referenced columns stay valid and unchanged for the cursor's lifetime,
+  * regardless of the inserts, sealing or eviction happening meanwhile.
+  *
+  * The rows are grouped by the buffer they are stored in, every slice of a
+  * sealed buffer is sorted but the slices themselves are not ordered relative
+  * to each other (see 'IsSorted'). Use 'Database::GetForRange' when a single
+  * sorted list of Tick objects is required.
+  */
+class RangeCursor {
+  TEST_FRIEND(RangeCursorTest);
+  friend class Database;
+
+public:
+  class iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = TickView;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = TickView;
+
+    iterator() = default;
+    iterator(const std::vector<TickSlice> *slices, size_t slice, size_t index) noexcept
+      : slices_(slices), slice_(slice), index_(index) {}
+
+    auto operator*() const noexcept -> TickView {
+      return {(*slices_)[slice_], index_};
+    }
+
+    auto operator++() noexcept -> iterator & {
+      if (++index_ >= (*slices_)[slice_].Size()) {
+        slice_++;
+        index_ = 0;
+      }
+      return *this;
+    }
+
+    auto operator++(int) noexcept -> iterator { auto it = *this; ++(*this); return it; }
+    auto operator==(const iterator &other) const noexcept -> bool = default;
+
+  private:
+    const std::vector<TickSlice> *slices_ {};
+    size_t slice_ {};
+    size_t index_ {};
+  };
+
+  RangeCursor() = default;
+
+  /**
+  * @brief Returns the (non-empty) slices the range consists of.
+  *
+  * @return The slices in storage order, sealed buffers first.
+  */
+  auto GetSlices() const noexcept -> const std::vector<TickSlice> &;
+
+  /**
+  * @brief Returns the number of rows in the range.
+  */
+  auto Size() const noexcept -> size_t;
+
+  auto Empty() const noexcept -> bool;
+
+  /**
+  * @brief Whether iterating the cursor yields the rows in ascending timestamp order.
+  */
+  auto IsSorted() const noexcept -> bool;
+
+  auto begin() const noexcept -> iterator { return {&slices_, 0, 0}; }
+  auto end() const noexcept -> iterator { return {&slices_, slices_.size(), 0}; }
+
+private:
+  std::shared_ptr<const State> state_;
+  std::vector<TickSlice> slices_;
+  size_t size_ {};
+  bool is_sorted_ {true};
+
+  RangeCursor(std::shared_ptr<const State> state, std::vector<TickSlice> &&slices);
+};
+
+// Row accessors are used once per row, hence defined inline.
+inline auto TickView::GetTimestamp() const noexcept -> uint64_t {
+  return slice_->GetTimestamps()[index_];
+}
+
+inline auto TickView::GetPrice() const noexcept -> double {
+  return slice_->GetPrice(index_);
+}
+
+inline auto TickView::GetVolume() const noexcept -> uint32_t {
+  return slice_->GetVolumes()[index_];
+}
+
+inline auto TickView::GetSymbolId() const noexcept -> uint32_t {
+  return slice_->GetSymbolIds()[index_];
+}
+
+inline auto TickView::GetExchangeId() const noexcept -> uint32_t {
+  return slice_->GetExchangeIds()[index_];
+}
+
+inline auto TickView::GetTradeCondition() const noexcept -> TradeConditions {
+  return slice_->GetTradeConditions()[index_];
+}
+
+}
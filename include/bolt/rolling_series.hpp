@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "macros.hpp"
+
+/**
+* @file rolling_series.hpp
+* @brief Defines the rolling window metrics and the series returned by 'Database::Rolling'.
+*/
+
+namespace bolt {
+
+class Database;
+class SlidingWindow;
+
+/**
+  * @brief The metrics that can be requested from 'Database::Rolling',
+  *        combined with the '|' operator.
+  */
+enum class RollingMetric : uint8_t {
+  kNone = 0,
+  kSma = 1 << 0,
+  kEma = 1 << 1,
+  kVwap = 1 << 2,
+  kStdDev = 1 << 3,
+  kMinPrice = 1 << 4,
+  kMaxPrice = 1 << 5,
+  kVolume = 1 << 6,
+  kAll = (1 << 7) - 1
+};
+
+constexpr auto operator|(RollingMetric a, RollingMetric b) noexcept -> RollingMetric {
+  return RollingMetric(uint8_t(a) | uint8_t(b));
+}
+
+constexpr auto operator&(RollingMetric a, RollingMetric b) noexcept -> RollingMetric {
+  return RollingMetric(uint8_t(a) & uint8_t(b));
+}
+
+/**
+  * @class RollingSeries
+  * @brief Holds the rolling window metrics of a time range, one point per tick.
+  *
+  * The point of a tick covers the ticks of the window ending at its timestamp,
+  * i.e. [timestamp - window, timestamp], up to and including the tick itself.
+  * Only the requested metrics are filled, the others are left empty.
+  */
+class RollingSeries {
+  TEST_FRIEND(RollingSeriesTest);
+  friend class Database;
+
+public:
+  RollingSeries() = default;
+  explicit RollingSeries(RollingMetric metrics);
+
+  /**
+  * @brief Returns the number of points held.
+  */
+  auto Size() const noexcept -> size_t;
+
+  /**
+  * @brief Returns the metrics this object was requested with.
+  */
+  auto GetMetrics() const noexcept -> RollingMetric;
+
+  /**
+  * @brief Returns the timestamp of every point, always filled.
+  */
+  auto GetTimestamps() const noexcept -> const std::vector<uint64_t> &;
+
+  /**
+  * @brief Returns the simple moving average of the prices.
+  */
+  auto GetSma() const noexcept -> const std::vector<double> &;
+
+  /**
+  * @brief Returns the exponential moving average of the prices.
+  *
+  * The average is decayed by the time elapsed between two ticks, every tick
+  * weighs 1 - exp(-elapsed / window), so the window is its time constant.
+  */
+  auto GetEma() const noexcept -> const std::vector<double> &;
+
+  auto GetVwap() const noexcept -> const std::vector<double> &;
+
+  /**
+  * @brief Returns the (population) standard deviation of the prices.
+  */
+  auto GetStdDev() const noexcept -> const std::vector<double> &;
+
+  auto GetMinPrices() const noexcept -> const std::vector<double> &;
+  auto GetMaxPrices() const noexcept -> const std::vector<double> &;
+
+  /**
+  * @brief Returns the total volume traded within the window.
+  */
+  auto GetVolumes() const noexcept -> const std::vector<uint64_t> &;
+
+private:
+  RollingMetric metrics_ {RollingMetric::kNone};
+
+  std::vector<uint64_t> timestamps_;
+  std::vector<double> sma_;
+  std::vector<double> ema_;
+  std::vector<double> vwap_;
+  std::vector<double> std_dev_;
+  std::vector<double> min_prices_;
+  std::vector<double> max_prices_;
+  std::vector<uint64_t> volumes_;
+
+  auto Has_(RollingMetric metric) const noexcept -> bool;
+  auto Append_(uint64_t timestamp, const SlidingWindow &window, double ema) -> void;
+};
+
+}
@@ -0,0 +1,240 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "trade_conditions.hpp"
+
+/**
+* @file schema.hpp
+* @brief Defines the compile-time column lists (schemas) the stored records are described with.
+*
+* A schema is a list of columns, each column is a tag type paired with its
+* value type, e.g.
+*
+*   using MySchema = Schema<
+*     Column<columns::Timestamp, uint64_t>,
+*     Column<columns::ExchangeId, uint16_t>,
+*     Column<columns::SequenceNumber, uint64_t>
+*   >;
+*
+* The storage, serialization and sorting of the records are then generated
+* for exactly those columns. The first column is always the timestamp.
+*/
+
+namespace bolt {
+
+/**
+  * @brief The tags naming the columns of a schema.
+  *
+  * Any (empty) type can be used as a tag, the ones below are the
+  * commonly used ones and describe the Tick and Quote schemas.
+  */
+namespace columns {
+  struct Timestamp {};
+  struct SymbolId {};
+  struct ExchangeId {};
+  struct Price {};
+  struct Volume {};
+  struct TradeCondition {};
+  struct SequenceNumber {};
+  struct AggressorSide {};
+  struct BidPrice {};
+  struct BidSize {};
+  struct AskPrice {};
+  struct AskSize {};
+}
+
+/**
+  * @struct Column
+  * @brief Pairs a column tag with the type of the values stored in it.
+  */
+template <typename Tag, typename T>
+struct Column {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "Column values must be trivially copyable to be serialized");
+
+  using tag = Tag;
+  using type = T;
+};
+
+/**
+  * @class Schema
+  * @brief A compile-time list of columns.
+  *
+  * Provides the row and storage types generated from the columns, the
+  * serialized size of a row and the (de)serialization of a row.
+  */
+template <typename ...Columns>
+class Schema {
+  static_assert(sizeof...(Columns) > 0, "A schema needs at least one column");
+
+public:
+  using row_type = std::tuple<typename Columns::type...>;
+  using storage_type = std::tuple<std::vector<typename Columns::type>...>;
+  using timestamp_column = std::tuple_element_t<0, std::tuple<Columns...>>;
+
+  static_assert(std::is_same_v<typename timestamp_column::tag, columns::Timestamp> &&
+                std::is_same_v<typename timestamp_column::type, uint64_t>,
+                "The first column of a schema must be a uint64_t timestamp");
+
+  static constexpr size_t kColumnCount = sizeof...(Columns);
+
+  /**
+  * @brief The number of bytes a serialized row occupies (no padding).
+  */
+  static constexpr size_t kRowSize = (sizeof(typename Columns::type) + ...);
+
+  /**
+  * @brief The number of bytes each column occupies in a serialized row.
+  */
+  static auto GetColumnWidths() -> std::vector<size_t> {
+    return {sizeof(typename Columns::type)...};
+  }
+
+  /**
+  * @brief The position of the column named by the tag.
+  */
+  template <typename Tag>
+  static constexpr size_t IndexOf = [] {
+    constexpr bool matches[] = {std::is_same_v<Tag, typename Columns::tag>...};
+    size_t index = 0;
+    while (index < sizeof...(Columns) && !matches[index]) index++;
+    return index;
+  }();
+
+  /**
+  * @brief Whether the schema has a column named by the tag.
+  */
+  template <typename Tag>
+  static constexpr bool kHasColumn = IndexOf<Tag> < sizeof...(Columns);
+
+  /**
+  * @brief The value type of the column named by the tag.
+  */
+  template <typename Tag>
+  using type_of = std::tuple_element_t<IndexOf<Tag>, row_type>;
+
+  /**
+  * @brief Serializes a row, column after column, into the provided buffer.
+  *
+  * @param row The row to serialize.
+  * @param buffer A buffer of at least kRowSize bytes.
+  */
+  static auto Serialize(const row_type &row, char *buffer) noexcept -> void {
+    std::apply([&buffer](const auto &...values) {
+      ((std::memcpy(buffer, &values, sizeof(values)), buffer += sizeof(values)), ...);
+    }, row);
+  }
+
+  /**
+  * @brief Deserializes a row written by Serialize.
+  *
+  * @param buffer A buffer holding a serialized row.
+  * @return The deserialized row.
+  */
+  static auto Deserialize(const char *buffer) noexcept -> row_type {
+    auto row = row_type{};
+    std::apply([&buffer](auto &...values) {
+      ((std::memcpy(&values, buffer, sizeof(values)), buffer += sizeof(values)), ...);
+    }, row);
+    return row;
+  }
+};
+
+/**
+  * @brief The schema of the Tick objects stored by the Database.
+  */
+using TickSchema = Schema<
+  Column<columns::Timestamp, uint64_t>,
+  Column<columns::SymbolId, uint32_t>,
+  Column<columns::ExchangeId, uint32_t>,
+  Column<columns::Price, double>,
+  Column<columns::Volume, uint32_t>,
+  Column<columns::TradeCondition, TradeConditions>
+>;
+
+/**
+  * @brief The schema of the (top of book) Quote objects stored by the Database.
+  */
+using QuoteSchema = Schema<
+  Column<columns::Timestamp, uint64_t>,
+  Column<columns::SymbolId, uint32_t>,
+  Column<columns::ExchangeId, uint32_t>,
+  Column<columns::BidPrice, double>,
+  Column<columns::BidSize, uint32_t>,
+  Column<columns::AskPrice, double>,
+  Column<columns::AskSize, uint32_t>
+>;
+
+/**
+  * @class Record
+  * @brief A single row of a schema, with its columns accessed by their tags.
+  */
+template <typename SchemaType>
+class Record {
+public:
+  using schema = SchemaType;
+  using row_type = typename SchemaType::row_type;
+
+  Record() = default;
+  explicit Record(const row_type &row) : row_(row) {}
+
+  template <typename ...Values,
+            typename = std::enable_if_t<sizeof...(Values) == SchemaType::kColumnCount>>
+  Record(Values &&...values) : row_(std::forward<Values>(values)...) {}
+
+  auto operator==(const Record &other) const noexcept -> bool {
+    return row_ == other.row_;
+  }
+
+  auto operator!=(const Record &other) const noexcept -> bool {
+    return row_ != other.row_;
+  }
+
+  /**
+  * @brief Returns the value of the column named by the tag.
+  */
+  template <typename Tag>
+  auto Get() const noexcept -> const typename SchemaType::template type_of<Tag> & {
+    return std::get<SchemaType::template IndexOf<Tag>>(row_);
+  }
+
+  /**
+  * @brief Sets the value of the column named by the tag.
+  */
+  template <typename Tag>
+  auto Set(const typename SchemaType::template type_of<Tag> &value) noexcept -> void {
+    std::get<SchemaType::template IndexOf<Tag>>(row_) = value;
+  }
+
+  auto GetTimestamp() const noexcept -> uint64_t {
+    return std::get<0>(row_);
+  }
+
+  auto GetRow() const noexcept -> const row_type & {
+    return row_;
+  }
+
+  auto Serialize(char *buffer) const noexcept -> void {
+    SchemaType::Serialize(row_, buffer);
+  }
+
+  auto Deserialize(const char *buffer) noexcept -> void {
+    row_ = SchemaType::Deserialize(buffer);
+  }
+
+  static constexpr auto GetSerializedSize() noexcept -> size_t {
+    return SchemaType::kRowSize;
+  }
+
+private:
+  row_type row_ {};
+};
+
+}
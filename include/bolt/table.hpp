@@ -0,0 +1,199 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "macros.hpp"
+#include "config.hpp"
+#include "schema.hpp"
+
+/**
+* @file table.hpp
+* @brief Defines the Table class, storing the records of a user defined Schema.
+*/
+
+namespace bolt {
+
+class Database;
+class ThreadPool;
+class RawBuffer;
+class RawRecord;
+
+template <typename BufferType, typename RecordType>
+class BasicBufferManager;
+
+using RawBufferManager = BasicBufferManager<RawBuffer, RawRecord>;
+
+/**
+  * @class RawTable
+  * @brief The untyped storage behind a Table, rows are handed over serialized
+  *        (see Schema::Serialize) and stored as one column per schema column.
+  *
+  * Use the typed Table instead, it is created by 'Database::CreateTable'.
+  */
+class RawTable {
+  TEST_FRIEND(TableTest);
+  friend class Database;
+
+public:
+  RawTable(const RawTable &other) = delete;
+  auto operator=(const RawTable &other) -> RawTable & = delete;
+
+  ~RawTable();
+
+  /**
+  * @brief Appends 'count' serialized rows, stored back to back in 'rows'.
+  *
+  * @note This function is thread safe.
+  */
+  auto Insert(const char *rows, size_t count) noexcept -> void;
+
+  /**
+  * @brief Returns the serialized rows of the time range (inclusive), sorted by their timestamps.
+  *
+  * @note This function is thread safe.
+  */
+  auto GetRowsForRange(uint64_t start_ts, uint64_t end_ts) const -> std::vector<char>;
+
+  /**
+  * @brief Returns the packed values of one column over the time range (inclusive),
+  *        sorted by the timestamps of their rows.
+  *
+  * @note This function is thread safe.
+  */
+  auto GetColumnForRange(size_t column, uint64_t start_ts,
+                         uint64_t end_ts) const -> std::vector<char>;
+
+  /**
+  * @brief Returns the memory held by the stored rows, in bytes.
+  */
+  auto MemoryUsage() const noexcept -> size_t;
+
+private:
+  RawTable(const std::shared_ptr<ThreadPool> &pool,
+           const Config &config,
+           const std::vector<size_t> &column_widths);
+
+  std::shared_ptr<ThreadPool> pool_;
+  std::unique_ptr<RawBufferManager> storage_handler_;
+  std::vector<size_t> column_widths_;
+
+  // The buffer manager takes its rows from a single writer at a time
+  std::mutex insert_mutex_;
+
+  // Calls 'func(buffer, row)' for the rows of the range in timestamp order
+  template <typename Func>
+  auto ForEachRowInOrder_(uint64_t start_ts, uint64_t end_ts, Func &&func) const -> void;
+};
+
+/**
+  * @class Table
+  * @brief Stores the records of a user defined Schema, e.g.
+  *
+  *   using FeedSchema = Schema<
+  *     Column<columns::Timestamp, uint64_t>,
+  *     Column<columns::ExchangeId, uint16_t>,
+  *     Column<columns::SequenceNumber, uint64_t>
+  *   >;
+  *
+  *   auto feed = db.CreateTable<FeedSchema>();
+  *   feed.Insert(Record<FeedSchema>(1001, uint16_t(2), uint64_t(7)));
+  *   auto sequences = feed.GetColumnForRange<columns::SequenceNumber>(1000, 2000);
+  *
+  * Every column is stored in its own vector of exactly its width, the rows are
+  * sealed, expired and evicted like the ticks and quotes of the Database.
+  *
+  * A Table is a cheap handle, copies share the same rows. It is only usable
+  * while the Database that created it is alive.
+  */
+template <typename SchemaType>
+class Table {
+  TEST_FRIEND(TableTest);
+  friend class Database;
+
+public:
+  using schema = SchemaType;
+  using record = Record<SchemaType>;
+
+  template <typename Tag>
+  using type_of = typename SchemaType::template type_of<Tag>;
+
+  /**
+  * @brief Inserts a record into the table.
+  *
+  * @note This function is thread safe.
+  */
+  auto Insert(const record &record) noexcept -> void {
+    char row[SchemaType::kRowSize];
+    record.Serialize(row);
+    raw_table_->Insert(row, 1);
+  }
+
+  /**
+  * @brief Inserts the records into the table.
+  *
+  * @note This function is thread safe.
+  */
+  auto Insert(const std::vector<record> &records) noexcept -> void {
+    auto rows = std::vector<char>(records.size() * SchemaType::kRowSize);
+    for (size_t i = 0; i < records.size(); i++) {
+      records[i].Serialize(rows.data() + i * SchemaType::kRowSize);
+    }
+    raw_table_->Insert(rows.data(), records.size());
+  }
+
+  /**
+  * @brief Fetches all the records for the provided time range (inclusive).
+  *
+  * @return A vector of records sorted by their timestamps.
+  *
+  * @note This function is thread safe.
+  */
+  auto GetForRange(uint64_t start_ts, uint64_t end_ts) const -> std::vector<record> {
+    auto rows = raw_table_->GetRowsForRange(start_ts, end_ts);
+
+    auto records = std::vector<record>(rows.size() / SchemaType::kRowSize);
+    for (size_t i = 0; i < records.size(); i++) {
+      records[i].Deserialize(rows.data() + i * SchemaType::kRowSize);
+    }
+    return records;
+  }
+
+  /**
+  * @brief Fetches the values of the column named by the tag for the provided
+  *        time range (inclusive), without materializing the records.
+  *
+  * @return The values sorted by the timestamps of their records.
+  *
+  * @note This function is thread safe.
+  */
+  template <typename Tag>
+  auto GetColumnForRange(uint64_t start_ts, uint64_t end_ts) const
+    -> std::vector<type_of<Tag>> {
+    static_assert(SchemaType::template kHasColumn<Tag>, "The schema has no such column");
+
+    auto bytes = raw_table_->GetColumnForRange(SchemaType::template IndexOf<Tag>,
+                                               start_ts, end_ts);
+    auto values = std::vector<type_of<Tag>>(bytes.size() / sizeof(type_of<Tag>));
+    if (!values.empty()) std::memcpy(values.data(), bytes.data(), bytes.size());
+    return values;
+  }
+
+  /**
+  * @brief Returns the memory held by the stored records, in bytes.
+  */
+  auto MemoryUsage() const noexcept -> size_t {
+    return raw_table_->MemoryUsage();
+  }
+
+private:
+  std::shared_ptr<RawTable> raw_table_;
+
+  explicit Table(std::shared_ptr<RawTable> raw_table) : raw_table_(std::move(raw_table)) {}
+};
+
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include "macros.hpp"
 #include "trade_conditions.hpp"
+#include "schema.hpp"
 #include <type_traits>
 #include <cstddef>
 
@@ -28,6 +29,8 @@ public:
   Tick(uint64_t timestamp, double price, uint32_t volume,
        uint32_t symbol_id, uint32_t exchange_id, TradeConditions trace_condition);
 
+  explicit Tick(const Record<TickSchema> &record);
+
   Tick(const Tick &other) = default;
   Tick(Tick &&other) noexcept = default;
 
@@ -122,6 +125,13 @@ public:
   */
   auto SetTradeCondition(const TradeConditions &trade_condition) noexcept -> void;
 
+  /**
+  * @brief Converts the current object to a generic record of the Tick schema.
+  *
+  * @return A Record<TickSchema> holding the same values.
+  */
+  auto ToRecord() const noexcept -> Record<TickSchema>;
+
   /**
   * @brief Serializes the current object into the char * format.
   *
@@ -144,10 +154,7 @@ public:
   * @return The minimum size occupied by the Tick object.
   */
   static constexpr auto GetSerializedSize() noexcept -> size_t {
-    return sizeof(uint64_t)
-    + (sizeof(uint32_t) * 3)
-    + sizeof(double)
-    + sizeof(TradeConditions);
+    return TickSchema::kRowSize;
   }
 
 private:
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "macros.hpp"
+#include "trade_conditions.hpp"
+
+/**
+* @file tick_columns.hpp
+* @brief Defines the columnar (one array per field) result of 'Database::GetColumnsForRange'.
+*/
+
+namespace bolt {
+
+class Database;
+class TickSlice;
+
+/**
+  * @brief The Tick fields that can be requested from 'Database::GetColumnsForRange',
+  *        combined with the '|' operator.
+  */
+enum class TickColumn : uint8_t {
+  kNone = 0,
+  kTimestamp = 1 << 0,
+  kSymbolId = 1 << 1,
+  kExchangeId = 1 << 2,
+  kPrice = 1 << 3,
+  kVolume = 1 << 4,
+  kTradeCondition = 1 << 5,
+  kAll = (1 << 6) - 1
+};
+
+constexpr auto operator|(TickColumn a, TickColumn b) noexcept -> TickColumn {
+  return TickColumn(uint8_t(a) | uint8_t(b));
+}
+
+constexpr auto operator&(TickColumn a, TickColumn b) noexcept -> TickColumn {
+  return TickColumn(uint8_t(a) & uint8_t(b));
+}
+
+/**
+  * @class TickColumns
+  * @brief Holds the rows of a time range as contiguous per-field arrays, sorted by timestamp.
+  *
+  * Only the requested columns are filled, the others are left empty. The
+  * prices are always returned as doubles, also when stored as fixed-point.
+  */
+class TickColumns {
+  TEST_FRIEND(TickColumnsTest);
+  friend class Database;
+
+public:
+  TickColumns() = default;
+  explicit TickColumns(TickColumn columns);
+
+  /**
+  * @brief Returns the number of rows held.
+  */
+  auto Size() const noexcept -> size_t;
+
+  /**
+  * @brief Returns the columns this object was requested with.
+  */
+  auto GetColumns() const noexcept -> TickColumn;
+
+  auto GetTimestamps() const noexcept -> const std::vector<uint64_t> &;
+  auto GetSymbolIds() const noexcept -> const std::vector<uint32_t> &;
+  auto GetExchangeIds() const noexcept -> const std::vector<uint32_t> &;
+  auto GetPrices() const noexcept -> const std::vector<double> &;
+  auto GetVolumes() const noexcept -> const std::vector<uint32_t> &;
+  auto GetTradeConditions() const noexcept -> const std::vector<TradeConditions> &;
+
+private:
+  TickColumn columns_ {TickColumn::kNone};
+  size_t size_ {};
+
+  std::vector<uint64_t> timestamps_;
+  std::vector<uint32_t> symbol_ids_;
+  std::vector<uint32_t> exchange_ids_;
+  std::vector<double> prices_;
+  std::vector<uint32_t> volumes_;
+  std::vector<TradeConditions> trade_conditions_;
+
+  auto Has_(TickColumn column) const noexcept -> bool;
+  auto Reserve_(size_t size) -> void;
+  auto AppendSlice_(const TickSlice &slice) -> void;
+  auto SortByTimestamp_(const std::vector<uint64_t> &timestamps) -> void;
+};
+
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "macros.hpp"
+#include "tick.hpp"
+
+/**
+* @file tick_page.hpp
+* @brief Defines the TickPage and ContinuationToken classes, returned by the
+*        paginated 'Database::GetPage' queries.
+*/
+
+namespace bolt {
+
+class Buffer;
+class Database;
+
+// The rows [low, high) of a buffer within a range, merged in timestamp order
+// by the paginated and the as-of queries. The rows of an active buffer are not
+// sorted, 'order' then holds their indices in timestamp order and the positions
+// index into it, it is empty for the (sorted) sealed buffers.
+template <typename BufferType>
+struct RowSource {
+  const BufferType *buffer;
+  std::vector<uint32_t> order;
+  size_t low;
+  size_t high;
+};
+
+/**
+  * @class ContinuationToken
+  * @brief An opaque position within a paginated range query.
+  *
+  * The token keeps the buffers of the range the first page was read from
+  * alive, along with the position reached in every one of them, so the next
+  * page resumes exactly where the previous one stopped without scanning the
+  * rows already returned. Inserts made after the first page are therefore not
+  * visible through it, and no row is skipped or repeated across the pages.
+  *
+  * @warning The buffers a token references stay in memory for as long as the
+  *          token (or a copy of it) lives, even once they are expired by the
+  *          retention period or evicted to honour the memory budget. Drop the
+  *          tokens of abandoned scans instead of keeping them around.
+  *
+  * A default constructed token is exhausted, passing it to 'Database::GetPage'
+  * yields an empty page.
+  */
+class ContinuationToken {
+  TEST_FRIEND(TickPageTest);
+  friend class Database;
+
+public:
+  ContinuationToken() = default;
+
+  /**
+  * @brief Whether there are rows left to fetch from this position.
+  */
+  auto HasMore() const noexcept -> bool;
+
+private:
+  using Source = RowSource<Buffer>;
+
+  // Only the buffers of the range are pinned, not the whole snapshot
+  std::vector<std::shared_ptr<const Buffer>> buffers_;
+  std::shared_ptr<const std::vector<Source>> sources_;
+
+  // The next position of every source, counting down when descending
+  std::vector<size_t> cursors_;
+
+  size_t limit_ {};
+  bool is_descending_ {};
+};
+
+/**
+  * @class TickPage
+  * @brief Holds at most 'limit' ticks of a range and the token to the next page.
+  */
+class TickPage {
+  TEST_FRIEND(TickPageTest);
+  friend class Database;
+
+public:
+  TickPage() = default;
+
+  /**
+  * @brief Returns the ticks of the page, in ascending timestamp order
+  *        (descending for a descending query).
+  */
+  auto GetTicks() const noexcept -> const std::vector<Tick> &;
+
+  /**
+  * @brief Whether the range holds rows past this page.
+  */
+  auto HasMore() const noexcept -> bool;
+
+  /**
+  * @brief Returns the token to pass to 'Database::GetPage' for the next page.
+  */
+  auto GetContinuationToken() const noexcept -> const ContinuationToken &;
+
+private:
+  std::vector<Tick> ticks_;
+  ContinuationToken token_;
+};
+
+}
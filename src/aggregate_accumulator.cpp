@@ -0,0 +1,193 @@
+#include "headers/aggregate_accumulator.hpp"
+#include "../include/bolt/aggregate_result.hpp"
+
+#include <algorithm>
+
+namespace bolt {
+
+AggregateAccumulator::AggregateAccumulator(const PriceScale &price_scale)
+  : price_scale_(price_scale) {}
+
+auto AggregateAccumulator::Add(double price, uint32_t volume) noexcept -> void {
+  if (price_scale_.IsFixedPoint()) {
+    AddFixed(price_scale_.ToTicks(price), volume);
+    return;
+  }
+
+  if (count_ == 0) {
+    min_price_ = price;
+    max_price_ = price;
+  } else {
+    min_price_ = std::min(min_price_, price);
+    max_price_ = std::max(max_price_, price);
+  }
+
+  price_sum_ += price;
+  weighted_price_sum_ += price * volume;
+  total_volume_ += volume;
+  count_++;
+}
+
+auto AggregateAccumulator::AddFixed(int64_t price_ticks, uint32_t volume) noexcept -> void {
+  if (count_ == 0) {
+    min_price_ticks_ = price_ticks;
+    max_price_ticks_ = price_ticks;
+  } else {
+    min_price_ticks_ = std::min(min_price_ticks_, price_ticks);
+    max_price_ticks_ = std::max(max_price_ticks_, price_ticks);
+  }
+
+  price_ticks_sum_ += price_ticks;
+  weighted_price_ticks_sum_ += wide_int(price_ticks) * volume;
+  total_volume_ += volume;
+  count_++;
+}
+
+auto AggregateAccumulator::Remove(double price, uint32_t volume) noexcept -> void {
+  if (count_ <= 1) {
+    // Starts over from zero, without the rounding errors of the double sums
+    *this = AggregateAccumulator(price_scale_);
+    return;
+  }
+
+  if (price_scale_.IsFixedPoint()) {
+    auto price_ticks = price_scale_.ToTicks(price);
+    price_ticks_sum_ -= price_ticks;
+    weighted_price_ticks_sum_ -= wide_int(price_ticks) * volume;
+  } else {
+    price_sum_ -= price;
+    weighted_price_sum_ -= price * volume;
+  }
+  total_volume_ -= volume;
+  count_--;
+}
+
+auto AggregateAccumulator::Add(std::span<const double> prices,
+                               std::span<const uint32_t> volumes) noexcept -> void {
+  if (prices.empty()) return;
+
+  if (price_scale_.IsFixedPoint()) {
+    for (size_t i = 0; i < prices.size(); i++) {
+      AddFixed(price_scale_.ToTicks(prices[i]), volumes[i]);
+    }
+    return;
+  }
+
+  AddSums_(kernels::SumColumns(prices, volumes));
+}
+
+auto AggregateAccumulator::AddInRange(std::span<const uint64_t> timestamps,
+                                      std::span<const double> prices,
+                                      std::span<const uint32_t> volumes,
+                                      uint64_t start_ts,
+                                      uint64_t end_ts) noexcept -> void {
+  if (price_scale_.IsFixedPoint()) {
+    for (size_t i = 0; i < timestamps.size(); i++) {
+      if (timestamps[i] >= start_ts && timestamps[i] <= end_ts) {
+        AddFixed(price_scale_.ToTicks(prices[i]), volumes[i]);
+      }
+    }
+    return;
+  }
+
+  AddSums_(kernels::SumColumnsInRange(timestamps, prices, volumes, start_ts, end_ts));
+}
+
+auto AggregateAccumulator::AddFixed(std::span<const int64_t> price_ticks,
+                                    std::span<const uint32_t> volumes) noexcept -> void {
+  if (price_ticks.empty()) return;
+
+  auto min_price_ticks = count_ == 0 ? price_ticks[0] : min_price_ticks_;
+  auto max_price_ticks = count_ == 0 ? price_ticks[0] : max_price_ticks_;
+  auto price_ticks_sum = wide_int{}, weighted_price_ticks_sum = wide_int{};
+  uint64_t total_volume = 0;
+
+  for (size_t i = 0; i < price_ticks.size(); i++) {
+    min_price_ticks = std::min(min_price_ticks, price_ticks[i]);
+    max_price_ticks = std::max(max_price_ticks, price_ticks[i]);
+    price_ticks_sum += price_ticks[i];
+    weighted_price_ticks_sum += wide_int(price_ticks[i]) * volumes[i];
+    total_volume += volumes[i];
+  }
+
+  min_price_ticks_ = min_price_ticks;
+  max_price_ticks_ = max_price_ticks;
+  price_ticks_sum_ += price_ticks_sum;
+  weighted_price_ticks_sum_ += weighted_price_ticks_sum;
+  total_volume_ += total_volume;
+  count_ += price_ticks.size();
+}
+
+auto AggregateAccumulator::Merge(const AggregateAccumulator &other) noexcept -> void {
+  if (other.count_ == 0) return;
+
+  if (count_ == 0) {
+    min_price_ = other.min_price_;
+    max_price_ = other.max_price_;
+    min_price_ticks_ = other.min_price_ticks_;
+    max_price_ticks_ = other.max_price_ticks_;
+  } else {
+    min_price_ = std::min(min_price_, other.min_price_);
+    max_price_ = std::max(max_price_, other.max_price_);
+    min_price_ticks_ = std::min(min_price_ticks_, other.min_price_ticks_);
+    max_price_ticks_ = std::max(max_price_ticks_, other.max_price_ticks_);
+  }
+
+  price_sum_ += other.price_sum_;
+  weighted_price_sum_ += other.weighted_price_sum_;
+  price_ticks_sum_ += other.price_ticks_sum_;
+  weighted_price_ticks_sum_ += other.weighted_price_ticks_sum_;
+  total_volume_ += other.total_volume_;
+  count_ += other.count_;
+}
+
+auto AggregateAccumulator::AddSums_(const kernels::ColumnSums &sums) noexcept -> void {
+  if (sums.count == 0) return;
+
+  min_price_ = count_ == 0 ? sums.min_price : std::min(min_price_, sums.min_price);
+  max_price_ = count_ == 0 ? sums.max_price : std::max(max_price_, sums.max_price);
+  price_sum_ += sums.price_sum;
+  weighted_price_sum_ += sums.weighted_price_sum;
+  total_volume_ += sums.total_volume;
+  count_ += sums.count;
+}
+
+auto AggregateAccumulator::GetCount() const noexcept -> size_t {
+  return count_;
+}
+
+auto AggregateAccumulator::ToResult() const noexcept -> AggregateResult {
+  if (count_ == 0) return {};
+
+  if (!price_scale_.IsFixedPoint()) {
+    auto vwap = total_volume_ > 0
+      ? weighted_price_sum_ / total_volume_ : weighted_price_sum_;
+
+    return {count_, total_volume_, max_price_, min_price_,
+            price_sum_ / count_, vwap};
+  }
+
+  // The sums are exact, only the final quotients are rounded to double
+  auto avg_price = ExactQuotient_(price_ticks_sum_, count_);
+  auto vwap = total_volume_ > 0
+    ? ExactQuotient_(weighted_price_ticks_sum_, total_volume_) : 0.0;
+
+  return {
+    count_, total_volume_,
+    price_scale_.ToPrice(max_price_ticks_), price_scale_.ToPrice(min_price_ticks_),
+    price_scale_.ToPrice(avg_price), price_scale_.ToPrice(vwap)
+  };
+}
+
+auto AggregateAccumulator::ExactQuotient_(wide_int numerator,
+                                          uint64_t denominator) const noexcept -> double {
+#if defined(__SIZEOF_INT128__)
+  auto quotient = numerator / denominator;
+  auto remainder = numerator % denominator;
+  return double(quotient) + (double(remainder) / double(denominator));
+#else
+  return double(numerator / denominator);
+#endif
+}
+
+}
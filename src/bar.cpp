@@ -0,0 +1,96 @@
+#include "../include/bolt/bar.hpp"
+
+namespace bolt {
+
+Bar::Bar(uint64_t timestamp,
+         double open, double high, double low, double close,
+         uint64_t volume, double vwap, size_t count)
+  : timestamp_(timestamp), open_(open), high_(high), low_(low), close_(close),
+    volume_(volume), vwap_(vwap), count_(count) {}
+
+auto Bar::operator==(const Bar &other) const noexcept -> bool {
+  return EqualityCheck_(other);
+}
+
+auto Bar::operator!=(const Bar &other) const noexcept -> bool {
+  return !EqualityCheck_(other);
+}
+
+auto Bar::SetTimestamp(uint64_t timestamp) noexcept -> void {
+  timestamp_ = timestamp;
+}
+
+auto Bar::SetOpen(double open) noexcept -> void {
+  open_ = open;
+}
+
+auto Bar::SetHigh(double high) noexcept -> void {
+  high_ = high;
+}
+
+auto Bar::SetLow(double low) noexcept -> void {
+  low_ = low;
+}
+
+auto Bar::SetClose(double close) noexcept -> void {
+  close_ = close;
+}
+
+auto Bar::SetVolume(uint64_t volume) noexcept -> void {
+  volume_ = volume;
+}
+
+auto Bar::SetVwap(double vwap) noexcept -> void {
+  vwap_ = vwap;
+}
+
+auto Bar::SetCount(size_t count) noexcept -> void {
+  count_ = count;
+}
+
+auto Bar::GetTimestamp() const noexcept -> uint64_t {
+  return timestamp_;
+}
+
+auto Bar::GetOpen() const noexcept -> double {
+  return open_;
+}
+
+auto Bar::GetHigh() const noexcept -> double {
+  return high_;
+}
+
+auto Bar::GetLow() const noexcept -> double {
+  return low_;
+}
+
+auto Bar::GetClose() const noexcept -> double {
+  return close_;
+}
+
+auto Bar::GetVolume() const noexcept -> uint64_t {
+  return volume_;
+}
+
+auto Bar::GetVwap() const noexcept -> double {
+  return vwap_;
+}
+
+auto Bar::GetCount() const noexcept -> size_t {
+  return count_;
+}
+
+auto Bar::EqualityCheck_(const Bar &other) const noexcept -> bool {
+  if (other.timestamp_ != timestamp_) return false;
+  if (other.open_ != open_) return false;
+  if (other.high_ != high_) return false;
+  if (other.low_ != low_) return false;
+  if (other.close_ != close_) return false;
+  if (other.volume_ != volume_) return false;
+  if (other.vwap_ != vwap_) return false;
+  if (other.count_ != count_) return false;
+
+  return true;
+}
+
+}
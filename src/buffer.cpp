@@ -1,15 +1,28 @@
 #include "headers/buffer.hpp"
+#include "headers/constants.hpp"
 #include "../include/bolt/tick.hpp"
 #include <numeric>
 #include <algorithm>
+#include <span>
+
+using namespace Constants;
 
 namespace bolt {
 
-Buffer::Buffer(size_t reserve_capacity) {
+Buffer::Buffer(size_t reserve_capacity) : Buffer(reserve_capacity, PriceScale()) {}
+
+Buffer::Buffer(size_t reserve_capacity, const PriceScale &price_scale)
+  : price_scale_(price_scale) {
+
   timestamps_.reserve(reserve_capacity);
-  prices_.reserve(reserve_capacity);
   volumes_.reserve(reserve_capacity);
 
+  if (price_scale_.IsFixedPoint()) {
+    price_ticks_.reserve(reserve_capacity);
+  } else {
+    prices_.reserve(reserve_capacity);
+  }
+
   symbol_ids_.reserve(reserve_capacity);
   exchange_ids_.reserve(reserve_capacity);
   trace_conditions_.reserve(reserve_capacity);
@@ -61,6 +74,10 @@ auto Buffer::GetPrices() const noexcept -> list_cref<double> {
   return prices_;
 }
 
+auto Buffer::GetPriceTicks() const noexcept -> list_cref<int64_t> {
+  return price_ticks_;
+}
+
 auto Buffer::GetVolumes() const noexcept -> list_cref<uint32_t> {
   return volumes_;
 }
@@ -70,15 +87,93 @@ auto Buffer::GetTraceCondtions() const noexcept
   return trace_conditions_;
 }
 
+auto Buffer::GetPriceScale() const noexcept -> const PriceScale & {
+  return price_scale_;
+}
+
+auto Buffer::GetPrice(size_t index) const noexcept -> double {
+  if (price_scale_.IsFixedPoint()) {
+    return price_scale_.ToPrice(price_ticks_[index]);
+  }
+  return prices_[index];
+}
+
+auto Buffer::GetTick(size_t index) const noexcept -> Tick {
+  return {
+    timestamps_[index], GetPrice(index), volumes_[index],
+    symbol_ids_[index], exchange_ids_[index], trace_conditions_[index]
+  };
+}
+
 auto Buffer::InsertTick(const Tick &tick) noexcept -> void {
   StoreData_({tick});
 }
 
+auto Buffer::InsertRow(const Buffer &other, size_t index) noexcept -> void {
+  if (price_scale_ != other.price_scale_) {
+    InsertTick(other.GetTick(index));
+    return;
+  }
+
+  summary_.reset();
+  block_summaries_.clear();
+  zone_map_.reset();
+  block_zone_maps_.clear();
+  price_sketch_.reset();
+  volume_sketch_.reset();
+  symbol_sketches_.reset();
+
+  if (size_ > 0 && is_sorted_ && timestamps_.back() > other.timestamps_[index]) {
+    is_sorted_ = false;
+  }
+
+  timestamps_.push_back(other.timestamps_[index]);
+  volumes_.push_back(other.volumes_[index]);
+
+  if (price_scale_.IsFixedPoint()) {
+    price_ticks_.push_back(other.price_ticks_[index]);
+  } else {
+    prices_.push_back(other.prices_[index]);
+  }
+
+  symbol_ids_.push_back(other.symbol_ids_[index]);
+  exchange_ids_.push_back(other.exchange_ids_[index]);
+  trace_conditions_.push_back(other.trace_conditions_[index]);
+  size_++;
+}
+
 auto Buffer::Size() const noexcept -> size_t {
   return size_;
 }
 
+auto Buffer::MemoryUsage() const noexcept -> size_t {
+  auto memory_usage = sizeof(Buffer)
+    + (timestamps_.capacity() * sizeof(uint64_t))
+    + (symbol_ids_.capacity() * sizeof(uint32_t))
+    + (exchange_ids_.capacity() * sizeof(uint32_t))
+    + (prices_.capacity() * sizeof(double))
+    + (price_ticks_.capacity() * sizeof(int64_t))
+    + (volumes_.capacity() * sizeof(uint32_t))
+    + (trace_conditions_.capacity() * sizeof(TradeConditions))
+    + (block_summaries_.capacity() * sizeof(AggregateAccumulator))
+    + (block_zone_maps_.capacity() * sizeof(ZoneMap))
+    + (price_sketch_ ? price_sketch_->MemoryUsage() : 0)
+    + (volume_sketch_ ? volume_sketch_->MemoryUsage() : 0);
+
+  if (symbol_sketches_) {
+    memory_usage += symbol_sketches_->capacity() * sizeof(ExchangeSymbols);
+    for (const auto &[exchange_id, symbols] : *symbol_sketches_) {
+      memory_usage += symbols.MemoryUsage() - sizeof(HyperLogLog);
+    }
+  }
+  return memory_usage;
+}
+
 auto Buffer::Sort(bool ascending) noexcept -> void {
+  MoveFrom_(SortedCopy(ascending));
+}
+
+auto Buffer::SortedCopy(bool ascending) const -> Buffer {
   auto indices = std::vector<size_t>(timestamps_.size());
   std::iota(indices.begin(), indices.end(), 0);
 
@@ -88,31 +183,133 @@ auto Buffer::Sort(bool ascending) noexcept -> void {
   };
 
   std::sort(indices.begin(), indices.end(), comp);
-  auto temp_buffer = Buffer(timestamps_.size());
+  auto temp_buffer = Buffer(timestamps_.size(), price_scale_);
 
   for (const auto &index : indices) {
-    temp_buffer.timestamps_.push_back(timestamps_[index]);
-    temp_buffer.prices_.push_back(prices_[index]);
-    temp_buffer.volumes_.push_back(volumes_[index]);
-
-    temp_buffer.symbol_ids_.push_back(symbol_ids_[index]);
-    temp_buffer.exchange_ids_.push_back(exchange_ids_[index]);
-    temp_buffer.trace_conditions_.push_back(trace_conditions_[index]);
+    temp_buffer.InsertRow(*this, index);
   }
 
-  timestamps_ = std::move(temp_buffer.timestamps_);
-  prices_ = std::move(temp_buffer.prices_);
-  volumes_ = std::move(temp_buffer.volumes_);
-
-  symbol_ids_ = std::move(temp_buffer.symbol_ids_);
-  exchange_ids_ = std::move(temp_buffer.exchange_ids_);
-  trace_conditions_ = std::move(temp_buffer.trace_conditions_);
+  temp_buffer.is_sorted_ = ascending || size_ < 2;
+  return temp_buffer;
 }
 
 auto Buffer::IsSorted() const noexcept -> bool {
   return is_sorted_;
 }
 
+auto Buffer::ComputeSummary() noexcept -> void {
+  auto summary = AggregateAccumulator(price_scale_);
+  auto zone_map = ZoneMap();
+  auto blocks = (size_ + kSUMMARY_BLOCK_SIZE - 1) / kSUMMARY_BLOCK_SIZE;
+
+  block_summaries_.clear();
+  block_summaries_.reserve(blocks);
+  block_zone_maps_.clear();
+  block_zone_maps_.reserve(blocks);
+
+  for (size_t begin = 0; begin < size_; begin += kSUMMARY_BLOCK_SIZE) {
+    auto end = std::min<size_t>(begin + kSUMMARY_BLOCK_SIZE, size_);
+    auto block = AggregateAccumulator(price_scale_);
+    AddRows_(block, begin, end);
+
+    auto block_zone_map = ZoneMap();
+    for (auto i = begin; i < end; i++) {
+      block_zone_map.Add(symbol_ids_[i], exchange_ids_[i], GetPrice(i),
+                         volumes_[i], trace_conditions_[i]);
+    }
+
+    summary.Merge(block);
+    zone_map.Merge(block_zone_map);
+    block_summaries_.push_back(block);
+    block_zone_maps_.push_back(block_zone_map);
+  }
+  summary_ = summary;
+  zone_map_ = zone_map;
+
+  price_sketch_.emplace();
+  volume_sketch_.emplace();
+  for (size_t i = 0; i < size_; i++) {
+    price_sketch_->Add(GetPrice(i));
+    volume_sketch_->Add(volumes_[i]);
+  }
+
+  symbol_sketches_.emplace();
+  for (size_t i = 0; i < size_; i++) {
+    auto it = std::lower_bound(symbol_sketches_->begin(), symbol_sketches_->end(), exchange_ids_[i],
+                               [](const ExchangeSymbols &entry, uint32_t exchange_id) {
+      return entry.exchange_id < exchange_id;
+    });
+    if (it == symbol_sketches_->end() || it->exchange_id != exchange_ids_[i]) {
+      it = symbol_sketches_->insert(it, ExchangeSymbols{exchange_ids_[i], HyperLogLog()});
+    }
+    it->symbols.Add(symbol_ids_[i]);
+  }
+}
+
+auto Buffer::GetSummary() const noexcept -> const std::optional<AggregateAccumulator> & {
+  return summary_;
+}
+
+auto Buffer::GetBlockSummaries() const noexcept -> list_cref<AggregateAccumulator> {
+  return block_summaries_;
+}
+
+auto Buffer::GetPriceSketch() const noexcept -> const std::optional<QuantileSketch> & {
+  return price_sketch_;
+}
+
+auto Buffer::GetVolumeSketch() const noexcept -> const std::optional<QuantileSketch> & {
+  return volume_sketch_;
+}
+
+auto Buffer::GetSymbolSketches() const noexcept -> const std::optional<std::vector<ExchangeSymbols>> & {
+  return symbol_sketches_;
+}
+
+auto Buffer::GetZoneMap() const noexcept -> const std::optional<ZoneMap> & {
+  return zone_map_;
+}
+
+auto Buffer::GetBlockZoneMaps() const noexcept -> list_cref<ZoneMap> {
+  return block_zone_maps_;
+}
+
+auto Buffer::Summarize(size_t begin, size_t end) const noexcept -> AggregateAccumulator {
+  auto accumulator = AggregateAccumulator(price_scale_);
+
+  if (begin == 0 && end == size_ && summary_) {
+    accumulator.Merge(*summary_);
+    return accumulator;
+  }
+
+  // Only the rows before the first and after the last whole block are scanned
+  auto first_block = (begin + kSUMMARY_BLOCK_SIZE - 1) / kSUMMARY_BLOCK_SIZE;
+  auto last_block = std::min(end / kSUMMARY_BLOCK_SIZE, block_summaries_.size());
+
+  if (first_block >= last_block) {
+    AddRows_(accumulator, begin, end);
+    return accumulator;
+  }
+
+  AddRows_(accumulator, begin, first_block * kSUMMARY_BLOCK_SIZE);
+  for (auto block = first_block; block < last_block; block++) {
+    accumulator.Merge(block_summaries_[block]);
+  }
+  AddRows_(accumulator, last_block * kSUMMARY_BLOCK_SIZE, end);
+  return accumulator;
+}
+
+auto Buffer::AddRows_(AggregateAccumulator &accumulator,
+                      size_t begin, size_t end) const noexcept -> void {
+  auto volumes = std::span(volumes_).subspan(begin, end - begin);
+
+  if (price_scale_.IsFixedPoint()) {
+    accumulator.AddFixed(std::span(price_ticks_).subspan(begin, end - begin), volumes);
+  } else {
+    accumulator.Add(std::span(prices_).subspan(begin, end - begin), volumes);
+  }
+}
+
 auto Buffer::Copy() const noexcept -> Buffer {
   return {*this};
 }
@@ -120,6 +317,8 @@ auto Buffer::Copy() const noexcept -> Buffer {
 auto Buffer::EqualityCheck_(const Buffer &other) const noexcept -> bool {
   if (timestamps_ != other.timestamps_) return false;
   if (prices_ != other.prices_) return false;
+  if (price_ticks_ != other.price_ticks_) return false;
+  if (price_scale_ != other.price_scale_) return false;
   if (volumes_ != other.volumes_) return false;
 
   if (symbol_ids_ != other.symbol_ids_) return false;
@@ -132,6 +331,8 @@ auto Buffer::EqualityCheck_(const Buffer &other) const noexcept -> bool {
 auto Buffer::CopyFrom_(const Buffer &other) -> void {
   timestamps_ = other.timestamps_;
   prices_ = other.prices_;
+  price_ticks_ = other.price_ticks_;
+  price_scale_ = other.price_scale_;
   volumes_ = other.volumes_;
 
   symbol_ids_ = other.symbol_ids_;
@@ -140,11 +341,20 @@ auto Buffer::CopyFrom_(const Buffer &other) -> void {
 
   size_ = other.size_;
   is_sorted_ = other.is_sorted_;
+  summary_ = other.summary_;
+  block_summaries_ = other.block_summaries_;
+  zone_map_ = other.zone_map_;
+  block_zone_maps_ = other.block_zone_maps_;
+  price_sketch_ = other.price_sketch_;
+  volume_sketch_ = other.volume_sketch_;
+  symbol_sketches_ = other.symbol_sketches_;
 }
 
 auto Buffer::MoveFrom_(Buffer &&other) noexcept -> void {
   timestamps_ = std::move(other.timestamps_);
   prices_ = std::move(other.prices_);
+  price_ticks_ = std::move(other.price_ticks_);
+  price_scale_ = other.price_scale_;
   volumes_ = std::move(other.volumes_);
 
   symbol_ids_ = std::move(other.symbol_ids_);
@@ -152,21 +362,46 @@ auto Buffer::MoveFrom_(Buffer &&other) noexcept -> void {
   trace_conditions_ = std::move(other.trace_conditions_);
   is_sorted_ = other.is_sorted_;
   size_ = other.size_;
+  summary_ = std::move(other.summary_);
+  block_summaries_ = std::move(other.block_summaries_);
+  zone_map_ = std::move(other.zone_map_);
+  block_zone_maps_ = std::move(other.block_zone_maps_);
+  price_sketch_ = std::move(other.price_sketch_);
+  volume_sketch_ = std::move(other.volume_sketch_);
+  symbol_sketches_ = std::move(other.symbol_sketches_);
 
   other.size_ = {};
   other.is_sorted_ = true;
+  other.summary_.reset();
+  other.zone_map_.reset();
+  other.price_sketch_.reset();
+  other.volume_sketch_.reset();
+  other.symbol_sketches_.reset();
 }
 
 auto Buffer::StoreData_(const std::vector<Tick> &ticks) noexcept -> void {
+  summary_.reset();
+  block_summaries_.clear();
+  zone_map_.reset();
+  block_zone_maps_.clear();
+  price_sketch_.reset();
+  volume_sketch_.reset();
+  symbol_sketches_.reset();
+
   for (const auto &tick : ticks) {
     if (!timestamps_.empty() && is_sorted_) {
       if (timestamps_.back() > tick.GetTimestamp()) is_sorted_ = false;
     }
 
     timestamps_.push_back(tick.GetTimestamp());
-    prices_.push_back(tick.GetPrice());
     volumes_.push_back(tick.GetVolume());
 
+    if (price_scale_.IsFixedPoint()) {
+      price_ticks_.push_back(price_scale_.ToTicks(tick.GetPrice()));
+    } else {
+      prices_.push_back(tick.GetPrice());
+    }
+
     symbol_ids_.push_back(tick.GetSymbolId());
     exchange_ids_.push_back(tick.GetExchangeId());
     trace_conditions_.push_back(tick.GetTradeCondition());
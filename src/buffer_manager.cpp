@@ -1,74 +1,534 @@
 #include "headers/buffer_manager.hpp"
 #include "headers/buffer.hpp"
+#include "headers/basic_buffer.hpp"
 #include "headers/thread_pool.hpp"
 #include "headers/state.hpp"
 #include "headers/constants.hpp"
 
 #include "../include/bolt/tick.hpp"
+#include "../include/bolt/quote.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <queue>
+#include <tuple>
 
 using namespace Constants;
 
 namespace bolt {
 
-BufferManager::BufferManager(ThreadPool &pool) : pool_(pool) {
-  maximum_sealed_buffers_ = ::kMAXIMUM_SEALED_BUFFERS;
+namespace {
+
+auto SteadyNow() noexcept -> int64_t {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}
+
+// The tick buffers additionally carry the price encoding, quotes are kept as plain columns
+template <>
+auto BufferManager::MakeBuffer_(size_t reserve_capacity) const -> ptr<Buffer> {
+  return std::make_shared<Buffer>(reserve_capacity, price_scale_);
+}
+
+template <>
+auto BufferManager::AppendToActive_(const Tick &tick) noexcept -> void {
+  active_buffer_->InsertTick(tick);
+}
+
+template <>
+auto BufferManager::UpdateLastValues_(const Tick &tick) noexcept -> void {
+  last_values_.Update(tick);
+}
+
+// Full-buffer aggregates are precomputed for the ticks only
+template <>
+auto BufferManager::SealBuffer_(Buffer &buffer) const noexcept -> void {
+  buffer.ComputeSummary();
+}
+
+template <>
+auto BufferManager::PushToRollup_(const Rollup &rollup, const Buffer &buffer) const -> Rollup {
+  const auto &timestamps = buffer.GetTimestamps();
+  if (timestamps.empty()) return rollup.PushBack({}, 0, 0);
+
+  return rollup.PushBack(buffer.GetSummary() ? *buffer.GetSummary()
+                                             : buffer.Summarize(0, buffer.Size()),
+                         timestamps.front(), timestamps.back());
+}
+
+template <>
+auto QuoteBufferManager::MakeBuffer_(size_t reserve_capacity) const -> ptr<QuoteBuffer> {
+  return std::make_shared<QuoteBuffer>(reserve_capacity);
+}
+
+template <>
+auto QuoteBufferManager::AppendToActive_(const Quote &quote) noexcept -> void {
+  active_buffer_->InsertRecord(quote.ToRecord());
+}
+
+template <>
+auto QuoteBufferManager::UpdateLastValues_(const Quote &quote) noexcept -> void {
+  last_values_.Update(quote);
+}
+
+template <>
+auto QuoteBufferManager::SealBuffer_(QuoteBuffer &) const noexcept -> void {}
+
+template <>
+auto QuoteBufferManager::PushToRollup_(const Rollup &rollup, const QuoteBuffer &) const -> Rollup {
+  return rollup;
+}
+
+template <>
+auto RawBufferManager::MakeBuffer_(size_t reserve_capacity) const -> ptr<RawBuffer> {
+  return std::make_shared<RawBuffer>(layout_, reserve_capacity);
+}
+
+template <>
+auto RawBufferManager::AppendToActive_(const RawRecord &record) noexcept -> void {
+  active_buffer_->InsertRecord(record);
+}
+
+template <>
+auto RawBufferManager::UpdateLastValues_(const RawRecord &) noexcept -> void {}
+
+template <>
+auto RawBufferManager::SealBuffer_(RawBuffer &) const noexcept -> void {}
+
+template <>
+auto RawBufferManager::PushToRollup_(const Rollup &rollup, const RawBuffer &) const -> Rollup {
+  return rollup;
+}
+
+template <typename BufferType, typename RecordType>
+BasicBufferManager<BufferType, RecordType>::BasicBufferManager(
+  ThreadPool &pool, const Config &config) : BasicBufferManager(pool, config, nullptr) {}
+
+template <typename BufferType, typename RecordType>
+BasicBufferManager<BufferType, RecordType>::BasicBufferManager(
+  ThreadPool &pool, const Config &config, const RawLayout &layout)
+  : layout_(layout), pool_(pool), task_guard_(std::make_shared<TaskGuard>()) {
+  memory_budget_ = config.GetMemoryBudget();
+  retention_period_ = config.GetRetentionPeriod();
+  expiry_interval_ = config.GetExpiryInterval();
+  price_scale_ = PriceScale(config.GetPriceScale());
   maximum_buffer_size_ = ::kMAXIMUM_SEALED_BUFFER_SIZE;
 
-  current_state_ = std::make_shared<const State>();
+  current_state_ = std::make_shared<const state_type>();
   sealed_buffers_ = std::make_shared<sealed_list>();
-  active_buffer_ = std::make_shared<Buffer>();
+  // Reserved up front, so that the rows already published to readers
+  // are never moved by a reallocation while the buffer is appended to.
+  active_buffer_ = MakeBuffer_(maximum_buffer_size_);
+  published_active_ = active_buffer_;
+
+  if (retention_period_ > 0 && expiry_interval_ > 0) {
+    expiry_thread_ = std::thread(&BasicBufferManager::RunExpiryTimer_, this);
+  }
+}
+
+template <typename BufferType, typename RecordType>
+BasicBufferManager<BufferType, RecordType>::~BasicBufferManager() {
+  {
+    auto lock = std::unique_lock<std::mutex>(expiry_mutex_);
+    stop_expiry_ = true;
+  }
+  expiry_condition_.notify_one();
+  if (expiry_thread_.joinable()) expiry_thread_.join();
+
+  // Waits for the running tasks, the ones still queued in the pool are skipped
+  auto lock = std::unique_lock<std::shared_mutex>(task_guard_->mutex);
+  task_guard_->alive = false;
+}
+
+template <typename BufferType, typename RecordType>
+template <typename TaskType>
+auto BasicBufferManager<BufferType, RecordType>::AssignTask_(TaskType &&task) noexcept
+  -> void {
+  pool_.AssignTask([guard = task_guard_, task = std::forward<TaskType>(task)]() mutable {
+    auto lock = std::shared_lock<std::shared_mutex>(guard->mutex);
+    if (guard->alive) task();
+  });
 }
 
-auto BufferManager::Insert(const Tick &tick) noexcept -> void {
-  InsertBase_(tick);
+template <typename BufferType, typename RecordType>
+auto BasicBufferManager<BufferType, RecordType>::Insert(const RecordType &record) noexcept
+  -> void {
+  InsertBase_(record);
 }
 
-auto BufferManager::Insert(const std::vector<Tick> &ticks) noexcept -> void {
-  for (const auto &tick : ticks) {
-    InsertBase_(tick);
+template <typename BufferType, typename RecordType>
+auto BasicBufferManager<BufferType, RecordType>::Insert(
+  const std::vector<RecordType> &records) noexcept -> void {
+  for (const auto &record : records) {
+    InsertBase_(record);
   }
 }
 
-auto BufferManager::GetState() const noexcept -> std::shared_ptr<const State> {
+template <typename BufferType, typename RecordType>
+auto BasicBufferManager<BufferType, RecordType>::GetState() const noexcept
+  -> std::shared_ptr<const state_type> {
   return current_state_.load(std::memory_order_acquire);
 }
 
-auto BufferManager::SetNewState_(ptr<Buffer> &&new_sealed_buffer) noexcept -> void {
-  std::shared_ptr<const State> new_state;
+template <typename BufferType, typename RecordType>
+auto BasicBufferManager<BufferType, RecordType>::MemoryUsage() const noexcept -> size_t {
+  return memory_usage_.load(std::memory_order_acquire);
+}
+
+template <typename BufferType, typename RecordType>
+auto BasicBufferManager<BufferType, RecordType>::GetPriceScale() const noexcept
+  -> const PriceScale & {
+  return price_scale_;
+}
+
+template <typename BufferType, typename RecordType>
+auto BasicBufferManager<BufferType, RecordType>::SetMemoryBudget(size_t memory_budget) noexcept
+  -> void {
   {
     auto lock = std::unique_lock<std::mutex>(background_mutex_);
+    memory_budget_ = memory_budget;
+  }
+  SetNewState_(nullptr);
+}
+
+template <typename BufferType, typename RecordType>
+auto BasicBufferManager<BufferType, RecordType>::GetLastValues() const noexcept
+  -> const last_value_cache & {
+  return last_values_;
+}
+
+template <typename BufferType, typename RecordType>
+auto BasicBufferManager<BufferType, RecordType>::SetNewState_(
+  ptr<BufferType> &&new_sealed_buffer,
+  ptr<BufferType> active_buffer,
+  size_t active_size,
+  uint64_t sequence) noexcept -> void {
+  auto lock = std::unique_lock<std::mutex>(background_mutex_);
+
+  // The tasks may run out of order, a newer handover is never replaced
+  if (active_buffer && sequence > published_sequence_) {
+    published_active_ = std::move(active_buffer);
+    published_active_size_ = active_size;
+    published_sequence_ = sequence;
+  }
+
+  auto active_memory_usage = published_active_->MemoryUsage();
+  auto horizon = GetRetentionHorizon_();
+
+  auto expiry_pending = !sealed_buffers_->empty() && earliest_sealed_expiry_ < horizon;
+
+  // The budget may also have been lowered since the last eviction
+  auto eviction_pending = !sealed_buffers_->empty() &&
+                          sealed_memory_usage_ + active_memory_usage > memory_budget_;
+
+  if (new_sealed_buffer || expiry_pending || eviction_pending) {
+    // Readers may still hold the current list through their State,
+    // so the modifications are done on a copy which is then published.
+    auto sealed_buffers = std::make_shared<sealed_list>(*sealed_buffers_);
+    auto rollup = rollup_;
+
     if (new_sealed_buffer) {
-      sealed_buffers_->emplace_back(std::move(new_sealed_buffer));
+      sealed_memory_usage_ += new_sealed_buffer->MemoryUsage();
+      rollup = PushToRollup_(rollup, *new_sealed_buffer);
+      sealed_buffers->emplace_back(std::move(new_sealed_buffer));
+    }
+
+    auto appended_size = sealed_buffers->size();
+    auto appended_back = sealed_buffers->empty() ? nullptr : sealed_buffers->back();
 
-      if (sealed_buffers_->size() >= size_t(maximum_sealed_buffers_)) {
-        sealed_buffers_->pop_front();
+    ExpireBuffers_(*sealed_buffers, horizon);
+    EvictToBudget_(*sealed_buffers, active_memory_usage);
+
+    // The rollup is only trimmed when exactly the oldest buffers were dropped,
+    // which is the usual case, and rebuilt otherwise.
+    auto removed = appended_size - sealed_buffers->size();
+    if (removed > 0 && !sealed_buffers->empty()) {
+      auto expected_front = removed < sealed_buffers_->size() ? sealed_buffers_->at(removed)
+                                                              : appended_back;
+      if (sealed_buffers->front() == expected_front) {
+        while (removed-- > 0) rollup = rollup.PopFront();
+      } else {
+        rollup = RebuildRollup_(*sealed_buffers);
       }
+    } else if (sealed_buffers->empty()) {
+      rollup = Rollup();
     }
-    new_state = std::make_shared<const State>(active_buffer_, sealed_buffers_);
+
+    sealed_buffers_ = std::move(sealed_buffers);
+    rollup_ = std::move(rollup);
+    UpdateEarliestExpiry_();
   }
-  current_state_.store(std::move(new_state), std::memory_order_acquire);
+  PublishState_(horizon);
 }
 
-auto BufferManager::InsertBase_(const Tick &tick) noexcept -> void {
-  active_buffer_->InsertTick(tick);
+template <typename BufferType, typename RecordType>
+auto BasicBufferManager<BufferType, RecordType>::PublishState_(uint64_t horizon) noexcept
+  -> void {
+  memory_usage_.store(sealed_memory_usage_ + published_active_->MemoryUsage(),
+                      std::memory_order_release);
+
+  // Published under the lock so that a slower task can never replace
+  // a newer state with an older one.
+  current_state_.store(
+    std::make_shared<const state_type>(published_active_, sealed_buffers_,
+                                       horizon, published_active_size_, rollup_),
+    std::memory_order_release
+  );
+}
+
+template <typename BufferType, typename RecordType>
+auto BasicBufferManager<BufferType, RecordType>::EvictToBudget_(
+  sealed_list &sealed_buffers, size_t active_memory_usage) noexcept -> void {
+  while (!sealed_buffers.empty() &&
+         sealed_memory_usage_ + active_memory_usage > memory_budget_) {
+    sealed_memory_usage_ -= sealed_buffers.front()->MemoryUsage();
+    sealed_buffers.pop_front();
+  }
+}
+
+template <typename BufferType, typename RecordType>
+auto BasicBufferManager<BufferType, RecordType>::GetRetentionHorizon_() const noexcept
+  -> uint64_t {
+  auto latest_timestamp = latest_timestamp_.load(std::memory_order_acquire);
+
+  // With the expiry task the horizon keeps moving while the feed is idle
+  if (expiry_thread_.joinable() && latest_timestamp > 0) {
+    auto idle_time = SteadyNow() - latest_ingest_time_.load(std::memory_order_acquire);
+    latest_timestamp += uint64_t(std::max<int64_t>(idle_time, 0));
+  }
+
+  if (retention_period_ == 0 || latest_timestamp < retention_period_) return 0;
+  return latest_timestamp - retention_period_;
+}
+
+template <typename BufferType, typename RecordType>
+auto BasicBufferManager<BufferType, RecordType>::ExpireBuffers_(
+  sealed_list &sealed_buffers, uint64_t horizon) noexcept -> void {
+  // Sealed buffers are sorted, so a buffer whose last timestamp is behind the
+  // horizon has expired as a whole and can be dropped without touching its data.
+  auto expired = [horizon](const const_buffer &buffer) {
+    return buffer->Size() == 0 || buffer->GetTimestamps().back() < horizon;
+  };
+
+  for (const auto &buffer : sealed_buffers) {
+    if (expired(buffer)) sealed_memory_usage_ -= buffer->MemoryUsage();
+  }
+  std::erase_if(sealed_buffers, expired);
+}
+
+template <typename BufferType, typename RecordType>
+auto BasicBufferManager<BufferType, RecordType>::UpdateEarliestExpiry_() noexcept -> void {
+  earliest_sealed_expiry_ = std::numeric_limits<uint64_t>::max();
+
+  for (const auto &buffer : *sealed_buffers_) {
+    if (buffer->Size() == 0) continue;
+    earliest_sealed_expiry_ = std::min(earliest_sealed_expiry_,
+                                       buffer->GetTimestamps().back());
+  }
+}
+
+template <typename BufferType, typename RecordType>
+auto BasicBufferManager<BufferType, RecordType>::RunExpiryTimer_() noexcept -> void {
+  auto lock = std::unique_lock<std::mutex>(expiry_mutex_);
+
+  while (!expiry_condition_.wait_for(lock, std::chrono::milliseconds(expiry_interval_),
+                                     [this] { return stop_expiry_; })) {
+    // Publishes a state with the current horizon, dropping the expired buffers
+    AssignTask_([this] { SetNewState_(nullptr); });
+  }
+}
+
+template <typename BufferType, typename RecordType>
+auto BasicBufferManager<BufferType, RecordType>::RebuildRollup_(
+  const sealed_list &sealed_buffers) const -> Rollup {
+  auto rollup = Rollup();
+  for (const auto &buffer : sealed_buffers) {
+    rollup = PushToRollup_(rollup, *buffer);
+  }
+  return rollup;
+}
+
+template <typename BufferType, typename RecordType>
+auto BasicBufferManager<BufferType, RecordType>::ScheduleCompaction_() noexcept -> void {
+  compaction_pending_.store(true, std::memory_order_release);
+  if (compaction_running_.exchange(true, std::memory_order_acq_rel)) return;
+
+  // A request arriving while a compaction runs is picked up by the same task
+  AssignTask_([this] {
+    do {
+      compaction_pending_.store(false, std::memory_order_release);
+      Compact_();
+      compaction_running_.store(false, std::memory_order_release);
+    } while (compaction_pending_.load(std::memory_order_acquire) &&
+             !compaction_running_.exchange(true, std::memory_order_acq_rel));
+  });
+}
+
+template <typename BufferType, typename RecordType>
+auto BasicBufferManager<BufferType, RecordType>::Compact_() noexcept -> void {
+  while (true) {
+    auto sealed_buffers = GetState()->GetSealedBuffers();
+    auto [run_start, run_end] = FindCompactionRun_(*sealed_buffers);
+
+    if (run_end - run_start < 2) return;
+
+    auto sources = std::vector<const_buffer>(
+      sealed_buffers->begin() + run_start,
+      sealed_buffers->begin() + run_end
+    );
+
+    // The merge is done without holding the lock, the result is only
+    // swapped in if the sources were not evicted or expired meanwhile.
+    if (!SwapCompactedBuffers_(sources, MergeBuffers_(sources))) return;
+  }
+}
+
+template <typename BufferType, typename RecordType>
+auto BasicBufferManager<BufferType, RecordType>::FindCompactionRun_(
+  const sealed_list &sealed_buffers) const noexcept -> std::pair<size_t, size_t> {
+
+  auto undersized = [this](const const_buffer &buffer) {
+    return buffer->Size() < size_t(maximum_buffer_size_ / 2);
+  };
+
+  // A buffer joins the run when its time range overlaps the run, or when both
+  // it and its neighbour are undersized. A merged run never produces more than
+  // one undersized buffer, so the same data is not compacted over and over again.
+  for (size_t start = 0; start + 1 < sealed_buffers.size(); start++) {
+    auto end = start + 1;
+    auto run_end_ts = sealed_buffers[start]->GetTimestamps().back();
+
+    while (end < sealed_buffers.size()) {
+      const auto &prev = sealed_buffers[end - 1];
+      const auto &next = sealed_buffers[end];
+
+      auto overlaps = run_end_ts > next->GetTimestamps().front();
+      if (!overlaps && !(undersized(prev) && undersized(next))) break;
+
+      run_end_ts = std::max(run_end_ts, next->GetTimestamps().back());
+      end++;
+    }
+
+    if (end - start >= 2) return {start, end};
+  }
+  return {0, 0};
+}
+
+template <typename BufferType, typename RecordType>
+auto BasicBufferManager<BufferType, RecordType>::MergeBuffers_(
+  const std::vector<const_buffer> &buffers) const -> std::vector<const_buffer> {
+
+  using cursor = std::tuple<uint64_t, size_t, size_t>;
+  auto heap = std::priority_queue<cursor, std::vector<cursor>, std::greater<cursor>>();
+
+  size_t total_rows = 0;
+  for (size_t i = 0; i < buffers.size(); i++) {
+    if (buffers[i]->Size() > 0) {
+      heap.emplace(buffers[i]->GetTimestamps().front(), i, 0);
+    }
+    total_rows += buffers[i]->Size();
+  }
+
+  auto merged = std::vector<const_buffer>{};
+  auto chunk_size = size_t(maximum_buffer_size_);
+
+  while (!heap.empty()) {
+    auto [ts, buffer_idx, row] = heap.top();
+    heap.pop();
+
+    if (merged.empty() || merged.back()->Size() >= chunk_size) {
+      total_rows -= merged.empty() ? 0 : merged.back()->Size();
+      merged.emplace_back(MakeBuffer_(std::min(chunk_size, total_rows)));
+    }
+    merged.back()->InsertRow(*buffers[buffer_idx], row);
+
+    if (row + 1 < buffers[buffer_idx]->Size()) {
+      heap.emplace(buffers[buffer_idx]->GetTimestamps()[row + 1], buffer_idx, row + 1);
+    }
+  }
+
+  for (const auto &buffer : merged) {
+    SealBuffer_(*buffer);
+  }
+  return merged;
+}
+
+template <typename BufferType, typename RecordType>
+auto BasicBufferManager<BufferType, RecordType>::SwapCompactedBuffers_(
+  const std::vector<const_buffer> &sources,
+  std::vector<const_buffer> &&merged) noexcept -> bool {
+
+  auto lock = std::unique_lock<std::mutex>(background_mutex_);
+
+  auto it = std::find(sealed_buffers_->begin(), sealed_buffers_->end(), sources.front());
+  if (size_t(std::distance(it, sealed_buffers_->end())) < sources.size()) return false;
+  if (!std::equal(sources.begin(), sources.end(), it)) return false;
+
+  auto sealed_buffers = std::make_shared<sealed_list>(sealed_buffers_->begin(), it);
+
+  for (const auto &buffer : sources) {
+    sealed_memory_usage_ -= buffer->MemoryUsage();
+  }
+  for (auto &buffer : merged) {
+    sealed_memory_usage_ += buffer->MemoryUsage();
+    sealed_buffers->emplace_back(std::move(buffer));
+  }
+  sealed_buffers->insert(sealed_buffers->end(),
+                         it + sources.size(), sealed_buffers_->end());
+
+  sealed_buffers_ = std::move(sealed_buffers);
+  rollup_ = RebuildRollup_(*sealed_buffers_);
+  UpdateEarliestExpiry_();
+
+  PublishState_(GetRetentionHorizon_());
+  return true;
+}
+
+template <typename BufferType, typename RecordType>
+auto BasicBufferManager<BufferType, RecordType>::InsertBase_(const RecordType &record) noexcept
+  -> void {
+  AppendToActive_(record);
+  UpdateLastValues_(record);
+
+  // Late records keep the feed from counting as idle as well
+  if (expiry_thread_.joinable()) {
+    latest_ingest_time_.store(SteadyNow(), std::memory_order_release);
+  }
+  if (record.GetTimestamp() > latest_timestamp_.load(std::memory_order_relaxed)) {
+    latest_timestamp_.store(record.GetTimestamp(), std::memory_order_release);
+  }
 
   if (active_buffer_->Size() >= size_t(maximum_buffer_size_)) {
-    auto buffer_to_seal = std::make_shared<Buffer>(maximum_buffer_size_);
+    auto buffer_to_seal = MakeBuffer_(maximum_buffer_size_);
     std::swap(active_buffer_, buffer_to_seal);
 
-    auto sealing_task = [this, sealed_buffer = std::move(buffer_to_seal)]() mutable {
-      if (!sealed_buffer->IsSorted()) {
-        sealed_buffer->Sort();
-      }
-      SetNewState_(std::move(sealed_buffer));
+    auto sealing_task = [this, sealed_buffer = std::move(buffer_to_seal),
+                         active = active_buffer_, sequence = ++insert_sequence_]() mutable {
+      // Older states (and the cursors pinning them) still reference this
+      // buffer as their active one and read it concurrently, so it is never
+      // sorted nor summarized in place: the sealed buffer is always a copy.
+      sealed_buffer = std::make_shared<BufferType>(sealed_buffer->IsSorted()
+                                                     ? sealed_buffer->Copy()
+                                                     : sealed_buffer->SortedCopy());
+      SealBuffer_(*sealed_buffer);
+      SetNewState_(std::move(sealed_buffer), std::move(active), 0, sequence);
+      ScheduleCompaction_();
     };
-    pool_.AssignTask(std::move(sealing_task));
+    AssignTask_(std::move(sealing_task));
 
   } else {
-    pool_.AssignTask([this]{
-      SetNewState_(nullptr);
+    AssignTask_([this, active = active_buffer_, size = active_buffer_->Size(),
+                      sequence = ++insert_sequence_]() mutable {
+      SetNewState_(nullptr, std::move(active), size, sequence);
     });
   }
 }
 
+template class BasicBufferManager<Buffer, Tick>;
+template class BasicBufferManager<QuoteBuffer, Quote>;
+template class BasicBufferManager<RawBuffer, RawRecord>;
+
 }
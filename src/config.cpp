@@ -0,0 +1,73 @@
+#include "headers/constants.hpp"
+#include "../include/bolt/config.hpp"
+
+#include <algorithm>
+
+using namespace Constants;
+
+namespace bolt {
+
+Config::Config() {
+  memory_budget_ = ::kDEFAULT_MEMORY_BUDGET;
+  quote_memory_share_ = ::kDEFAULT_QUOTE_MEMORY_SHARE;
+  table_memory_share_ = ::kDEFAULT_TABLE_MEMORY_SHARE;
+  parallel_query_threshold_ = ::kDEFAULT_PARALLEL_QUERY_THRESHOLD;
+}
+
+auto Config::SetMemoryBudget(size_t memory_budget) noexcept -> void {
+  memory_budget_ = memory_budget;
+}
+
+auto Config::GetMemoryBudget() const noexcept -> size_t {
+  return memory_budget_;
+}
+
+auto Config::SetQuoteMemoryShare(double quote_memory_share) noexcept -> void {
+  quote_memory_share_ = std::clamp(quote_memory_share, 0.0, 1.0);
+}
+
+auto Config::GetQuoteMemoryShare() const noexcept -> double {
+  return quote_memory_share_;
+}
+
+auto Config::SetTableMemoryShare(double table_memory_share) noexcept -> void {
+  table_memory_share_ = std::clamp(table_memory_share, 0.0, 1.0);
+}
+
+auto Config::GetTableMemoryShare() const noexcept -> double {
+  return table_memory_share_;
+}
+
+auto Config::SetRetentionPeriod(uint64_t retention_period) noexcept -> void {
+  retention_period_ = retention_period;
+}
+
+auto Config::GetRetentionPeriod() const noexcept -> uint64_t {
+  return retention_period_;
+}
+
+auto Config::SetExpiryInterval(uint64_t expiry_interval) noexcept -> void {
+  expiry_interval_ = expiry_interval;
+}
+
+auto Config::GetExpiryInterval() const noexcept -> uint64_t {
+  return expiry_interval_;
+}
+
+auto Config::SetPriceScale(double price_scale) noexcept -> void {
+  price_scale_ = price_scale;
+}
+
+auto Config::GetPriceScale() const noexcept -> double {
+  return price_scale_;
+}
+
+auto Config::SetParallelQueryThreshold(size_t parallel_query_threshold) noexcept -> void {
+  parallel_query_threshold_ = parallel_query_threshold;
+}
+
+auto Config::GetParallelQueryThreshold() const noexcept -> size_t {
+  return parallel_query_threshold_;
+}
+
+}
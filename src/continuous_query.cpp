@@ -0,0 +1,21 @@
+#include "../include/bolt/continuous_query.hpp"
+#include "../include/bolt/aggregate_result.hpp"
+
+#include "headers/subscription.hpp"
+
+namespace bolt {
+
+ContinuousQuery::ContinuousQuery(std::shared_ptr<const Subscription> subscription)
+  : subscription_(std::move(subscription)) {}
+
+auto ContinuousQuery::GetResult() const noexcept -> AggregateResult {
+  if (!subscription_) return {};
+  return subscription_->GetResult();
+}
+
+auto ContinuousQuery::GetWindow() const noexcept -> uint64_t {
+  if (!subscription_) return 0;
+  return subscription_->GetWindow();
+}
+
+}
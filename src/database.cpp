@@ -4,21 +4,295 @@
 #include "headers/state.hpp"
 #include "headers/constants.hpp"
 #include "headers/ring_buffer.hpp"
+#include "headers/aggregate_accumulator.hpp"
+#include "headers/group_accumulator.hpp"
+#include "headers/predicate_evaluator.hpp"
+#include "headers/basic_buffer.hpp"
+#include "headers/subscription.hpp"
+#include "headers/sliding_window.hpp"
+#include "headers/quantile_sketch.hpp"
+#include "headers/hyper_log_log.hpp"
 
 #include "../include/bolt/database.hpp"
 #include "../include/bolt/tick.hpp"
 #include "../include/bolt/aggregate_result.hpp"
+#include "../include/bolt/bar.hpp"
+#include "../include/bolt/tick_page.hpp"
+#include "../include/bolt/rolling_series.hpp"
+#include "../include/bolt/quantile_result.hpp"
+#include "../include/bolt/predicate.hpp"
+#include "../include/bolt/quote.hpp"
+#include "../include/bolt/quote_aggregate_result.hpp"
 
 #include <algorithm>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <map>
+#include <queue>
+#include <span>
+#include <type_traits>
 
 using namespace Constants;
 
 namespace bolt {
 
-Database::Database() {
+namespace {
+
+struct BufferSlice {
+  const Buffer *buffer;
+  size_t begin;
+  size_t end;
+};
+
+auto AddColumns(AggregateAccumulator &accumulator,
+                const Buffer &buffer, size_t begin, size_t end) noexcept -> void {
+  auto count = end - begin;
+  auto volumes = std::span(buffer.GetVolumes()).subspan(begin, count);
+
+  if (buffer.GetPriceScale().IsFixedPoint()) {
+    accumulator.AddFixed(std::span(buffer.GetPriceTicks()).subspan(begin, count), volumes);
+  } else {
+    accumulator.Add(std::span(buffer.GetPrices()).subspan(begin, count), volumes);
+  }
+}
+
+auto AddGroupColumns(GroupAccumulator &groups, const Buffer &buffer,
+                     TickColumn key_column, size_t begin, size_t end) -> void {
+  auto count = end - begin;
+  const auto &key_list = key_column == TickColumn::kSymbolId
+    ? buffer.GetSymbolIds() : buffer.GetExchangeIds();
+
+  auto keys = std::span(key_list).subspan(begin, count);
+  auto volumes = std::span(buffer.GetVolumes()).subspan(begin, count);
+
+  if (buffer.GetPriceScale().IsFixedPoint()) {
+    groups.AddFixed(keys, std::span(buffer.GetPriceTicks()).subspan(begin, count), volumes);
+  } else {
+    groups.Add(keys, std::span(buffer.GetPrices()).subspan(begin, count), volumes);
+  }
+}
+
+// Merges the consecutive sorted runs ticks[bounds[r], bounds[r + 1]) into a
+// single sorted list with a k-way heap merge, O(n log k) for k overlapping
+// runs. Ties keep the order of the runs.
+auto MergeSortedRuns(std::vector<Tick> &&ticks,
+                     const std::vector<size_t> &bounds) -> std::vector<Tick> {
+  auto overlapping = false;
+  for (size_t run = 1; run + 1 < bounds.size() && !overlapping; run++) {
+    auto boundary = bounds[run];
+    overlapping = boundary > 0 && boundary < ticks.size() &&
+                  ticks[boundary - 1].GetTimestamp() > ticks[boundary].GetTimestamp();
+  }
+  if (!overlapping) return std::move(ticks);
+
+  // (timestamp, run) of the head of every non-empty run, smallest on top
+  using head = std::pair<uint64_t, size_t>;
+  auto heads = std::priority_queue<head, std::vector<head>, std::greater<head>>{};
+  auto positions = std::vector<size_t>(bounds.begin(), bounds.end() - 1);
+
+  for (size_t run = 0; run + 1 < bounds.size(); run++) {
+    if (bounds[run] < bounds[run + 1]) heads.emplace(ticks[bounds[run]].GetTimestamp(), run);
+  }
+
+  auto merged = std::vector<Tick>{};
+  merged.reserve(ticks.size());
+
+  while (!heads.empty()) {
+    auto run = heads.top().second;
+    heads.pop();
+
+    // Rows of the same run are taken as long as they stay the smallest
+    auto next = heads.empty()
+      ? head{std::numeric_limits<uint64_t>::max(), std::numeric_limits<size_t>::max()}
+      : heads.top();
+
+    auto &position = positions[run];
+    do {
+      merged.push_back(std::move(ticks[position++]));
+    } while (position < bounds[run + 1] &&
+             head{ticks[position].GetTimestamp(), run} < next);
+
+    if (position < bounds[run + 1]) heads.emplace(ticks[position].GetTimestamp(), run);
+  }
+  return merged;
+}
+
+auto CollectAll(const Buffer &buffer, size_t begin, size_t end, bool,
+                std::vector<Tick> &ticks) -> void {
+  for (auto i = begin; i < end; i++) {
+    ticks.push_back(buffer.GetTick(i));
+  }
+}
+
+// The mask a filter writes its selection of one slice to, reused by the
+// slices scanned on the same thread instead of allocated for each of them
+auto SelectionMask(size_t size) -> std::vector<uint8_t> & {
+  thread_local auto mask = std::vector<uint8_t>{};
+  mask.resize(size);
+  return mask;
+}
+
+// Adds the rows of [begin, end) selected by the mask, all of them without one
+auto AddSelected(AggregateAccumulator &accumulator, const Buffer &buffer,
+                 size_t begin, size_t end, const uint8_t *mask) -> void {
+  if (!mask) {
+    accumulator.Merge(buffer.Summarize(begin, end));
+    return;
+  }
+
+  const auto &volumes = buffer.GetVolumes();
+  if (buffer.GetPriceScale().IsFixedPoint()) {
+    const auto &price_ticks = buffer.GetPriceTicks();
+    for (auto i = begin; i < end; i++) {
+      if (mask[i - begin]) accumulator.AddFixed(price_ticks[i], volumes[i]);
+    }
+  } else {
+    const auto &prices = buffer.GetPrices();
+    for (auto i = begin; i < end; i++) {
+      if (mask[i - begin]) accumulator.Add(prices[i], volumes[i]);
+    }
+  }
+}
+
+struct BarBucket {
+  AggregateAccumulator accumulator;
+  uint64_t open_ts {};
+  uint64_t close_ts {};
+  double open {};
+  double close {};
+};
+
+auto GetPrice(const Buffer &buffer, size_t row) noexcept -> double {
+  const auto &price_scale = buffer.GetPriceScale();
+  if (price_scale.IsFixedPoint()) return price_scale.ToPrice(buffer.GetPriceTicks()[row]);
+  return buffer.GetPrices()[row];
+}
+
+// The price and volume sketches of the rows [begin, end), a whole sealed
+// buffer contributes the sketches computed when it was sealed. The rows of
+// the active buffer are always added one by one, since it is appended to
+// concurrently.
+struct SketchPair {
+  QuantileSketch prices;
+  QuantileSketch volumes;
+};
+
+auto AddToSketches(SketchPair &sketches, const Buffer &buffer, size_t begin, size_t end,
+                   bool is_sealed) -> void {
+  if (is_sealed && begin == 0 && end == buffer.Size() && buffer.GetPriceSketch()) {
+    sketches.prices.Merge(*buffer.GetPriceSketch());
+    sketches.volumes.Merge(*buffer.GetVolumeSketch());
+    return;
+  }
+
+  for (auto i = begin; i < end; i++) {
+    sketches.prices.Add(GetPrice(buffer, i));
+    sketches.volumes.Add(buffer.GetVolumes()[i]);
+  }
+}
+
+// The distinct symbols and exchanges of the rows [begin, end), optionally
+// only those traded on an exchange. A whole sealed buffer contributes the
+// sketches computed when it was sealed, the rows of the active buffer are
+// always added one by one.
+struct DistinctSketches {
+  HyperLogLog symbols;
+  HyperLogLog exchanges;
+};
+
+auto AddToDistinct(DistinctSketches &sketches, const Buffer &buffer, size_t begin, size_t end,
+                   std::optional<uint32_t> exchange_id, bool is_sealed) -> void {
+  if (is_sealed && begin == 0 && end == buffer.Size() && buffer.GetSymbolSketches()) {
+    for (const auto &[exchange, symbols] : *buffer.GetSymbolSketches()) {
+      if (exchange_id && exchange != *exchange_id) continue;
+      sketches.symbols.Merge(symbols);
+      sketches.exchanges.Add(exchange);
+    }
+    return;
+  }
+
+  const auto &symbol_ids = buffer.GetSymbolIds();
+  const auto &exchange_ids = buffer.GetExchangeIds();
+  for (auto i = begin; i < end; i++) {
+    if (exchange_id && exchange_ids[i] != *exchange_id) continue;
+    sketches.symbols.Add(symbol_ids[i]);
+    sketches.exchanges.Add(exchange_ids[i]);
+  }
+}
+
+// Drops the sealed slices whose zone map rules out all the predicates. The
+// zone map of the active buffer (the source with an 'order') is never read,
+// it may still be written to.
+template <typename Sources>
+auto DropUnmatchedSources(Sources &sources, const std::vector<PredicateEvaluator> &evaluators) -> void {
+  std::erase_if(sources, [&evaluators](const auto &source) {
+    if (!source.order.empty()) return false;
+
+    const auto &zone_map = source.buffer->GetZoneMap();
+    return zone_map && std::all_of(evaluators.begin(), evaluators.end(), [&zone_map](const auto &evaluator) {
+      return evaluator.Check(*zone_map) == PredicateEvaluator::ZoneMatch::kNone;
+    });
+  });
+}
+
+// Adds the rows [begin, end) of a single bucket, first_row and last_row being
+// the rows with the lowest and highest timestamp among them. Ties keep the
+// first stored row as the open and the last stored one as the close.
+auto AddToBar(BarBucket &bar, const Buffer &buffer, size_t begin, size_t end,
+              size_t first_row, size_t last_row) noexcept -> void {
+  const auto &ts_list = buffer.GetTimestamps();
+  auto is_empty = bar.accumulator.GetCount() == 0;
+
+  if (is_empty || ts_list[first_row] < bar.open_ts) {
+    bar.open_ts = ts_list[first_row];
+    bar.open = GetPrice(buffer, first_row);
+  }
+
+  if (is_empty || ts_list[last_row] >= bar.close_ts) {
+    bar.close_ts = ts_list[last_row];
+    bar.close = GetPrice(buffer, last_row);
+  }
+
+  if (end - begin == 1) {
+    if (buffer.GetPriceScale().IsFixedPoint()) {
+      bar.accumulator.AddFixed(buffer.GetPriceTicks()[begin], buffer.GetVolumes()[begin]);
+    } else {
+      bar.accumulator.Add(buffer.GetPrices()[begin], buffer.GetVolumes()[begin]);
+    }
+  } else {
+    AddColumns(bar.accumulator, buffer, begin, end);
+  }
+}
+
+auto ToBar(const BarBucket &bucket, uint64_t timestamp) -> Bar {
+  auto result = bucket.accumulator.ToResult();
+  return {timestamp, bucket.open, result.GetMaxPrice(), result.GetMinPrice(), bucket.close,
+          result.GetTotalVolume(), result.GetVwap(), result.GetCount()};
+}
+
+}
+
+Database::Database() : Database(Config()) {}
+
+Database::Database(const Config &config) {
   data_buffer_ = std::make_shared<RingBuffer>();
+  quote_buffer_ = std::make_shared<QuoteRingBuffer>();
   thread_pool_ = std::make_shared<ThreadPool>();
-  storage_handler_ = std::make_shared<BufferManager>(*thread_pool_);
+
+  // Each table enforces its own part of the memory budget
+  auto quote_config = config;
+  auto quote_budget = size_t(double(config.GetMemoryBudget()) * config.GetQuoteMemoryShare());
+  quote_config.SetMemoryBudget(quote_budget);
+
+  auto tick_config = config;
+  tick_memory_budget_ = config.GetMemoryBudget() - quote_budget;
+  tick_config.SetMemoryBudget(tick_memory_budget_);
+
+  storage_handler_ = std::make_shared<BufferManager>(*thread_pool_, tick_config);
+  quote_storage_handler_ = std::make_shared<QuoteBufferManager>(*thread_pool_, quote_config);
+  parallel_query_threshold_ = config.GetParallelQueryThreshold();
+  config_ = config;
   stop_insert_thread_ = false;
 
   StartInsertThread_();
@@ -30,21 +304,51 @@ Database::~Database() {
   thread_pool_->Shutdown();
 }
 
+auto Database::CreateRawTable_(const std::vector<size_t> &column_widths)
+  -> std::shared_ptr<RawTable> {
+  auto lock = std::unique_lock<std::mutex>(tables_mutex_);
+
+  // The part of the table is given up by the ticks, so that the stored
+  // data of all the tables together stays within the Database budget
+  auto table_budget = std::min(
+    size_t(double(config_.GetMemoryBudget()) * config_.GetTableMemoryShare()),
+    tick_memory_budget_
+  );
+  tick_memory_budget_ -= table_budget;
+  storage_handler_->SetMemoryBudget(tick_memory_budget_);
+
+  auto table_config = config_;
+  table_config.SetMemoryBudget(table_budget);
+
+  auto table = std::shared_ptr<RawTable>(new RawTable(thread_pool_, table_config, column_widths));
+  tables_.push_back(table);
+  return table;
+}
+
 auto Database::Insert(const std::vector<Tick> &ticks) noexcept -> void {
   InsertBase_(ticks);
 }
 
 auto Database::Insert(const Tick &tick) noexcept -> void {
-  InsertBase_({tick});
+  InsertBase_(std::vector<Tick>{tick});
+}
+
+auto Database::Insert(const std::vector<Quote> &quotes) noexcept -> void {
+  InsertBase_(quotes);
+}
+
+auto Database::Insert(const Quote &quote) noexcept -> void {
+  InsertBase_(std::vector<Quote>{quote});
 }
 
 auto Database::GetForRange(uint64_t start_ts, uint64_t end_ts)
   -> std::vector<Tick> {
 
-  if (start_ts > end_ts) return {};
   const auto &state = storage_handler_->GetState();
+  start_ts = ClampToRetention_(state, start_ts);
+  if (start_ts > end_ts) return {};
 
-  return GetSortedTicks_(start_ts, end_ts, state);
+  return GetSortedTicks_(start_ts, end_ts, state, CollectAll);
 }
 
 auto Database::GetForRange(uint64_t start_ts,
@@ -52,189 +356,1005 @@ auto Database::GetForRange(uint64_t start_ts,
                            const filter_func &filter)
   -> std::vector<Tick> {
 
+  const auto &state = storage_handler_->GetState();
+  start_ts = ClampToRetention_(state, start_ts);
+  if (start_ts > end_ts) return {};
+
+  return GetSortedTicks_(start_ts, end_ts, state,
+                         [&filter](const Buffer &buffer, size_t begin, size_t end, bool,
+                                   std::vector<Tick> &ticks) {
+    for (auto i = begin; i < end; i++) {
+      auto tick = buffer.GetTick(i);
+      if (filter(tick)) ticks.push_back(std::move(tick));
+    }
+  });
+}
+
+auto Database::GetForRange(uint64_t start_ts,
+                           uint64_t end_ts,
+                           const Predicate &predicate)
+  -> std::vector<Tick> {
+
+  const auto &state = storage_handler_->GetState();
+  start_ts = ClampToRetention_(state, start_ts);
+  if (start_ts > end_ts) return {};
+
+  auto evaluator = PredicateEvaluator(predicate);
+  return GetSortedTicks_(start_ts, end_ts, state,
+                         [&evaluator](const Buffer &buffer, size_t begin, size_t end, bool,
+                                      std::vector<Tick> &ticks) {
+    evaluator.ForEachMatch(buffer, begin, end,
+                           [&buffer, &ticks](size_t begin, size_t end, const uint8_t *mask) {
+      for (auto i = begin; i < end; i++) {
+        if (!mask || mask[i - begin]) ticks.push_back(buffer.GetTick(i));
+      }
+    });
+  });
+}
+
+template <typename StateType, typename Func>
+auto Database::ForEachSealedSlice_(const std::shared_ptr<const StateType> &state,
+                                   uint64_t start_ts,
+                                   uint64_t end_ts,
+                                   Func &&func) const -> void {
+
+  for (const auto &buffer : *state->GetSealedBuffers()) {
+    const auto &ts_list = buffer->GetTimestamps();
+    if (ts_list.empty() || end_ts < ts_list.front() || start_ts > ts_list.back()) {
+      continue;
+    }
+
+    auto it_start = std::lower_bound(ts_list.begin(), ts_list.end(), start_ts);
+    auto it_end = std::upper_bound(it_start, ts_list.end(), end_ts);
+
+    if (it_start != it_end) {
+      func(*buffer, std::distance(ts_list.begin(), it_start),
+           std::distance(ts_list.begin(), it_end), true);
+    }
+  }
+}
+
+template <typename Func>
+auto Database::ForEachActiveRun_(const std::shared_ptr<const State> &state,
+                                 uint64_t start_ts,
+                                 uint64_t end_ts,
+                                 Func &&func) const -> void {
+
+  // The active buffer is unsorted, every run of consecutive
+  // rows inside the range becomes a slice of its own.
+  const auto &active_buffer = state->GetActiveBuffer();
+  const auto &active_ts = active_buffer->GetTimestamps();
+  auto active_size = state->GetActiveSize();
+
+  for (size_t i = 0; i < active_size;) {
+    if (active_ts[i] < start_ts || active_ts[i] > end_ts) {
+      i++;
+      continue;
+    }
+
+    auto run_start = i;
+    auto run_sorted = true;
+
+    for (i++; i < active_size && active_ts[i] >= start_ts && active_ts[i] <= end_ts; i++) {
+      if (active_ts[i - 1] > active_ts[i]) run_sorted = false;
+    }
+    func(*active_buffer, run_start, i, run_sorted);
+  }
+}
+
+template <typename Func>
+auto Database::ForEachSlice_(const std::shared_ptr<const State> &state,
+                             uint64_t start_ts,
+                             uint64_t end_ts,
+                             Func &&func) const -> void {
+  ForEachSealedSlice_(state, start_ts, end_ts, func);
+  ForEachActiveRun_(state, start_ts, end_ts, func);
+}
+
+template <typename Func>
+auto Database::FanOutSealed_(const std::shared_ptr<const State> &state,
+                             uint64_t start_ts,
+                             uint64_t end_ts,
+                             Func &&func) const -> auto {
+
+  using result_type = std::invoke_result_t<Func &, std::span<const BufferSlice>>;
+
+  auto slices = std::vector<BufferSlice>{};
+  size_t rows = 0;
+
+  ForEachSealedSlice_(state, start_ts, end_ts,
+                      [&slices, &rows](const Buffer &buffer, size_t begin, size_t end, bool) {
+    slices.push_back({&buffer, begin, end});
+    rows += end - begin;
+  });
+
+  // One worker of the pool is taken by the insert loop. While the pool still
+  // has queued work (e.g. the states published during ingest), the groups
+  // would only wait behind it, so the query then runs on the calling thread.
+  auto results = std::vector<result_type>{};
+  auto parts = std::min(slices.size(), thread_pool_->GetThreadCount() - 1);
+
+  if (rows < parallel_query_threshold_ || parts < 2 ||
+      thread_pool_->GetQueuedTaskCount() > 0) {
+    results.push_back(func(std::span<const BufferSlice>(slices)));
+    return results;
+  }
+
+  // Consecutive buffers are grouped, so that the results of the groups
+  // are (mostly) ordered relative to each other as well.
+  auto groups = std::vector<std::span<const BufferSlice>>{};
+  auto target_rows = (rows + parts - 1) / parts;
+  size_t group_begin = 0, group_rows = 0;
+
+  for (size_t i = 0; i < slices.size(); i++) {
+    group_rows += slices[i].end - slices[i].begin;
+
+    if (group_rows >= target_rows || i + 1 == slices.size()) {
+      groups.emplace_back(slices.data() + group_begin, i + 1 - group_begin);
+      group_begin = i + 1;
+      group_rows = 0;
+    }
+  }
+
+  auto futures = std::vector<std::future<result_type>>{};
+  for (size_t i = 1; i < groups.size(); i++) {
+    futures.push_back(thread_pool_->AssignTask([&func, group = groups[i]] {
+      return func(group);
+    }));
+  }
+
+  // The calling thread takes the first group instead of just waiting
+  results.reserve(groups.size());
+  results.push_back(func(groups.front()));
+
+  for (auto &future : futures) {
+    results.push_back(future.get());
+  }
+  return results;
+}
+
+auto Database::GetRangeCursor(uint64_t start_ts,
+                              uint64_t end_ts) const -> RangeCursor {
+
+  auto state = storage_handler_->GetState();
+  start_ts = ClampToRetention_(state, start_ts);
   if (start_ts > end_ts) return {};
+
+  auto slices = std::vector<TickSlice>{};
+
+  ForEachSlice_(state, start_ts, end_ts,
+                [&slices](const Buffer &buffer, size_t begin, size_t end, bool sorted) {
+    slices.emplace_back(TickSlice(buffer, begin, end, sorted));
+  });
+  return {std::move(state), std::move(slices)};
+}
+
+template <typename BufferType>
+auto Database::GetRowSources_(const std::shared_ptr<const BasicState<BufferType>> &state,
+                              uint64_t start_ts,
+                              uint64_t end_ts) const -> std::vector<RowSource<BufferType>> {
+
+  auto sources = std::vector<RowSource<BufferType>>{};
+
+  // The slices of the sealed buffers are sorted, only their bounds are kept
+  ForEachSealedSlice_(state, start_ts, end_ts,
+                      [&sources](const BufferType &buffer, size_t begin, size_t end, bool) {
+    sources.push_back({&buffer, {}, begin, end});
+  });
+
+  const auto &active_buffer = state->GetActiveBuffer();
+  const auto &active_ts = active_buffer->GetTimestamps();
+
+  auto order = std::vector<uint32_t>{};
+  for (size_t i = 0; i < state->GetActiveSize(); i++) {
+    if (active_ts[i] >= start_ts && active_ts[i] <= end_ts) order.push_back(uint32_t(i));
+  }
+  std::stable_sort(order.begin(), order.end(), [&active_ts](uint32_t lhs, uint32_t rhs) {
+    return active_ts[lhs] < active_ts[rhs];
+  });
+
+  if (!order.empty()) {
+    auto size = order.size();
+    sources.push_back({active_buffer.get(), std::move(order), 0, size});
+  }
+  return sources;
+}
+
+template <typename BufferType, typename Func>
+auto Database::ForEachRowInOrder_(const std::vector<RowSource<BufferType>> &sources,
+                                  std::vector<size_t> &cursors,
+                                  bool descending,
+                                  Func &&func) -> bool {
+
+  auto row_at = [&sources](size_t source, size_t position) {
+    const auto &order = sources[source].order;
+    return order.empty() ? position : size_t(order[position]);
+  };
+
+  // The row the source yields next, the one before the cursor when descending
+  auto next_row = [&](size_t source) {
+    return row_at(source, descending ? cursors[source] - 1 : cursors[source]);
+  };
+
+  auto has_next = [&](size_t source) {
+    return descending ? cursors[source] > sources[source].low
+                      : cursors[source] < sources[source].high;
+  };
+
+  // (timestamp, source) of the next row of every source. Ties are taken in
+  // the order of the sources, so a descending walk yields exactly the
+  // reverse of the ascending one.
+  using head = std::pair<uint64_t, size_t>;
+  auto comes_after = [descending](const head &lhs, const head &rhs) {
+    return descending ? lhs < rhs : lhs > rhs;
+  };
+
+  auto heads = std::vector<head>{};
+  for (size_t source = 0; source < sources.size(); source++) {
+    if (has_next(source)) {
+      heads.emplace_back(sources[source].buffer->GetTimestamps()[next_row(source)], source);
+    }
+  }
+  std::make_heap(heads.begin(), heads.end(), comes_after);
+
+  auto proceed = true;
+  while (!heads.empty() && proceed) {
+    std::pop_heap(heads.begin(), heads.end(), comes_after);
+    auto source = heads.back().second;
+    heads.pop_back();
+
+    const auto &buffer = *sources[source].buffer;
+    proceed = func(buffer, next_row(source));
+
+    if (descending) {
+      cursors[source]--;
+    } else {
+      cursors[source]++;
+    }
+
+    if (has_next(source)) {
+      heads.emplace_back(buffer.GetTimestamps()[next_row(source)], source);
+      std::push_heap(heads.begin(), heads.end(), comes_after);
+    }
+  }
+  return !heads.empty();
+}
+
+auto Database::GetPage(uint64_t start_ts,
+                       uint64_t end_ts,
+                       size_t limit,
+                       bool descending) const -> TickPage {
+
+  // A page of no rows would never advance the token
+  if (limit == 0) return {};
+
+  auto state = storage_handler_->GetState();
+  start_ts = ClampToRetention_(state, start_ts);
+  if (start_ts > end_ts) return {};
+
+  auto sources = GetRowSources_(state, start_ts, end_ts);
+  if (sources.empty()) return {};
+
+  auto token = ContinuationToken();
+  token.limit_ = limit;
+
+  // The sources follow the order of the sealed buffers, the active one comes last
+  auto source = sources.begin();
+  for (const auto &buffer : *state->GetSealedBuffers()) {
+    if (source != sources.end() && source->buffer == buffer.get()) {
+      token.buffers_.push_back(buffer);
+      ++source;
+    }
+  }
+  if (source != sources.end()) token.buffers_.push_back(state->GetActiveBuffer());
+
+  token.is_descending_ = descending;
+
+  for (const auto &source : sources) {
+    token.cursors_.push_back(descending ? source.high : source.low);
+  }
+  token.sources_ = std::make_shared<const std::vector<ContinuationToken::Source>>(std::move(sources));
+
+  return GetNextPage_(std::move(token));
+}
+
+auto Database::GetPage(const ContinuationToken &token) const -> TickPage {
+  if (!token.HasMore()) return {};
+  return GetNextPage_(ContinuationToken(token));
+}
+
+auto Database::GetNextPage_(ContinuationToken &&token) const -> TickPage {
+  auto page = TickPage();
+  page.ticks_.reserve(std::min(token.limit_, size_t(kPAGE_RESERVE_LIMIT)));
+
+  auto has_more = ForEachRowInOrder_(*token.sources_, token.cursors_, token.is_descending_,
+                                     [&page, limit = token.limit_](const Buffer &buffer, size_t row) {
+    page.ticks_.push_back(buffer.GetTick(row));
+    return page.ticks_.size() < limit;
+  });
+
+  // An exhausted token releases the snapshot right away
+  if (has_more) page.token_ = std::move(token);
+  return page;
+}
+
+auto Database::GetColumnsForRange(uint64_t start_ts,
+                                  uint64_t end_ts,
+                                  TickColumn columns) const -> TickColumns {
+
+  auto cursor = GetRangeCursor(start_ts, end_ts);
+  auto result = TickColumns(columns);
+
+  result.Reserve_(cursor.Size());
+  for (const auto &slice : cursor.GetSlices()) {
+    result.AppendSlice_(slice);
+  }
+
+  if (cursor.IsSorted()) return result;
+
+  // Overlapping or unsorted slices, the order is restored with a single
+  // permutation (the timestamps are needed for it even if not requested).
+  if (result.Has_(TickColumn::kTimestamp)) {
+    result.SortByTimestamp_(result.timestamps_);
+    return result;
+  }
+
+  auto timestamps = std::vector<uint64_t>{};
+  timestamps.reserve(cursor.Size());
+  for (const auto &slice : cursor.GetSlices()) {
+    timestamps.insert(timestamps.end(),
+                      slice.GetTimestamps().begin(), slice.GetTimestamps().end());
+  }
+  result.SortByTimestamp_(timestamps);
+  return result;
+}
+
+auto Database::Quantiles(uint64_t start_ts,
+                         uint64_t end_ts,
+                         const std::vector<double> &quantiles) -> QuantileResult {
+
   const auto &state = storage_handler_->GetState();
+  start_ts = ClampToRetention_(state, start_ts);
+
+  auto sketches = SketchPair{};
+  if (start_ts <= end_ts) {
+    auto partials = FanOutSealed_(state, start_ts, end_ts, [](std::span<const BufferSlice> slices) {
+      auto partial = SketchPair{};
+      for (const auto &slice : slices) {
+        AddToSketches(partial, *slice.buffer, slice.begin, slice.end, true);
+      }
+      return partial;
+    });
+
+    for (const auto &partial : partials) {
+      sketches.prices.Merge(partial.prices);
+      sketches.volumes.Merge(partial.volumes);
+    }
+
+    ForEachActiveRun_(state, start_ts, end_ts,
+                      [&sketches](const Buffer &buffer, size_t begin, size_t end, bool) {
+      AddToSketches(sketches, buffer, begin, end, false);
+    });
+  }
+
+  return {quantiles, sketches.prices.Quantiles(quantiles),
+          sketches.volumes.Quantiles(quantiles), size_t(sketches.prices.Count())};
+}
+
+auto Database::CountDistinctSymbols(uint64_t start_ts,
+                                    uint64_t end_ts) -> size_t {
+  return CountDistinct_(start_ts, end_ts, TickColumn::kSymbolId, std::nullopt);
+}
+
+auto Database::CountDistinctSymbols(uint64_t start_ts,
+                                    uint64_t end_ts,
+                                    uint32_t exchange_id) -> size_t {
+  return CountDistinct_(start_ts, end_ts, TickColumn::kSymbolId, exchange_id);
+}
+
+auto Database::CountDistinctExchanges(uint64_t start_ts,
+                                      uint64_t end_ts) -> size_t {
+  return CountDistinct_(start_ts, end_ts, TickColumn::kExchangeId, std::nullopt);
+}
+
+auto Database::Rolling(uint64_t start_ts,
+                       uint64_t end_ts,
+                       uint64_t window,
+                       RollingMetric metrics) -> RollingSeries {
+  return Rolling_(start_ts, end_ts, window, metrics, std::nullopt);
+}
+
+auto Database::Rolling(uint64_t start_ts,
+                       uint64_t end_ts,
+                       uint64_t window,
+                       RollingMetric metrics,
+                       uint32_t symbol_id) -> RollingSeries {
+  return Rolling_(start_ts, end_ts, window, metrics, symbol_id);
+}
+
+auto Database::AsOfJoin(uint64_t start_ts,
+                        uint64_t end_ts,
+                        const Predicate &left,
+                        const Predicate &right,
+                        uint64_t tolerance) -> std::vector<JoinedTick> {
+
+  auto rows = std::vector<JoinedTick>{};
+  const auto &state = storage_handler_->GetState();
+
+  // The right side reaches back up to the tolerance before the range
+  start_ts = ClampToRetention_(state, start_ts);
+  auto right_start_ts = ClampToRetention_(state, start_ts - std::min(start_ts, tolerance));
+  if (start_ts > end_ts) return rows;
+
+  auto sources = GetRowSources_(state, right_start_ts, end_ts);
+  DropUnmatchedSources(sources, {PredicateEvaluator(left), PredicateEvaluator(right)});
+
+  auto cursors = std::vector<size_t>{};
+  for (const auto &source : sources) {
+    cursors.push_back(source.low);
+  }
 
-  return GetSortedTicks_(start_ts, end_ts, state, filter);
+  // The left ticks of a timestamp wait for the right ticks of the same
+  // timestamp, which may come after them
+  auto pending = std::vector<Tick>{};
+  auto latest = std::optional<Tick>();
+
+  auto flush = [&]() {
+    for (auto &tick : pending) {
+      auto is_match = latest && tick.GetTimestamp() - latest->GetTimestamp() <= tolerance;
+      rows.emplace_back(std::move(tick), is_match ? latest : std::nullopt);
+    }
+    pending.clear();
+  };
+
+  ForEachRowInOrder_(sources, cursors, false, [&](const Buffer &buffer, size_t row) {
+    auto tick = buffer.GetTick(row);
+    if (!pending.empty() && pending.front().GetTimestamp() < tick.GetTimestamp()) flush();
+
+    if (right.Matches(tick)) latest = tick;
+    if (tick.GetTimestamp() >= start_ts && left.Matches(tick)) pending.push_back(std::move(tick));
+    return true;
+  });
+  flush();
+  return rows;
 }
 
 auto Database::Aggregate(uint64_t start_ts,
                          uint64_t end_ts) -> AggregateResult {
 
-  if (start_ts > end_ts) return {};
   const auto &state = storage_handler_->GetState();
+  start_ts = ClampToRetention_(state, start_ts);
+  if (start_ts > end_ts) return {};
 
-  auto sorted_ticks = GetSortedTicks_(start_ts, end_ts, state);
-  auto result = AggregateResult();
+  // The aggregates are order independent, so the column slices are
+  // accumulated as they are stored, without copying or sorting them.
+  const auto &price_scale = storage_handler_->GetPriceScale();
+  auto accumulator = AggregateAccumulator(price_scale);
+
+  // Buffers covered entirely contribute their precomputed summary, the
+  // partially covered ones at the edges of the range their block summaries
+  // and the rows around them. That leaves too little work to split across
+  // the thread pool.
+  const auto &sealed_buffers = *state->GetSealedBuffers();
+  const auto &rollup = state->GetRollup();
+
+  auto add_partial = [&accumulator, start_ts, end_ts](const Buffer &buffer) {
+    const auto &ts_list = buffer.GetTimestamps();
+    auto begin = std::lower_bound(ts_list.begin(), ts_list.end(), start_ts) - ts_list.begin();
+    auto end = std::upper_bound(ts_list.begin() + begin, ts_list.end(), end_ts) - ts_list.begin();
+
+    if (begin < end) accumulator.Merge(buffer.Summarize(begin, end));
+  };
+
+  if (rollup.IsOrdered() && rollup.Size() == sealed_buffers.size()) {
+    // Ordered buffers entirely inside the range are consecutive, their
+    // summaries are merged by the rollup in O(log n). At most one buffer
+    // on either side of them overlaps the range partially.
+    size_t first = std::partition_point(sealed_buffers.begin(), sealed_buffers.end(),
+                                        [start_ts](const auto &buffer) {
+      return buffer->GetTimestamps().front() < start_ts;
+    }) - sealed_buffers.begin();
+
+    size_t last = std::partition_point(sealed_buffers.begin(), sealed_buffers.end(),
+                                       [end_ts](const auto &buffer) {
+      return buffer->GetTimestamps().back() <= end_ts;
+    }) - sealed_buffers.begin();
+
+    if (first < last) accumulator.Merge(rollup.Query(first, last));
+    if (first > 0) add_partial(*sealed_buffers[first - 1]);
+
+    if (auto after = std::max(first, last); after < sealed_buffers.size()) {
+      add_partial(*sealed_buffers[after]);
+    }
+  } else {
+    ForEachSealedSlice_(state, start_ts, end_ts,
+                        [&accumulator](const Buffer &buffer, size_t begin, size_t end, bool) {
+      accumulator.Merge(buffer.Summarize(begin, end));
+    });
+  }
 
-  SetAggregateObj_(result, sorted_ticks);
-  return result;
+  // The unsorted active buffer is filtered with a timestamp mask in a single
+  // pass, rather than being split into runs
+  const auto &active_buffer = state->GetActiveBuffer();
+  if (price_scale.IsFixedPoint()) {
+    ForEachActiveRun_(state, start_ts, end_ts,
+                      [&accumulator](const Buffer &buffer, size_t begin, size_t end, bool) {
+      AddColumns(accumulator, buffer, begin, end);
+    });
+  } else {
+    auto active_size = state->GetActiveSize();
+    accumulator.AddInRange(std::span(active_buffer->GetTimestamps()).first(active_size),
+                           std::span(active_buffer->GetPrices()).first(active_size),
+                           std::span(active_buffer->GetVolumes()).first(active_size),
+                           start_ts, end_ts);
+  }
+  return accumulator.ToResult();
 }
 
 auto Database::Aggregate(uint64_t start_ts,
                          uint64_t end_ts,
                          const filter_func &filter) -> AggregateResult {
 
+  const auto &state = storage_handler_->GetState();
+  start_ts = ClampToRetention_(state, start_ts);
   if (start_ts > end_ts) return {};
+
+  // With a fixed-point scale the prices read back from the ticks are
+  // quantised again (exactly), so the sums are accumulated as integers.
+  const auto &price_scale = storage_handler_->GetPriceScale();
+  auto accumulator = AggregateAccumulator(price_scale);
+
+  auto add_filtered = [&filter](AggregateAccumulator &accumulator,
+                                const Buffer &buffer, size_t begin, size_t end) {
+    for (auto i = begin; i < end; i++) {
+      auto tick = buffer.GetTick(i);
+      if (filter(tick)) accumulator.Add(tick.GetPrice(), tick.GetVolume());
+    }
+  };
+
+  auto partials = FanOutSealed_(state, start_ts, end_ts,
+                                [&price_scale, &add_filtered](std::span<const BufferSlice> slices) {
+    auto partial = AggregateAccumulator(price_scale);
+    for (const auto &slice : slices) {
+      add_filtered(partial, *slice.buffer, slice.begin, slice.end);
+    }
+    return partial;
+  });
+
+  for (const auto &partial : partials) {
+    accumulator.Merge(partial);
+  }
+
+  ForEachActiveRun_(state, start_ts, end_ts,
+                    [&accumulator, &add_filtered](const Buffer &buffer, size_t begin, size_t end, bool) {
+    add_filtered(accumulator, buffer, begin, end);
+  });
+  return accumulator.ToResult();
+}
+
+auto Database::AggregateBySymbol(uint64_t start_ts,
+                                 uint64_t end_ts) -> std::map<uint32_t, AggregateResult> {
+  return AggregateBy_(start_ts, end_ts, TickColumn::kSymbolId);
+}
+
+auto Database::AggregateByExchange(uint64_t start_ts,
+                                   uint64_t end_ts) -> std::map<uint32_t, AggregateResult> {
+  return AggregateBy_(start_ts, end_ts, TickColumn::kExchangeId);
+}
+
+auto Database::Bars(uint64_t start_ts,
+                    uint64_t end_ts,
+                    uint64_t interval) -> std::vector<Bar> {
+  return Bars_(start_ts, end_ts, interval, std::nullopt);
+}
+
+auto Database::Bars(uint64_t start_ts,
+                    uint64_t end_ts,
+                    uint64_t interval,
+                    uint32_t symbol_id) -> std::vector<Bar> {
+  return Bars_(start_ts, end_ts, interval, symbol_id);
+}
+
+auto Database::Aggregate(uint64_t start_ts,
+                         uint64_t end_ts,
+                         const Predicate &predicate) -> AggregateResult {
+
   const auto &state = storage_handler_->GetState();
+  start_ts = ClampToRetention_(state, start_ts);
+  if (start_ts > end_ts) return {};
 
-  auto sorted_ticks = GetSortedTicks_(start_ts, end_ts, state, filter);
-  auto result = AggregateResult();
+  const auto &price_scale = storage_handler_->GetPriceScale();
+  auto evaluator = PredicateEvaluator(predicate);
+  auto accumulator = AggregateAccumulator(price_scale);
+
+  auto partials = FanOutSealed_(state, start_ts, end_ts,
+                                [&price_scale, &evaluator](std::span<const BufferSlice> slices) {
+    auto partial = AggregateAccumulator(price_scale);
+    for (const auto &slice : slices) {
+      evaluator.ForEachMatch(*slice.buffer, slice.begin, slice.end,
+                             [&partial, &slice](size_t begin, size_t end, const uint8_t *mask) {
+        AddSelected(partial, *slice.buffer, begin, end, mask);
+      });
+    }
+    return partial;
+  });
+
+  for (const auto &partial : partials) {
+    accumulator.Merge(partial);
+  }
 
-  SetAggregateObj_(result, sorted_ticks);
+  ForEachActiveRun_(state, start_ts, end_ts,
+                    [&accumulator, &evaluator](const Buffer &buffer, size_t begin, size_t end, bool) {
+    evaluator.ForEachMatch(buffer, begin, end,
+                           [&accumulator, &buffer](size_t begin, size_t end, const uint8_t *mask) {
+      AddSelected(accumulator, buffer, begin, end, mask);
+    });
+  });
+  return accumulator.ToResult();
+}
+
+auto Database::RegisterContinuousQuery(uint64_t window,
+                                       const Predicate &predicate,
+                                       ContinuousQuery::callback_func callback) -> ContinuousQuery {
+  auto subscription = std::make_shared<Subscription>(window, predicate,
+                                                     storage_handler_->GetPriceScale(),
+                                                     std::move(callback));
+  {
+    auto lock = std::unique_lock<std::mutex>(subscriptions_mutex_);
+    pending_subscriptions_.push_back(subscription);
+    subscriptions_pending_.store(true, std::memory_order_release);
+  }
+  return ContinuousQuery(std::move(subscription));
+}
+
+auto Database::GetQuotesForRange(uint64_t start_ts, uint64_t end_ts)
+  -> std::vector<Quote> {
+
+  const auto &state = quote_storage_handler_->GetState();
+  start_ts = ClampToRetention_(state, start_ts);
+  if (start_ts > end_ts) return {};
+
+  return GetSortedQuotes_(start_ts, end_ts, state);
+}
+
+auto Database::GetQuotesForRange(uint64_t start_ts,
+                                 uint64_t end_ts,
+                                 const quote_filter_func &filter)
+  -> std::vector<Quote> {
+
+  const auto &state = quote_storage_handler_->GetState();
+  start_ts = ClampToRetention_(state, start_ts);
+  if (start_ts > end_ts) return {};
+
+  return GetSortedQuotes_(start_ts, end_ts, state, filter);
+}
+
+auto Database::AggregateQuotes(uint64_t start_ts,
+                               uint64_t end_ts) -> QuoteAggregateResult {
+
+  const auto &state = quote_storage_handler_->GetState();
+  start_ts = ClampToRetention_(state, start_ts);
+  if (start_ts > end_ts) return {};
+
+  auto sorted_quotes = GetSortedQuotes_(start_ts, end_ts, state);
+  auto result = QuoteAggregateResult();
+
+  SetQuoteAggregateObj_(result, sorted_quotes);
   return result;
 }
 
+auto Database::AggregateQuotes(uint64_t start_ts,
+                               uint64_t end_ts,
+                               const quote_filter_func &filter) -> QuoteAggregateResult {
+
+  const auto &state = quote_storage_handler_->GetState();
+  start_ts = ClampToRetention_(state, start_ts);
+  if (start_ts > end_ts) return {};
+
+  auto sorted_quotes = GetSortedQuotes_(start_ts, end_ts, state, filter);
+  auto result = QuoteAggregateResult();
+
+  SetQuoteAggregateObj_(result, sorted_quotes);
+  return result;
+}
+
+auto Database::AsOfJoinQuotes(uint64_t start_ts,
+                              uint64_t end_ts,
+                              const Predicate &trades,
+                              const quote_filter_func &quotes,
+                              uint64_t tolerance) -> std::vector<JoinedQuote> {
+
+  auto rows = std::vector<JoinedQuote>{};
+  const auto &state = storage_handler_->GetState();
+  start_ts = ClampToRetention_(state, start_ts);
+  if (start_ts > end_ts) return rows;
+
+  // The quotes are merged in timestamp order alongside the ticks, only the
+  // prevailing one (passing the filter) is kept instead of materializing them
+  const auto &quote_state = quote_storage_handler_->GetState();
+  auto quotes_start_ts = ClampToRetention_(quote_state, start_ts - std::min(start_ts, tolerance));
+  auto quote_sources = quotes_start_ts <= end_ts
+    ? GetRowSources_(quote_state, quotes_start_ts, end_ts)
+    : std::vector<RowSource<QuoteBuffer>>{};
+
+  auto quote_cursors = std::vector<size_t>{};
+  for (const auto &source : quote_sources) {
+    quote_cursors.push_back(source.low);
+  }
+
+  // The merge can not peek, the first quote past the current tick is put aside
+  auto prevailing = std::optional<Quote>(), pending = std::optional<Quote>();
+  auto quotes_left = !quote_sources.empty();
+
+  auto advance_quotes = [&](uint64_t timestamp) {
+    if (pending) {
+      if (pending->GetTimestamp() > timestamp) return;
+      prevailing = std::exchange(pending, std::nullopt);
+    }
+    if (!quotes_left) return;
+
+    quotes_left = ForEachRowInOrder_(quote_sources, quote_cursors, false,
+                                     [&](const QuoteBuffer &buffer, size_t row) {
+      auto quote = Quote(buffer.GetRecord(row));
+      if (!quotes(quote)) return true;
+
+      if (quote.GetTimestamp() > timestamp) {
+        pending = std::move(quote);
+        return false;
+      }
+      prevailing = std::move(quote);
+      return true;
+    });
+  };
+
+  auto sources = GetRowSources_(state, start_ts, end_ts);
+  DropUnmatchedSources(sources, {PredicateEvaluator(trades)});
+
+  auto cursors = std::vector<size_t>{};
+  for (const auto &source : sources) {
+    cursors.push_back(source.low);
+  }
+
+  ForEachRowInOrder_(sources, cursors, false, [&](const Buffer &buffer, size_t row) {
+    auto tick = buffer.GetTick(row);
+    if (!trades.Matches(tick)) return true;
+
+    advance_quotes(tick.GetTimestamp());
+
+    auto is_match = prevailing && tick.GetTimestamp() - prevailing->GetTimestamp() <= tolerance;
+    rows.emplace_back(std::move(tick), is_match ? prevailing : std::nullopt);
+    return true;
+  });
+  return rows;
+}
+
+auto Database::GetLatestTick(uint32_t symbol_id) const noexcept -> std::optional<Tick> {
+  return storage_handler_->GetLastValues().Get(symbol_id);
+}
+
+auto Database::GetLatestTick(uint32_t symbol_id,
+                             uint32_t exchange_id) const noexcept -> std::optional<Tick> {
+  return storage_handler_->GetLastValues().Get(symbol_id, exchange_id);
+}
+
+auto Database::GetLatestQuote(uint32_t symbol_id) -> std::optional<Quote> {
+  return GetRetainedQuote_(quote_storage_handler_->GetLastValues().Get(symbol_id));
+}
+
+auto Database::GetLatestQuote(uint32_t symbol_id,
+                              uint32_t exchange_id) -> std::optional<Quote> {
+  return GetRetainedQuote_(quote_storage_handler_->GetLastValues().Get(symbol_id, exchange_id));
+}
+
 auto Database::Size() const noexcept -> size_t {
   const auto &state = storage_handler_->GetState();
 
-  auto curr_sealed_buffer_size = state->GetSealedBuffers()->size();
-  if (curr_sealed_buffer_size > 0) {
-    curr_sealed_buffer_size = (curr_sealed_buffer_size * ::kMAXIMUM_SEALED_BUFFER_SIZE);
-    curr_sealed_buffer_size += state->GetSealedBuffers()->back()->Size();
+  auto curr_size = state->GetActiveSize();
+  for (const auto &buffer : *state->GetSealedBuffers()) {
+    curr_size += buffer->Size();
   }
-  return curr_sealed_buffer_size + state->GetActiveBuffer()->Size();
+  return curr_size;
+}
+
+auto Database::MemoryUsage() const noexcept -> size_t {
+  auto usage = storage_handler_->MemoryUsage() + quote_storage_handler_->MemoryUsage();
+
+  auto lock = std::unique_lock<std::mutex>(tables_mutex_);
+  for (const auto &table : tables_) {
+    usage += table->MemoryUsage();
+  }
+  return usage;
 }
 
 auto Database::Flush() noexcept -> void {
-  while (!data_buffer_->IsEmpty()) {
+  while (!data_buffer_->IsEmpty() || !quote_buffer_->IsEmpty()) {
     std::this_thread::yield();
   }
-  stop_insert_thread_.store(true, std::memory_order_release);
+  {
+    auto lock = std::unique_lock<std::mutex>(insert_thread_mutex_);
+    stop_insert_thread_.store(true, std::memory_order_release);
+  }
   data_added_to_buffer_.notify_one();
   thread_pool_->Restart();
+
+  // The insert thread is stopped to drain the pool, it is started
+  // again so that the database keeps accepting data after a flush.
+  stop_insert_thread_.store(false, std::memory_order_release);
+  StartInsertThread_();
+}
+
+auto Database::ClampToRetention_(const std::shared_ptr<const State> &state,
+                                 uint64_t start_ts) const noexcept -> uint64_t {
+  // Expired rows of the boundary buffer are trimmed lazily at query time,
+  // so that the expiry itself never has to rewrite any buffer.
+  return std::max(start_ts, state->GetRetentionHorizon());
+}
+
+auto Database::ClampToRetention_(const std::shared_ptr<const QuoteState> &state,
+                                 uint64_t start_ts) const noexcept -> uint64_t {
+  return std::max(start_ts, state->GetRetentionHorizon());
 }
 
 auto Database::GetTicksFromActiveBuffer_(
   const std::shared_ptr<const State> &state,
   uint64_t start_ts,
   uint64_t end_ts,
-  const filter_func &filter) -> std::pair<bool, std::vector<Tick>> {
+  const collect_func &collect) -> std::pair<bool, std::vector<Tick>> {
 
-  const auto &active_buffer = state->GetActiveBuffer();
+  // The rows are sorted when every run is and each run starts at or after
+  // the end of the previous one, the live buffer itself is never asked.
   auto ticks = std::vector<Tick>{};
+  auto sorted = true;
+  auto previous_end_ts = uint64_t{};
 
-  for (size_t i = 0; i < active_buffer->Size(); i++) {
-    auto curr_ts = active_buffer->GetTimestamps().at(i);
+  ForEachActiveRun_(state, start_ts, end_ts,
+                    [&](const Buffer &buffer, size_t begin, size_t end, bool run_sorted) {
+    const auto &ts_list = buffer.GetTimestamps();
+    if (!run_sorted || ts_list[begin] < previous_end_ts) sorted = false;
+    previous_end_ts = std::max(previous_end_ts, ts_list[end - 1]);
 
-    if (curr_ts >= start_ts && curr_ts <= end_ts) {
-      CheckAndSetTick_(ticks, i, active_buffer, filter);
-    }
-  }
+    collect(buffer, begin, end, run_sorted, ticks);
+  });
 
-  return {active_buffer->IsSorted(), ticks};
+  return {sorted, ticks};
 }
 
 auto Database::GetTicksFromSealedBuffer_(
   const std::shared_ptr<const State> &state,
   uint64_t start_ts,
   uint64_t end_ts,
-  const filter_func &filter) -> std::pair<bool, std::vector<Tick>> {
+  const collect_func &collect) -> std::pair<bool, std::vector<Tick>> {
+
+  // Every sealed slice is sorted, every group of buffers merges its slices
+  // into a sorted run and the runs of the groups are merged the same way.
+  auto runs = FanOutSealed_(state, start_ts, end_ts,
+                            [&collect](std::span<const BufferSlice> slices) {
+    auto ticks = std::vector<Tick>{};
+    auto bounds = std::vector<size_t>{0};
+
+    for (const auto &slice : slices) {
+      collect(*slice.buffer, slice.begin, slice.end, true, ticks);
+      bounds.push_back(ticks.size());
+    }
+    return MergeSortedRuns(std::move(ticks), bounds);
+  });
 
-  auto ticks = std::vector<Tick>{};
-  auto sorted = true;
-  const auto &sealed_buffers = state->GetSealedBuffers();
+  if (runs.size() == 1) return {true, std::move(runs.front())};
 
-  if (!sealed_buffers->empty()) {
-    for (const auto &buffer : *sealed_buffers) {
-      const auto &ts_list = buffer->GetTimestamps();
+  auto ticks = std::vector<Tick>{};
+  auto bounds = std::vector<size_t>{0};
+  for (auto &run : runs) {
+    ticks.insert(ticks.end(), std::make_move_iterator(run.begin()), std::make_move_iterator(run.end()));
+    bounds.push_back(ticks.size());
+  }
+  return {true, MergeSortedRuns(std::move(ticks), bounds)};
+}
 
-      if (ts_list.empty()) continue;
+auto Database::GetSelected_(uint64_t start_ts,
+                            uint64_t end_ts,
+                            const select_func &select) -> std::vector<Tick> {
 
-      // No overlap
-      if (end_ts < ts_list.front() || start_ts > ts_list.back()) {
-        continue;
-      }
-
-      auto it_start = std::lower_bound(ts_list.begin(), ts_list.end(), start_ts);
-      auto it_end = std::upper_bound(ts_list.begin(), ts_list.end(), end_ts);
+  const auto &state = storage_handler_->GetState();
+  start_ts = ClampToRetention_(state, start_ts);
+  if (start_ts > end_ts) return {};
 
-      for (auto it = it_start; it != it_end; ++it) {
-        size_t curr_idx = std::distance(ts_list.begin(), it);
+  return GetSortedTicks_(start_ts, end_ts, state,
+                         [&select](const Buffer &buffer, size_t begin, size_t end,
+                                   bool is_sorted, std::vector<Tick> &ticks) {
+    auto &mask = SelectionMask(end - begin);
+    select(TickSlice(buffer, begin, end, is_sorted), mask.data());
 
-        if (!ticks.empty() && sorted) {
-          if (ticks.back().GetTimestamp() > buffer->GetTimestamps().at(curr_idx)) {
-            sorted = false;
-          }
-        }
-        CheckAndSetTick_(ticks, curr_idx, buffer, filter);
-      }
+    for (auto i = begin; i < end; i++) {
+      if (mask[i - begin]) ticks.push_back(buffer.GetTick(i));
     }
-  }
-  return {sorted, ticks};
+  });
 }
 
-auto Database::CheckAndSetTick_(std::vector<Tick> &ticks,
-                                size_t index,
-                                const std::shared_ptr<Buffer> &buffer,
-                                const filter_func &filter) -> void {
-  auto tick = Tick(
-    buffer->GetTimestamps().at(index),
-    buffer->GetPrices().at(index),
-    buffer->GetVolumes().at(index),
-    buffer->GetSymbolIds().at(index),
-    buffer->GetExchangeIds().at(index),
-    buffer->GetTraceCondtions().at(index)
-  );
+auto Database::AggregateSelected_(uint64_t start_ts,
+                                  uint64_t end_ts,
+                                  const select_func &select) -> AggregateResult {
+
+  const auto &state = storage_handler_->GetState();
+  start_ts = ClampToRetention_(state, start_ts);
+  if (start_ts > end_ts) return {};
+
+  const auto &price_scale = storage_handler_->GetPriceScale();
+  auto accumulator = AggregateAccumulator(price_scale);
+  auto add_selected = [&select](AggregateAccumulator &accumulator, const Buffer &buffer,
+                                size_t begin, size_t end, bool is_sorted) {
+    auto &mask = SelectionMask(end - begin);
+    select(TickSlice(buffer, begin, end, is_sorted), mask.data());
+    AddSelected(accumulator, buffer, begin, end, mask.data());
+  };
+
+  auto partials = FanOutSealed_(state, start_ts, end_ts,
+                                [&price_scale, &add_selected](std::span<const BufferSlice> slices) {
+    auto partial = AggregateAccumulator(price_scale);
+    for (const auto &slice : slices) {
+      add_selected(partial, *slice.buffer, slice.begin, slice.end, true);
+    }
+    return partial;
+  });
 
-  if (filter(tick)) {
-    ticks.emplace_back(std::move(tick));
+  for (const auto &partial : partials) {
+    accumulator.Merge(partial);
   }
+
+  ForEachActiveRun_(state, start_ts, end_ts,
+                    [&accumulator, &add_selected](const Buffer &buffer, size_t begin, size_t end,
+                                                  bool is_sorted) {
+    add_selected(accumulator, buffer, begin, end, is_sorted);
+  });
+  return accumulator.ToResult();
 }
 
 auto Database::GetSortedTicks_(
   uint64_t start_ts, uint64_t end_ts,
   const std::shared_ptr<const State> &state,
-  const filter_func &filter) -> std::vector<Tick> {
+  const collect_func &collect) -> std::vector<Tick> {
 
   auto [sealed_ticks_sorted, sealed_ticks] =
-    GetTicksFromSealedBuffer_(state, start_ts, end_ts, filter);
+    GetTicksFromSealedBuffer_(state, start_ts, end_ts, collect);
 
   auto [active_ticks_sorted, active_ticks] =
-    GetTicksFromActiveBuffer_(state, start_ts, end_ts, filter);
+    GetTicksFromActiveBuffer_(state, start_ts, end_ts, collect);
 
   auto ticks = std::vector<Tick>();
   auto n = sealed_ticks.size() + active_ticks.size();
   ticks.reserve(n);
 
-  if (active_ticks_sorted && sealed_ticks_sorted) {
-    size_t i = 0, j = 0;
-    while (i < active_ticks.size() && j < sealed_ticks.size()) {
-      if (active_ticks[i].GetTimestamp() < sealed_ticks[j].GetTimestamp()) {
-        ticks.push_back(std::move(active_ticks[i]));
-        i++;
-      } else {
-        ticks.push_back(std::move(sealed_ticks[j]));
-        j++;
-      }
-    }
+  auto by_timestamp = [](const Tick &a, const Tick &b) {
+    return a.GetTimestamp() < b.GetTimestamp();
+  };
+
+  // The sealed ticks are always merged in order, only the rows of the
+  // active buffer may have to be sorted before the final two-way merge
+  if (!sealed_ticks_sorted) {
+    std::stable_sort(sealed_ticks.begin(), sealed_ticks.end(), by_timestamp);
+  }
+  if (!active_ticks_sorted) {
+    std::stable_sort(active_ticks.begin(), active_ticks.end(), by_timestamp);
+  }
 
-    while (i < active_ticks.size()) {
+  size_t i = 0, j = 0;
+  while (i < active_ticks.size() && j < sealed_ticks.size()) {
+    if (active_ticks[i].GetTimestamp() < sealed_ticks[j].GetTimestamp()) {
       ticks.push_back(std::move(active_ticks[i]));
       i++;
-    }
-
-    while (j < sealed_ticks.size()) {
+    } else {
       ticks.push_back(std::move(sealed_ticks[j]));
       j++;
     }
+  }
 
-  } else {
-    ticks.insert(
-      ticks.end(),
-      std::make_move_iterator(sealed_ticks.begin()),
-      std::make_move_iterator(sealed_ticks.end())
-    );
-
-    ticks.insert(
-      ticks.end(),
-      std::make_move_iterator(active_ticks.begin()),
-      std::make_move_iterator(active_ticks.end())
-    );
-
-    std::sort(ticks.begin(), ticks.end(), [](const Tick &a, const Tick &b) {
-      return a.GetTimestamp() < b.GetTimestamp();
-    });
+  while (i < active_ticks.size()) {
+    ticks.push_back(std::move(active_ticks[i]));
+    i++;
+  }
+
+  while (j < sealed_ticks.size()) {
+    ticks.push_back(std::move(sealed_ticks[j]));
+    j++;
   }
   return ticks;
 }
@@ -245,7 +1365,7 @@ auto Database::StartInsertThread_() noexcept -> void {
       {
         auto lock = std::unique_lock<std::mutex>(insert_thread_mutex_);
         data_added_to_buffer_.wait(lock, [&]{
-          return !data_buffer_->IsEmpty() ||
+          return !data_buffer_->IsEmpty() || !quote_buffer_->IsEmpty() ||
           stop_insert_thread_.load(std::memory_order_acquire); 
         });
       }
@@ -256,6 +1376,15 @@ auto Database::StartInsertThread_() noexcept -> void {
           std::this_thread::yield();
         }
         storage_handler_->Insert(*tick_opt);
+        UpdateSubscriptions_(*tick_opt);
+      }
+
+      if (!quote_buffer_->IsEmpty() && !stop_insert_thread_) {
+        auto quote_opt = std::optional<Quote>();
+        while (!(quote_opt = quote_buffer_->Read())) {
+          std::this_thread::yield();
+        }
+        quote_storage_handler_->Insert(*quote_opt);
       }
     }
   });
@@ -268,38 +1397,277 @@ auto Database::InsertBase_(const std::vector<Tick> &ticks) noexcept -> void {
   data_added_to_buffer_.notify_one();
 }
 
-auto Database::SetAggregateObj_(
-  AggregateResult &result,
-  const std::vector<Tick> &sorted_ticks) const noexcept -> void {
+auto Database::InsertBase_(const std::vector<Quote> &quotes) noexcept -> void {
+  for (const auto &quote : quotes) {
+    quote_buffer_->Insert(quote);
+  }
+  data_added_to_buffer_.notify_one();
+}
 
-  auto at_start = true;
+auto Database::UpdateSubscriptions_(const Tick &tick) -> void {
+  if (subscriptions_pending_.load(std::memory_order_acquire)) {
+    auto lock = std::unique_lock<std::mutex>(subscriptions_mutex_);
+    for (auto &subscription : pending_subscriptions_) {
+      subscriptions_.push_back(std::move(subscription));
+    }
+    pending_subscriptions_.clear();
+    subscriptions_pending_.store(false, std::memory_order_release);
+  }
+
+  // Only referenced from here anymore, all of its handles are gone
+  std::erase_if(subscriptions_, [](const std::shared_ptr<Subscription> &subscription) {
+    return subscription.use_count() == 1;
+  });
+
+  for (const auto &subscription : subscriptions_) {
+    subscription->Update(tick);
+  }
+}
 
-  for (const auto &tick : sorted_ticks) {
-    result.SetTotalVolume(result.GetTotalVolume() + tick.GetVolume());
-    result.SetAvgPrice(result.GetAvgPrice() + tick.GetPrice());
+auto Database::AggregateBy_(uint64_t start_ts,
+                            uint64_t end_ts,
+                            TickColumn key_column) -> std::map<uint32_t, AggregateResult> {
 
-    result.SetVwap(result.GetVwap() + (tick.GetPrice() * tick.GetVolume()));
+  const auto &state = storage_handler_->GetState();
+  start_ts = ClampToRetention_(state, start_ts);
+  if (start_ts > end_ts) return {};
 
-    if (at_start) {
-      result.SetMinPrice(tick.GetPrice());
-      result.SetMaxPrice(tick.GetPrice());
-      at_start = false;
+  // Every group of buffers fills a table of its own, merged afterwards
+  const auto &price_scale = storage_handler_->GetPriceScale();
+  auto partials = FanOutSealed_(state, start_ts, end_ts,
+                                [&price_scale, key_column](std::span<const BufferSlice> slices) {
+    auto partial = GroupAccumulator(price_scale);
+    for (const auto &slice : slices) {
+      AddGroupColumns(partial, *slice.buffer, key_column, slice.begin, slice.end);
+    }
+    return partial;
+  });
 
+  auto groups = std::move(partials.front());
+  for (size_t i = 1; i < partials.size(); i++) {
+    groups.Merge(partials[i]);
+  }
+
+  ForEachActiveRun_(state, start_ts, end_ts,
+                    [&groups, key_column](const Buffer &buffer, size_t begin, size_t end, bool) {
+    AddGroupColumns(groups, buffer, key_column, begin, end);
+  });
+  return groups.ToResults();
+}
+
+auto Database::Bars_(uint64_t start_ts,
+                     uint64_t end_ts,
+                     uint64_t interval,
+                     std::optional<uint32_t> symbol_id) -> std::vector<Bar> {
+
+  // The buckets stay aligned to the requested start, even if the
+  // retention cuts off the beginning of the range
+  const auto origin_ts = start_ts;
+  const auto &state = storage_handler_->GetState();
+  start_ts = ClampToRetention_(state, start_ts);
+  if (interval == 0 || start_ts > end_ts) return {};
+
+  const auto last_bucket = (end_ts - origin_ts) / interval;
+  const auto empty_bucket = BarBucket{AggregateAccumulator(storage_handler_->GetPriceScale())};
+
+  // Short ranges index the buckets directly, long (and mostly empty)
+  // ones only hold the buckets that are hit.
+  auto dense_buckets = std::vector<BarBucket>{};
+  auto sparse_buckets = std::map<uint64_t, BarBucket>{};
+  auto is_dense = last_bucket < kMAX_DENSE_BAR_BUCKETS;
+  if (is_dense) dense_buckets.assign(last_bucket + 1, empty_bucket);
+
+  auto get_bucket = [&](uint64_t index) -> BarBucket & {
+    if (is_dense) return dense_buckets[index];
+    return sparse_buckets.try_emplace(index, empty_bucket).first->second;
+  };
+
+  ForEachSlice_(state, start_ts, end_ts,
+                [&](const Buffer &buffer, size_t begin, size_t end, bool sorted) {
+    const auto &ts_list = buffer.GetTimestamps();
+
+    if (symbol_id || !sorted) {
+      const auto &symbol_ids = buffer.GetSymbolIds();
+      for (auto i = begin; i < end; i++) {
+        if (symbol_id && symbol_ids[i] != *symbol_id) continue;
+        AddToBar(get_bucket((ts_list[i] - origin_ts) / interval), buffer, i, i + 1, i, i);
+      }
+      return;
+    }
+
+    // Sorted rows, every bucket is a contiguous run added column-wise
+    for (auto i = begin; i < end;) {
+      auto index = (ts_list[i] - origin_ts) / interval;
+      auto run_end = end;
+
+      if (index < last_bucket) {
+        auto next_ts = origin_ts + (index + 1) * interval;
+        run_end = std::lower_bound(ts_list.begin() + i, ts_list.begin() + end, next_ts)
+                  - ts_list.begin();
+      }
+
+      AddToBar(get_bucket(index), buffer, i, run_end, i, run_end - 1);
+      i = run_end;
+    }
+  });
+
+  auto bars = std::vector<Bar>{};
+  if (is_dense) {
+    for (uint64_t index = 0; index < dense_buckets.size(); index++) {
+      if (dense_buckets[index].accumulator.GetCount() == 0) continue;
+      bars.push_back(ToBar(dense_buckets[index], origin_ts + index * interval));
+    }
+  } else {
+    bars.reserve(sparse_buckets.size());
+    for (const auto &[index, bucket] : sparse_buckets) {
+      bars.push_back(ToBar(bucket, origin_ts + index * interval));
+    }
+  }
+  return bars;
+}
+
+auto Database::CountDistinct_(uint64_t start_ts,
+                              uint64_t end_ts,
+                              TickColumn key_column,
+                              std::optional<uint32_t> exchange_id) -> size_t {
+
+  const auto &state = storage_handler_->GetState();
+  start_ts = ClampToRetention_(state, start_ts);
+  if (start_ts > end_ts) return 0;
+
+  auto partials = FanOutSealed_(state, start_ts, end_ts, [exchange_id](std::span<const BufferSlice> slices) {
+    auto partial = DistinctSketches{};
+    for (const auto &slice : slices) {
+      AddToDistinct(partial, *slice.buffer, slice.begin, slice.end, exchange_id, true);
+    }
+    return partial;
+  });
+
+  auto sketches = DistinctSketches{};
+  for (const auto &partial : partials) {
+    sketches.symbols.Merge(partial.symbols);
+    sketches.exchanges.Merge(partial.exchanges);
+  }
+
+  ForEachActiveRun_(state, start_ts, end_ts,
+                    [&sketches, exchange_id](const Buffer &buffer, size_t begin, size_t end, bool) {
+    AddToDistinct(sketches, buffer, begin, end, exchange_id, false);
+  });
+
+  const auto &result = key_column == TickColumn::kExchangeId ? sketches.exchanges : sketches.symbols;
+  return size_t(result.Count());
+}
+
+auto Database::Rolling_(uint64_t start_ts,
+                        uint64_t end_ts,
+                        uint64_t window,
+                        RollingMetric metrics,
+                        std::optional<uint32_t> symbol_id) -> RollingSeries {
+
+  auto series = RollingSeries(metrics);
+  const auto &state = storage_handler_->GetState();
+
+  // The window of the first point reaches back before the start of the range
+  auto warm_up_ts = ClampToRetention_(state, start_ts >= window ? start_ts - window : 0);
+  if (std::max(warm_up_ts, start_ts) > end_ts) return series;
+
+  auto sources = GetRowSources_(state, warm_up_ts, end_ts);
+  auto cursors = std::vector<size_t>{};
+  for (const auto &source : sources) {
+    cursors.push_back(source.low);
+  }
+
+  auto sliding_window = SlidingWindow(window, storage_handler_->GetPriceScale());
+  auto ema = 0.0;
+  auto ema_ts = std::optional<uint64_t>();
+
+  ForEachRowInOrder_(sources, cursors, false, [&](const Buffer &buffer, size_t row) {
+    if (symbol_id && buffer.GetSymbolIds()[row] != *symbol_id) return true;
+
+    auto ts = buffer.GetTimestamps()[row];
+    auto price = GetPrice(buffer, row);
+    sliding_window.Add(ts, price, buffer.GetVolumes()[row]);
+
+    // Every tick counts as at least one timestamp after the previous one
+    if (!ema_ts || window == 0) {
+      ema = price;
     } else {
-      result.SetMaxPrice(std::max(result.GetMaxPrice(), tick.GetPrice()));
-      result.SetMinPrice(std::min(result.GetMinPrice(), tick.GetPrice()));
+      auto elapsed = double(std::max<uint64_t>(ts - *ema_ts, 1));
+      ema += (1.0 - std::exp(-elapsed / double(window))) * (price - ema);
     }
+    ema_ts = ts;
 
-    result.SetCount(result.GetCount() + 1);
+    if (ts >= start_ts) series.Append_(ts, sliding_window, ema);
+    return true;
+  });
+  return series;
+}
+
+auto Database::GetSortedQuotes_(
+  uint64_t start_ts, uint64_t end_ts,
+  const std::shared_ptr<const QuoteState> &state,
+  const quote_filter_func &filter) -> std::vector<Quote> {
+
+  auto quotes = std::vector<Quote>{};
+
+  // Merged from the ordered row sources, which read the active buffer up
+  // to the size published with the state only
+  auto sources = GetRowSources_(state, start_ts, end_ts);
+  auto cursors = std::vector<size_t>{};
+  for (const auto &source : sources) {
+    cursors.push_back(source.low);
   }
 
-  if (result.GetCount() > 0) {
-    result.SetAvgPrice(result.GetAvgPrice() / result.GetCount());
+  ForEachRowInOrder_(sources, cursors, false, [&](const QuoteBuffer &buffer, size_t row) {
+    auto quote = Quote(buffer.GetRecord(row));
+    if (filter(quote)) quotes.emplace_back(std::move(quote));
+    return true;
+  });
+  return quotes;
+}
+
+auto Database::SetQuoteAggregateObj_(
+  QuoteAggregateResult &result,
+  const std::vector<Quote> &sorted_quotes) const noexcept -> void {
+
+  if (sorted_quotes.empty()) return;
+
+  auto min_spread = sorted_quotes.front().GetSpread();
+  auto max_spread = min_spread;
+  auto spread_sum = 0.0;
 
-    if (result.GetTotalVolume() > 0) {
-      result.SetVwap(result.GetVwap() / result.GetTotalVolume());
+  // Every quote is in force until the next one arrives, the last quote
+  // of the range has no known end and therefore carries no weight.
+  auto weighted_spread_sum = 0.0;
+  uint64_t duration = 0;
+
+  for (size_t i = 0; i < sorted_quotes.size(); i++) {
+    auto spread = sorted_quotes[i].GetSpread();
+
+    min_spread = std::min(min_spread, spread);
+    max_spread = std::max(max_spread, spread);
+    spread_sum += spread;
+
+    if (i + 1 < sorted_quotes.size()) {
+      auto in_force = sorted_quotes[i + 1].GetTimestamp() - sorted_quotes[i].GetTimestamp();
+      weighted_spread_sum += spread * in_force;
+      duration += in_force;
     }
   }
+
+  auto avg_spread = spread_sum / sorted_quotes.size();
+  auto time_weighted_spread = duration > 0 ? weighted_spread_sum / duration : avg_spread;
+
+  result = QuoteAggregateResult(sorted_quotes.size(), max_spread, min_spread,
+                                avg_spread, time_weighted_spread);
+}
+
+auto Database::GetRetainedQuote_(std::optional<Quote> &&quote) const noexcept
+  -> std::optional<Quote> {
+  // The cache keeps evicted quotes too, only the expired ones are hidden
+  auto horizon = quote_storage_handler_->GetState()->GetRetentionHorizon();
+  if (quote && quote->GetTimestamp() < horizon) return std::nullopt;
+  return std::move(quote);
 }
 
 }
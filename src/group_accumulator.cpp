@@ -0,0 +1,114 @@
+#include "headers/group_accumulator.hpp"
+#include "headers/constants.hpp"
+#include "../include/bolt/aggregate_result.hpp"
+
+#include <bit>
+#include <utility>
+
+namespace bolt {
+
+GroupAccumulator::GroupAccumulator(const PriceScale &price_scale)
+  : price_scale_(price_scale) {}
+
+auto GroupAccumulator::Add(std::span<const uint32_t> keys,
+                           std::span<const double> prices,
+                           std::span<const uint32_t> volumes) -> void {
+  // Rows of the same key tend to come in runs, the last lookup is reused
+  AggregateAccumulator *accumulator = nullptr;
+  uint32_t last_key = 0;
+
+  for (size_t i = 0; i < keys.size(); i++) {
+    if (!accumulator || keys[i] != last_key) {
+      accumulator = &Find_(keys[i]);
+      last_key = keys[i];
+    }
+    accumulator->Add(prices[i], volumes[i]);
+  }
+}
+
+auto GroupAccumulator::AddFixed(std::span<const uint32_t> keys,
+                                std::span<const int64_t> price_ticks,
+                                std::span<const uint32_t> volumes) -> void {
+  AggregateAccumulator *accumulator = nullptr;
+  uint32_t last_key = 0;
+
+  for (size_t i = 0; i < keys.size(); i++) {
+    if (!accumulator || keys[i] != last_key) {
+      accumulator = &Find_(keys[i]);
+      last_key = keys[i];
+    }
+    accumulator->AddFixed(price_ticks[i], volumes[i]);
+  }
+}
+
+auto GroupAccumulator::Merge(const GroupAccumulator &other) -> void {
+  for (size_t slot = 0; slot < other.keys_.size(); slot++) {
+    if (other.occupied_[slot]) {
+      Find_(other.keys_[slot]).Merge(other.accumulators_[slot]);
+    }
+  }
+}
+
+auto GroupAccumulator::Size() const noexcept -> size_t {
+  return size_;
+}
+
+auto GroupAccumulator::ToResults() const -> std::map<uint32_t, AggregateResult> {
+  auto results = std::map<uint32_t, AggregateResult>{};
+  for (size_t slot = 0; slot < keys_.size(); slot++) {
+    if (occupied_[slot]) {
+      results.emplace(keys_[slot], accumulators_[slot].ToResult());
+    }
+  }
+  return results;
+}
+
+auto GroupAccumulator::Find_(uint32_t key) -> AggregateAccumulator & {
+  if (keys_.empty()) Grow_();
+
+  auto mask = keys_.size() - 1;
+  auto slot = HomeSlot_(key, keys_.size());
+
+  while (occupied_[slot]) {
+    if (keys_[slot] == key) return accumulators_[slot];
+    slot = (slot + 1) & mask;
+  }
+
+  // Kept at most half full, the probe sequences stay short. Only a new key
+  // grows the table, it is then probed for again in the grown one.
+  if (2 * (size_ + 1) > keys_.size()) {
+    Grow_();
+    return Find_(key);
+  }
+
+  keys_[slot] = key;
+  occupied_[slot] = true;
+  accumulators_[slot] = AggregateAccumulator(price_scale_);
+  size_++;
+  return accumulators_[slot];
+}
+
+auto GroupAccumulator::HomeSlot_(uint32_t key, size_t capacity) noexcept -> size_t {
+  // Multiplicative (Fibonacci) hashing in 64 bits, the slot is taken from the
+  // high bits of the product, which depend on all the bits of the key. The
+  // low bits do not, keys sharing their low bits (e.g. multiples of the
+  // capacity) would otherwise all collide.
+  auto shift = 64 - std::countr_zero(capacity);
+  return size_t((uint64_t(key) * 0x9E3779B97F4A7C15ull) >> shift);
+}
+
+auto GroupAccumulator::Grow_() -> void {
+  auto capacity = keys_.empty()
+    ? size_t(Constants::kGROUP_TABLE_INITIAL_CAPACITY) : 2 * keys_.size();
+
+  auto keys = std::exchange(keys_, std::vector<uint32_t>(capacity));
+  auto occupied = std::exchange(occupied_, std::vector<bool>(capacity));
+  auto accumulators = std::exchange(accumulators_, std::vector<AggregateAccumulator>(capacity));
+  size_ = 0;
+
+  for (size_t slot = 0; slot < keys.size(); slot++) {
+    if (occupied[slot]) Find_(keys[slot]) = std::move(accumulators[slot]);
+  }
+}
+
+}
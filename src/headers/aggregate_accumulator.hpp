@@ -0,0 +1,76 @@
+#pragma once
+
+#include "../../include/bolt/macros.hpp"
+#include "price_scale.hpp"
+#include "kernels.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace bolt {
+
+class AggregateResult;
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef __int128 wide_int;
+#else
+// Without a native 128-bit integer the fixed-point sums are not exact anymore
+typedef long double wide_int;
+#endif
+
+class AggregateAccumulator {
+  TEST_FRIEND(AggregateAccumulatorTest);
+
+public:
+  AggregateAccumulator() = default;
+  explicit AggregateAccumulator(const PriceScale &price_scale);
+
+  auto Add(double price, uint32_t volume) noexcept -> void;
+  auto AddFixed(int64_t price_ticks, uint32_t volume) noexcept -> void;
+
+  // Takes back a row added before, for the sliding windows. The sums are
+  // updated (exactly with a fixed-point scale) but the min and max prices
+  // can not be, they are left as they are.
+  auto Remove(double price, uint32_t volume) noexcept -> void;
+
+  // Column-wise variants, the spans hold one row per index
+  auto Add(std::span<const double> prices,
+           std::span<const uint32_t> volumes) noexcept -> void;
+
+  auto AddFixed(std::span<const int64_t> price_ticks,
+                std::span<const uint32_t> volumes) noexcept -> void;
+
+  // Adds only the rows whose timestamp lies within the (inclusive) range
+  auto AddInRange(std::span<const uint64_t> timestamps,
+                  std::span<const double> prices,
+                  std::span<const uint32_t> volumes,
+                  uint64_t start_ts,
+                  uint64_t end_ts) noexcept -> void;
+
+  // Combines the rows added to another accumulator (of the same price scale)
+  auto Merge(const AggregateAccumulator &other) noexcept -> void;
+
+  auto GetCount() const noexcept -> size_t;
+  auto ToResult() const noexcept -> AggregateResult;
+
+private:
+  PriceScale price_scale_;
+
+  size_t count_ {};
+  uint64_t total_volume_ {};
+
+  double price_sum_ {};
+  double weighted_price_sum_ {};
+  double min_price_ {};
+  double max_price_ {};
+
+  wide_int price_ticks_sum_ {};
+  wide_int weighted_price_ticks_sum_ {};
+  int64_t min_price_ticks_ {};
+  int64_t max_price_ticks_ {};
+
+  auto AddSums_(const kernels::ColumnSums &sums) noexcept -> void;
+  auto ExactQuotient_(wide_int numerator, uint64_t denominator) const noexcept -> double;
+};
+
+}
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "../../include/bolt/macros.hpp"
+#include "../../include/bolt/schema.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace bolt {
+
+// Columnar storage generated from a compile-time schema, one vector per column.
+// The Tick 'Buffer' keeps its own hand written layout, since it additionally
+// supports the fixed-point price encoding.
+template <typename SchemaType>
+class BasicBuffer {
+  TEST_FRIEND(BasicBufferTest);
+
+public:
+  using schema = SchemaType;
+  using record = Record<SchemaType>;
+
+  template <typename T>
+  using list_cref = const std::vector<T> &;
+
+  template <typename Tag>
+  using type_of = typename SchemaType::template type_of<Tag>;
+
+  BasicBuffer() = default;
+
+  explicit BasicBuffer(size_t reserve_capacity) {
+    ForEachColumn_([reserve_capacity](auto &column) {
+      column.reserve(reserve_capacity);
+    });
+  }
+
+  explicit BasicBuffer(const std::vector<record> &records) {
+    for (const auto &record : records) {
+      InsertRecord(record);
+    }
+  }
+
+  auto operator==(const BasicBuffer &other) const noexcept -> bool {
+    return columns_ == other.columns_;
+  }
+
+  auto operator!=(const BasicBuffer &other) const noexcept -> bool {
+    return columns_ != other.columns_;
+  }
+
+  template <typename Tag>
+  auto Get() const noexcept -> list_cref<type_of<Tag>> {
+    return std::get<SchemaType::template IndexOf<Tag>>(columns_);
+  }
+
+  auto GetTimestamps() const noexcept -> list_cref<uint64_t> {
+    return std::get<0>(columns_);
+  }
+
+  auto GetRecord(size_t index) const noexcept -> record {
+    return std::apply([index](const auto &...columns) {
+      return record(typename SchemaType::row_type(columns[index]...));
+    }, columns_);
+  }
+
+  auto InsertRecord(const record &record) noexcept -> void {
+    UpdateIsSorted_(record.GetTimestamp());
+
+    AppendRow_(record.GetRow(),
+               std::make_index_sequence<SchemaType::kColumnCount>{});
+  }
+
+  auto InsertRow(const BasicBuffer &other, size_t index) noexcept -> void {
+    UpdateIsSorted_(other.GetTimestamps()[index]);
+
+    AppendFrom_(other, index,
+                std::make_index_sequence<SchemaType::kColumnCount>{});
+  }
+
+  auto Size() const noexcept -> size_t {
+    return GetTimestamps().size();
+  }
+
+  auto MemoryUsage() const noexcept -> size_t {
+    auto usage = sizeof(BasicBuffer);
+    std::apply([&usage](const auto &...columns) {
+      ((usage += columns.capacity() * sizeof(typename std::decay_t<decltype(columns)>::value_type)), ...);
+    }, columns_);
+    return usage;
+  }
+
+  auto Sort(bool ascending = true) noexcept -> void {
+    *this = SortedCopy(ascending);
+  }
+
+  auto SortedCopy(bool ascending = true) const -> BasicBuffer {
+    const auto &timestamps = GetTimestamps();
+
+    auto indices = std::vector<size_t>(timestamps.size());
+    std::iota(indices.begin(), indices.end(), 0);
+
+    std::stable_sort(indices.begin(), indices.end(), [&](size_t a, size_t b) {
+      return ascending ? timestamps[a] < timestamps[b] : timestamps[a] > timestamps[b];
+    });
+
+    auto sorted = BasicBuffer(indices.size());
+    for (const auto &index : indices) {
+      sorted.AppendFrom_(*this, index,
+                         std::make_index_sequence<SchemaType::kColumnCount>{});
+    }
+    sorted.is_sorted_ = ascending || Size() < 2;
+    return sorted;
+  }
+
+  auto IsSorted() const noexcept -> bool {
+    return is_sorted_;
+  }
+
+  auto Copy() const noexcept -> BasicBuffer {
+    return {*this};
+  }
+
+  // Returns the (inclusive) time range sorted by the timestamps
+  auto GetForRange(uint64_t start_ts, uint64_t end_ts) const -> std::vector<record> {
+    const auto &timestamps = GetTimestamps();
+    auto records = std::vector<record>{};
+
+    if (is_sorted_) {
+      auto it_start = std::lower_bound(timestamps.begin(), timestamps.end(), start_ts);
+      auto it_end = std::upper_bound(it_start, timestamps.end(), end_ts);
+
+      records.reserve(std::distance(it_start, it_end));
+      for (auto it = it_start; it != it_end; ++it) {
+        records.push_back(GetRecord(std::distance(timestamps.begin(), it)));
+      }
+      return records;
+    }
+
+    for (size_t i = 0; i < timestamps.size(); i++) {
+      if (timestamps[i] >= start_ts && timestamps[i] <= end_ts) {
+        records.push_back(GetRecord(i));
+      }
+    }
+
+    std::stable_sort(records.begin(), records.end(), [](const record &a, const record &b) {
+      return a.GetTimestamp() < b.GetTimestamp();
+    });
+    return records;
+  }
+
+private:
+  typename SchemaType::storage_type columns_;
+  bool is_sorted_ {true};
+
+  template <typename Func>
+  auto ForEachColumn_(Func &&func) noexcept -> void {
+    std::apply([&func](auto &...columns) { (func(columns), ...); }, columns_);
+  }
+
+  auto UpdateIsSorted_(uint64_t timestamp) noexcept -> void {
+    if (is_sorted_ && !GetTimestamps().empty() && GetTimestamps().back() > timestamp) {
+      is_sorted_ = false;
+    }
+  }
+
+  template <size_t ...Index>
+  auto AppendRow_(const typename SchemaType::row_type &row,
+                  std::index_sequence<Index...>) noexcept -> void {
+    (std::get<Index>(columns_).push_back(std::get<Index>(row)), ...);
+  }
+
+  template <size_t ...Index>
+  auto AppendFrom_(const BasicBuffer &other, size_t index,
+                   std::index_sequence<Index...>) noexcept -> void {
+    (std::get<Index>(columns_).push_back(std::get<Index>(other.columns_)[index]), ...);
+  }
+};
+
+}
@@ -1,8 +1,15 @@
 #pragma once
 
 #include <vector>
+#include <cstddef>
 #include "../../include/bolt/trade_conditions.hpp"
 #include "../../include/bolt/macros.hpp"
+#include "price_scale.hpp"
+#include "aggregate_accumulator.hpp"
+#include "zone_map.hpp"
+#include "quantile_sketch.hpp"
+#include "hyper_log_log.hpp"
+#include <optional>
 
 namespace bolt {
 
@@ -15,9 +22,16 @@ public:
   template <typename T>
   using list_cref = const std::vector<T> &;
 
+  // The distinct symbols traded on an exchange
+  struct ExchangeSymbols {
+    uint32_t exchange_id;
+    HyperLogLog symbols;
+  };
+
   Buffer() = default;
 
   Buffer(size_t reserve_capacity);
+  Buffer(size_t reserve_capacity, const PriceScale &price_scale);
   Buffer(const std::vector<Tick> &ticks);
 
   Buffer(const Buffer &other);
@@ -34,27 +48,66 @@ public:
   auto GetExchangeIds() const noexcept -> list_cref<uint32_t>;
 
   auto GetPrices() const noexcept -> list_cref<double>;
+  auto GetPriceTicks() const noexcept -> list_cref<int64_t>;
   auto GetVolumes() const noexcept -> list_cref<uint32_t>;
   auto GetTraceCondtions() const noexcept -> list_cref<TradeConditions>;
 
+  auto GetPriceScale() const noexcept -> const PriceScale &;
+  auto GetPrice(size_t index) const noexcept -> double;
+
+  auto GetTick(size_t index) const noexcept -> Tick;
   auto InsertTick(const Tick &tick) noexcept -> void;
+  auto InsertRow(const Buffer &other, size_t index) noexcept -> void;
 
   auto Size() const noexcept -> size_t;
+  auto MemoryUsage() const noexcept -> size_t;
   auto Sort(bool ascending = true) noexcept -> void;
+  auto SortedCopy(bool ascending = true) const -> Buffer;
   auto Copy() const noexcept -> Buffer;
 
   auto IsSorted() const noexcept -> bool;
 
+  // The aggregate and the zone map of all the rows and of every block of
+  // kSUMMARY_BLOCK_SIZE rows, the quantile sketches of the prices and
+  // volumes and the distinct symbols of every exchange (sorted by exchange
+  // id), computed once when the buffer is sealed. Appending a row afterwards
+  // discards them again.
+  auto ComputeSummary() noexcept -> void;
+  auto GetSummary() const noexcept -> const std::optional<AggregateAccumulator> &;
+  auto GetBlockSummaries() const noexcept -> list_cref<AggregateAccumulator>;
+  auto GetZoneMap() const noexcept -> const std::optional<ZoneMap> &;
+  auto GetBlockZoneMaps() const noexcept -> list_cref<ZoneMap>;
+  auto GetPriceSketch() const noexcept -> const std::optional<QuantileSketch> &;
+  auto GetVolumeSketch() const noexcept -> const std::optional<QuantileSketch> &;
+  auto GetSymbolSketches() const noexcept -> const std::optional<std::vector<ExchangeSymbols>> &;
+
+  // Aggregates the rows [begin, end), using the block summaries where possible
+  auto Summarize(size_t begin, size_t end) const noexcept -> AggregateAccumulator;
+
 private:
   std::vector<uint64_t> timestamps_;
   std::vector<uint32_t> symbol_ids_;
   std::vector<uint32_t> exchange_ids_;
   std::vector<double> prices_;
+  std::vector<int64_t> price_ticks_;
   std::vector<uint32_t> volumes_;
   std::vector<TradeConditions> trace_conditions_;
 
+  // With a fixed-point scale the prices are stored as integer ticks
+  // in 'price_ticks_' and 'prices_' stays empty.
+  PriceScale price_scale_;
+
   uint64_t size_ {};
   bool is_sorted_ {true};
+  std::optional<AggregateAccumulator> summary_;
+  std::vector<AggregateAccumulator> block_summaries_;
+  std::optional<ZoneMap> zone_map_;
+  std::vector<ZoneMap> block_zone_maps_;
+  std::optional<QuantileSketch> price_sketch_;
+  std::optional<QuantileSketch> volume_sketch_;
+  std::optional<std::vector<ExchangeSymbols>> symbol_sketches_;
+
+  auto AddRows_(AggregateAccumulator &accumulator, size_t begin, size_t end) const noexcept -> void;
 
   auto StoreData_(const std::vector<Tick> &ticks) noexcept -> void;
   auto EqualityCheck_(const Buffer &other) const noexcept -> bool;
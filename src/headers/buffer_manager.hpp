@@ -1,7 +1,19 @@
 #pragma once
 
 #include "../../include/bolt/macros.hpp"
+#include "../../include/bolt/config.hpp"
+#include "../../include/bolt/schema.hpp"
+#include "price_scale.hpp"
+#include "rollup.hpp"
+#include "last_value_cache.hpp"
+#include "raw_buffer.hpp"
+#include <atomic>
+#include <condition_variable>
 #include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <type_traits>
+#include <variant>
 #include <deque>
 #include <memory>
 #include <vector>
@@ -10,41 +22,155 @@ namespace bolt {
 
 class Buffer;
 class Tick;
+class Quote;
 class ThreadPool;
-class State;
 
-class BufferManager {
+template <typename SchemaType>
+class BasicBuffer;
+
+template <typename BufferType>
+class BasicState;
+
+// Owns the buffers of one table (e.g. ticks or quotes), seals, expires,
+// evicts and compacts them and publishes the resulting states.
+template <typename BufferType, typename RecordType>
+class BasicBufferManager {
   TEST_FRIEND(BufferManagerTest);
   TEST_FRIEND(DatabaseTest);
+  TEST_FRIEND(TableTest);
 
 public:
   template <typename T>
   using ptr = std::shared_ptr<T>;
 
-  using const_buffer = ptr<Buffer>;
+  using const_buffer = ptr<BufferType>;
   using sealed_list = std::deque<const_buffer>;
+  using state_type = BasicState<BufferType>;
+
+  // The latest record per symbol (and exchange) is kept for the ticks and
+  // the quotes, the tables of user defined schemas have no symbols
+  using last_value_cache = std::conditional_t<std::is_same_v<RecordType, RawRecord>,
+                                              std::monostate,
+                                              BasicLastValueCache<RecordType>>;
+
+  BasicBufferManager(ThreadPool &pool, const Config &config = Config());
+
+  // The tables of user defined schemas name the widths of their columns
+  BasicBufferManager(ThreadPool &pool, const Config &config, const RawLayout &layout);
+
+  BasicBufferManager(const BasicBufferManager &other) = delete;
+  auto operator=(const BasicBufferManager &other) -> BasicBufferManager & = delete;
 
-  BufferManager(ThreadPool &pool);
+  ~BasicBufferManager();
 
-  auto Insert(const std::vector<Tick> &ticks) noexcept -> void;
-  auto Insert(const Tick &tick) noexcept -> void;
+  auto Insert(const std::vector<RecordType> &records) noexcept -> void;
+  auto Insert(const RecordType &record) noexcept -> void;
 
-  auto GetState() const noexcept -> std::shared_ptr<const State>;
+  auto GetState() const noexcept -> std::shared_ptr<const state_type>;
+  auto MemoryUsage() const noexcept -> size_t;
+  auto GetPriceScale() const noexcept -> const PriceScale &;
+
+  // Evicts down to the new budget right away, e.g. once a part of it is given to another table
+  auto SetMemoryBudget(size_t memory_budget) noexcept -> void;
+
+  auto GetLastValues() const noexcept -> const last_value_cache &;
 
 private:
-  int32_t maximum_sealed_buffers_;
+  size_t memory_budget_;
+  size_t sealed_memory_usage_ {};
+  uint64_t retention_period_;
+  uint64_t expiry_interval_;
+  uint64_t earliest_sealed_expiry_ {};
   int32_t maximum_buffer_size_;
+  PriceScale price_scale_;
+  RawLayout layout_;
   mutable std::mutex background_mutex_;
 
   ThreadPool &pool_;
 
   ptr<sealed_list> sealed_buffers_;
+  Rollup rollup_;
+
+  // Touched by the insert thread only. The buffer and its size are handed to
+  // the background tasks, the latest handed over ones are published with the
+  // states (guarded by 'background_mutex_').
+  ptr<BufferType> active_buffer_;
+  uint64_t insert_sequence_ {};
+
+  ptr<BufferType> published_active_;
+  size_t published_active_size_ {};
+  uint64_t published_sequence_ {};
+
+  std::atomic<ptr<const state_type>> current_state_;
+  std::atomic<size_t> memory_usage_ {};
+  std::atomic<uint64_t> latest_timestamp_ {};
+
+  // When the latest record was ingested (steady clock, in nanoseconds),
+  // only kept while the expiry task is enabled.
+  std::atomic<int64_t> latest_ingest_time_ {};
 
-  ptr<Buffer> active_buffer_;
-  std::atomic<ptr<const State>> current_state_;
+  // Shared with the tasks assigned to the pool, they run under a shared lock
+  // and are skipped once the manager is being destroyed.
+  struct TaskGuard {
+    std::shared_mutex mutex;
+    bool alive {true};
+  };
+  ptr<TaskGuard> task_guard_;
 
-  auto InsertBase_(const Tick &tick) noexcept -> void;
-  auto SetNewState_(ptr<Buffer> &&new_sealed_buffer) noexcept -> void;
+  // Assigns an expiry task to the pool every 'expiry_interval_' milliseconds
+  std::thread expiry_thread_;
+  std::mutex expiry_mutex_;
+  std::condition_variable expiry_condition_;
+  bool stop_expiry_ {};
+  std::atomic<bool> compaction_running_ {false};
+  std::atomic<bool> compaction_pending_ {false};
+
+  last_value_cache last_values_;
+
+  auto InsertBase_(const RecordType &record) noexcept -> void;
+
+  template <typename TaskType>
+  auto AssignTask_(TaskType &&task) noexcept -> void;
+  auto MakeBuffer_(size_t reserve_capacity) const -> ptr<BufferType>;
+  auto AppendToActive_(const RecordType &record) noexcept -> void;
+  auto UpdateLastValues_(const RecordType &record) noexcept -> void;
+  auto SealBuffer_(BufferType &buffer) const noexcept -> void;
+
+  auto PushToRollup_(const Rollup &rollup, const BufferType &buffer) const -> Rollup;
+  auto RebuildRollup_(const sealed_list &sealed_buffers) const -> Rollup;
+
+  // Without an active buffer the one published last is kept, an older
+  // handover (lower sequence) than the published one is ignored.
+  auto SetNewState_(ptr<BufferType> &&new_sealed_buffer,
+                    ptr<BufferType> active_buffer = nullptr,
+                    size_t active_size = 0,
+                    uint64_t sequence = 0) noexcept -> void;
+  auto PublishState_(uint64_t horizon) noexcept -> void;
+  auto EvictToBudget_(sealed_list &sealed_buffers,
+                      size_t active_memory_usage) noexcept -> void;
+
+  auto GetRetentionHorizon_() const noexcept -> uint64_t;
+  auto ExpireBuffers_(sealed_list &sealed_buffers, uint64_t horizon) noexcept -> void;
+  auto UpdateEarliestExpiry_() noexcept -> void;
+  auto RunExpiryTimer_() noexcept -> void;
+
+  auto ScheduleCompaction_() noexcept -> void;
+  auto Compact_() noexcept -> void;
+
+  auto FindCompactionRun_(const sealed_list &sealed_buffers) const noexcept
+    -> std::pair<size_t, size_t>;
+
+  auto MergeBuffers_(const std::vector<const_buffer> &buffers) const
+    -> std::vector<const_buffer>;
+
+  auto SwapCompactedBuffers_(const std::vector<const_buffer> &sources,
+                             std::vector<const_buffer> &&merged) noexcept -> bool;
 };
 
+using QuoteBuffer = BasicBuffer<QuoteSchema>;
+
+using BufferManager = BasicBufferManager<Buffer, Tick>;
+using QuoteBufferManager = BasicBufferManager<QuoteBuffer, Quote>;
+using RawBufferManager = BasicBufferManager<RawBuffer, RawRecord>;
+
 }
@@ -2,8 +2,20 @@
 #include <cstdint>
 
 namespace Constants {
-  static constexpr int16_t kMAXIMUM_SEALED_BUFFERS = 100;
+  static constexpr uint64_t kDEFAULT_MEMORY_BUDGET = 64ULL * 1024 * 1024;
+  static constexpr double kDEFAULT_QUOTE_MEMORY_SHARE = 0.25;
+  static constexpr double kDEFAULT_TABLE_MEMORY_SHARE = 0.1;
   static constexpr int16_t kMAXIMUM_SEALED_BUFFER_SIZE = 10000;
   static constexpr int32_t kRING_BUFFER_SIZE = 64000;
   static constexpr int32_t kMINIMUM_THREADS = 3;
+  static constexpr uint64_t kDEFAULT_PARALLEL_QUERY_THRESHOLD = 200000;
+  static constexpr uint32_t kSUMMARY_BLOCK_SIZE = 256;
+  static constexpr uint64_t kMAX_DENSE_BAR_BUCKETS = 65536;
+  static constexpr uint32_t kGROUP_TABLE_INITIAL_CAPACITY = 16;
+  static constexpr uint32_t kPREDICATE_SET_SCAN_LIMIT = 8;
+  static constexpr uint32_t kPAGE_RESERVE_LIMIT = 65536;
+  static constexpr uint32_t kLAST_VALUE_INITIAL_CAPACITY = 64;
+  static constexpr uint32_t kQUANTILE_SKETCH_K = 200;
+  static constexpr uint32_t kHYPER_LOG_LOG_PRECISION = 12;
+  static constexpr uint32_t kSLIDING_WINDOW_REBUILD_INTERVAL = 4096;
 }
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "../../include/bolt/macros.hpp"
+#include "aggregate_accumulator.hpp"
+#include "price_scale.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <span>
+#include <vector>
+
+namespace bolt {
+
+class AggregateResult;
+
+// An AggregateAccumulator per key (symbol or exchange id), kept in an open
+// addressing table with linear probing. The slots are flat arrays, so adding
+// a row costs a multiplication and (almost always) a single probe.
+class GroupAccumulator {
+  TEST_FRIEND(GroupAccumulatorTest);
+
+public:
+  GroupAccumulator() = default;
+  explicit GroupAccumulator(const PriceScale &price_scale);
+
+  // Column-wise, the spans hold one row per index
+  auto Add(std::span<const uint32_t> keys,
+           std::span<const double> prices,
+           std::span<const uint32_t> volumes) -> void;
+
+  auto AddFixed(std::span<const uint32_t> keys,
+                std::span<const int64_t> price_ticks,
+                std::span<const uint32_t> volumes) -> void;
+
+  // Combines the groups of another accumulator (of the same price scale)
+  auto Merge(const GroupAccumulator &other) -> void;
+
+  // The number of distinct keys added
+  auto Size() const noexcept -> size_t;
+
+  auto ToResults() const -> std::map<uint32_t, AggregateResult>;
+
+private:
+  PriceScale price_scale_;
+
+  std::vector<uint32_t> keys_;
+  std::vector<bool> occupied_;
+  std::vector<AggregateAccumulator> accumulators_;
+  size_t size_ {};
+
+  // The accumulator of the key, inserted if missing. Invalidates the
+  // references returned before when the table grows.
+  auto Find_(uint32_t key) -> AggregateAccumulator &;
+
+  // The first slot probed for the key, in a table of a power of two capacity
+  static auto HomeSlot_(uint32_t key, size_t capacity) noexcept -> size_t;
+  auto Grow_() -> void;
+};
+
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "../../include/bolt/macros.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace bolt {
+
+// A HyperLogLog sketch of a set of ids (symbols, exchanges), estimating its
+// cardinality with a standard error of 1.04 / sqrt(2^p), about 1.6%, and
+// mergeable with the sketches of other sets.
+//
+// Small sets are kept exactly as the sorted list of their ids, switched to the
+// 2^p registers once the list would take more memory than them. The few
+// hundred symbols of a buffer are therefore counted exactly, and only large
+// unions are estimated.
+class HyperLogLog {
+  TEST_FRIEND(HyperLogLogTest);
+
+public:
+  HyperLogLog() = default;
+
+  auto Add(uint32_t id) -> void;
+  auto Merge(const HyperLogLog &other) -> void;
+
+  // The (estimated) number of distinct ids added
+  auto Count() const noexcept -> uint64_t;
+
+  auto MemoryUsage() const noexcept -> size_t;
+
+private:
+  // Sorted and unique, while 'registers_' is empty
+  std::vector<uint32_t> ids_;
+  std::vector<uint8_t> registers_;
+
+  auto IsDense_() const noexcept -> bool;
+  auto Densify_() -> void;
+  auto AddToRegisters_(uint32_t id) noexcept -> void;
+};
+
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace bolt::kernels {
+
+// Vectorized reductions over the price and volume columns. The AVX2 versions
+// are selected at runtime when the CPU supports them, every kernel has a
+// scalar fallback producing the same result (up to the summation order).
+
+enum class InstructionSet : uint8_t {
+  kScalar,
+  kAvx2
+};
+
+struct ColumnSums {
+  size_t count {};
+  uint64_t total_volume {};
+  double price_sum {};
+  double weighted_price_sum {};
+  double min_price {};
+  double max_price {};
+};
+
+// The best instruction set supported by the current CPU, detected once.
+auto GetInstructionSet() noexcept -> InstructionSet;
+
+// Count, sum, min, max and sum(price * volume) of all the rows.
+auto SumColumns(std::span<const double> prices,
+                std::span<const uint32_t> volumes,
+                InstructionSet instruction_set = GetInstructionSet()) noexcept -> ColumnSums;
+
+// Same as SumColumns, restricted to the rows whose timestamp lies within the
+// (inclusive) range. Used for the buffers that are only partially in range
+// and can not be narrowed down with a binary search.
+auto SumColumnsInRange(std::span<const uint64_t> timestamps,
+                       std::span<const double> prices,
+                       std::span<const uint32_t> volumes,
+                       uint64_t start_ts,
+                       uint64_t end_ts,
+                       InstructionSet instruction_set = GetInstructionSet()) noexcept -> ColumnSums;
+
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "../../include/bolt/macros.hpp"
+#include "seqlock.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace bolt {
+
+class Tick;
+class Quote;
+
+// The latest record (highest timestamp) of every symbol and of every
+// (symbol, exchange) pair, kept for the ticks and the quotes. Updated by the
+// single insert thread and read without any lock: every entry is a Seqlock,
+// and the tables are open addressing arrays which are never freed while in
+// use (a grown table replaces the published one, the old ones are kept until
+// destruction, together at most as large as the last).
+template <typename RecordType>
+class BasicLastValueCache {
+  TEST_FRIEND(LastValueCacheTest);
+
+public:
+  BasicLastValueCache();
+
+  BasicLastValueCache(const BasicLastValueCache &) = delete;
+  auto operator=(const BasicLastValueCache &) -> BasicLastValueCache & = delete;
+
+  // Must only be called from a single (the insert) thread
+  auto Update(const RecordType &record) -> void;
+
+  auto Get(uint32_t symbol_id) const noexcept -> std::optional<RecordType>;
+  auto Get(uint32_t symbol_id, uint32_t exchange_id) const noexcept
+    -> std::optional<RecordType>;
+
+  // The number of distinct symbols seen
+  auto Size() const noexcept -> size_t;
+
+private:
+  // A tick is stored as four words: timestamp, price bits, volume | condition
+  // and symbol | exchange. A quote as five: timestamp, bid price bits, ask
+  // price bits, bid size | ask size and symbol | exchange.
+  static constexpr size_t kWords = std::is_same_v<RecordType, Tick> ? 4 : 5;
+  using words = typename Seqlock<kWords>::words;
+
+  struct Entry {
+    // key + 1, 0 for a free slot, published once the values are written
+    std::atomic<uint64_t> key {};
+    Seqlock<kWords> values;
+  };
+
+  struct Table {
+    explicit Table(size_t capacity);
+
+    std::unique_ptr<Entry[]> entries;
+    size_t capacity;
+    std::atomic<size_t> size {};
+  };
+
+  // Owned by the writer, the published one is the last
+  std::vector<std::unique_ptr<Table>> symbol_tables_;
+  std::vector<std::unique_ptr<Table>> pair_tables_;
+
+  std::atomic<Table *> by_symbol_;
+  std::atomic<Table *> by_pair_;
+
+  static auto ToWords_(const RecordType &record) noexcept -> words;
+  static auto FromWords_(const words &values) noexcept -> RecordType;
+
+  static auto Update_(std::vector<std::unique_ptr<Table>> &tables,
+                      std::atomic<Table *> &published,
+                      uint64_t key, const words &values) -> void;
+
+  static auto Get_(const std::atomic<Table *> &published, uint64_t key) noexcept
+    -> std::optional<RecordType>;
+
+  static auto Grow_(std::vector<std::unique_ptr<Table>> &tables,
+                    std::atomic<Table *> &published) -> void;
+};
+
+using LastValueCache = BasicLastValueCache<Tick>;
+using QuoteLastValueCache = BasicLastValueCache<Quote>;
+
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "../../include/bolt/macros.hpp"
+#include "../../include/bolt/predicate.hpp"
+#include "buffer.hpp"
+#include "constants.hpp"
+#include "zone_map.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace bolt {
+
+// Evaluates a Predicate over the columns of a Buffer: every term becomes a
+// loop over one column writing a selection mask (a byte per row), the masks
+// of AND / OR are combined bitwise. The zone maps of sealed buffers decide
+// beforehand which blocks can be skipped or taken as a whole.
+class PredicateEvaluator {
+  TEST_FRIEND(PredicateEvaluatorTest);
+
+public:
+  enum class ZoneMatch : uint8_t {
+    kNone,
+    kSome,
+    kAll
+  };
+
+  explicit PredicateEvaluator(const Predicate &predicate);
+
+  // Whether none, some or all of the rows of a zone map can match
+  auto Check(const ZoneMap &zone_map) const noexcept -> ZoneMatch;
+
+  // Sets mask[i] to 1 if the row (begin + i) matches, to 0 otherwise
+  auto Select(const Buffer &buffer, size_t begin, size_t end,
+              std::vector<uint8_t> &mask) const -> void;
+
+  // Calls func(begin, end, mask) for the parts of the rows [begin, end) that
+  // can match, mask being the selection of those rows or nullptr if all of
+  // them match.
+  template <typename Func>
+  auto ForEachMatch(const Buffer &buffer, size_t begin, size_t end, Func &&func) const -> void;
+
+private:
+  using Node = Predicate::Node;
+  using Kind = Predicate::Kind;
+
+  std::shared_ptr<const Node> node_;
+
+  static auto Check_(const Node &node, const ZoneMap &zone_map) noexcept -> ZoneMatch;
+  static auto Select_(const Node &node, const Buffer &buffer,
+                      size_t begin, size_t end, uint8_t *mask) -> void;
+};
+
+template <typename Func>
+auto PredicateEvaluator::ForEachMatch(const Buffer &buffer, size_t begin, size_t end,
+                                      Func &&func) const -> void {
+  auto mask = std::vector<uint8_t>{};
+  const auto &zone_map = buffer.GetZoneMap();
+
+  auto match = zone_map ? Check(*zone_map) : ZoneMatch::kSome;
+  if (match == ZoneMatch::kNone) return;
+
+  if (match == ZoneMatch::kAll) {
+    func(begin, end, static_cast<const uint8_t *>(nullptr));
+    return;
+  }
+
+  if (!zone_map) {
+    Select(buffer, begin, end, mask);
+    func(begin, end, static_cast<const uint8_t *>(mask.data()));
+    return;
+  }
+
+  const auto &block_zone_maps = buffer.GetBlockZoneMaps();
+  for (auto block = begin / Constants::kSUMMARY_BLOCK_SIZE;
+       block < block_zone_maps.size() && block * Constants::kSUMMARY_BLOCK_SIZE < end;
+       block++) {
+
+    auto block_begin = std::max<size_t>(begin, block * Constants::kSUMMARY_BLOCK_SIZE);
+    auto block_end = std::min<size_t>(end, (block + 1) * Constants::kSUMMARY_BLOCK_SIZE);
+
+    switch (Check(block_zone_maps[block])) {
+      case ZoneMatch::kNone:
+        break;
+      case ZoneMatch::kAll:
+        func(block_begin, block_end, static_cast<const uint8_t *>(nullptr));
+        break;
+      case ZoneMatch::kSome:
+        Select(buffer, block_begin, block_end, mask);
+        func(block_begin, block_end, static_cast<const uint8_t *>(mask.data()));
+        break;
+    }
+  }
+}
+
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "../../include/bolt/macros.hpp"
+#include <cmath>
+#include <cstdint>
+
+namespace bolt {
+
+class PriceScale {
+  TEST_FRIEND(PriceScaleTest);
+
+public:
+  PriceScale() = default;
+  explicit PriceScale(double scale);
+
+  auto operator==(const PriceScale &other) const noexcept -> bool;
+  auto operator!=(const PriceScale &other) const noexcept -> bool;
+
+  auto IsFixedPoint() const noexcept -> bool;
+  auto GetScale() const noexcept -> double;
+  auto GetTicksPerUnit() const noexcept -> double;
+
+  // Conversions are used once per row, hence defined inline.
+  auto ToTicks(double price) const noexcept -> int64_t {
+    return std::llround(price * ticks_per_unit_);
+  }
+
+  auto ToPrice(int64_t price_ticks) const noexcept -> double {
+    // Dividing by the (integral) number of ticks per unit is exact where
+    // multiplying by the scale is not, e.g. 1000123 * 1e-4 != 100.0123
+    return double(price_ticks) / ticks_per_unit_;
+  }
+
+  auto ToPrice(double price_ticks) const noexcept -> double {
+    return price_ticks / ticks_per_unit_;
+  }
+
+private:
+  double scale_ {};
+  double ticks_per_unit_ {1.0};
+};
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "../../include/bolt/macros.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace bolt {
+
+// A KLL sketch of a stream of values, answering quantile queries with a rank
+// error of about 1% in O(k) space, and mergeable with the sketches of other
+// streams (e.g. of the other buffers of a range).
+//
+// Level h holds values standing for 2^h values each. Once the sketch holds
+// more values than its capacity, the lowest full level is sorted and every
+// other value of it is promoted to the next level, the lower levels having
+// geometrically (2/3) smaller capacities. Which half is promoted alternates,
+// so the sketch of a given stream is deterministic. Until the first
+// compaction (k values) the quantiles are exact.
+class QuantileSketch {
+  TEST_FRIEND(QuantileSketchTest);
+
+public:
+  QuantileSketch() = default;
+
+  auto Add(double value) -> void;
+  auto Merge(const QuantileSketch &other) -> void;
+
+  // The number of values added (and merged)
+  auto Count() const noexcept -> uint64_t;
+
+  // The value of rank q * Count() for every q in [0, 1], 0 for an empty sketch
+  auto Quantiles(std::span<const double> qs) const -> std::vector<double>;
+
+  auto MemoryUsage() const noexcept -> size_t;
+
+private:
+  std::vector<std::vector<double>> levels_;
+  uint64_t count_ {};
+  size_t size_ {};
+  double min_ {};
+  double max_ {};
+  bool promote_odd_ {};
+
+  // Sum of the level capacities, changes only with the number of levels
+  size_t total_capacity_ {};
+
+  auto Capacity_(size_t level) const noexcept -> size_t;
+  auto AddLevels_(size_t levels) -> void;
+  auto Compress_() -> void;
+};
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "../../include/bolt/macros.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace bolt {
+
+// The byte widths of the columns of a row, the first one is the timestamp
+using RawLayout = std::shared_ptr<const std::vector<size_t>>;
+
+// A serialized row (see Schema::Serialize) handed to a RawBuffer
+class RawRecord {
+public:
+  explicit RawRecord(const char *data) noexcept;
+
+  auto GetTimestamp() const noexcept -> uint64_t;
+  auto GetData() const noexcept -> const char *;
+
+private:
+  const char *data_;
+};
+
+// Columnar storage of the rows of a schema only known at runtime (by its
+// column widths), it backs the Table objects of user defined schemas.
+// Columns are kept as packed bytes, one vector per column.
+class RawBuffer {
+  TEST_FRIEND(RawBufferTest);
+
+public:
+  RawBuffer() = default;
+  explicit RawBuffer(const RawLayout &layout, size_t reserve_capacity = 0);
+
+  auto operator==(const RawBuffer &other) const noexcept -> bool;
+  auto operator!=(const RawBuffer &other) const noexcept -> bool;
+
+  auto InsertRecord(const RawRecord &record) noexcept -> void;
+  auto InsertRow(const RawBuffer &other, size_t index) noexcept -> void;
+
+  auto GetTimestamps() const noexcept -> const std::vector<uint64_t> &;
+  auto GetLayout() const noexcept -> const RawLayout &;
+  auto GetRowSize() const noexcept -> size_t;
+
+  // Serializes the row into 'buffer' (of at least GetRowSize() bytes)
+  auto GetRow(size_t index, char *buffer) const noexcept -> void;
+
+  // The bytes of one value of the column, of its width in the layout
+  auto GetValue(size_t column, size_t index) const noexcept -> const char *;
+
+  auto Size() const noexcept -> size_t;
+  auto MemoryUsage() const noexcept -> size_t;
+
+  auto IsSorted() const noexcept -> bool;
+  auto Copy() const noexcept -> RawBuffer;
+  auto SortedCopy() const -> RawBuffer;
+
+  // Row positions [begin, end) holding the (inclusive) time range, only for sorted buffers
+  auto GetRange(uint64_t start_ts, uint64_t end_ts) const noexcept -> std::pair<size_t, size_t>;
+
+private:
+  RawLayout layout_;
+  std::vector<uint64_t> timestamps_;
+  std::vector<std::vector<char>> columns_;
+  bool is_sorted_ {true};
+
+  auto UpdateIsSorted_(uint64_t timestamp) noexcept -> void;
+};
+
+}
@@ -7,24 +7,29 @@
 namespace bolt {
 
 class Tick;
+class Quote;
 
-class RingBuffer {
+template <typename RecordType>
+class BasicRingBuffer {
   TEST_FRIEND(RingBufferTest);
 
 public:
-  RingBuffer();
+  BasicRingBuffer();
 
-  auto Insert(const Tick &tick) noexcept -> bool;
-  auto Read() noexcept -> std::optional<Tick>;
+  auto Insert(const RecordType &record) noexcept -> bool;
+  auto Read() noexcept -> std::optional<RecordType>;
 
   auto IsEmpty() const noexcept -> bool;
   auto IsFull() const noexcept -> bool;
 
 private:
-  std::vector<Tick> buffer_;
+  std::vector<RecordType> buffer_;
   size_t ring_buffer_size_;
 
   std::atomic<uint64_t> reader_, writer_;
 };
 
+using RingBuffer = BasicRingBuffer<Tick>;
+using QuoteRingBuffer = BasicRingBuffer<Quote>;
+
 }
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "../../include/bolt/macros.hpp"
+#include "aggregate_accumulator.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace bolt {
+
+// Segment tree over the summaries of the sealed buffers, a leaf per buffer in
+// the order of the sealed list. The tree is persistent: every modification
+// returns a new tree sharing the untouched nodes, so the copy published with a
+// State never changes and appending or dropping a buffer costs O(log n).
+class Rollup {
+  TEST_FRIEND(RollupTest);
+
+public:
+  Rollup() = default;
+
+  // Appends a leaf for a buffer holding the timestamps [front_ts, back_ts]
+  auto PushBack(const AggregateAccumulator &summary,
+                uint64_t front_ts,
+                uint64_t back_ts) const -> Rollup;
+
+  auto PopFront() const -> Rollup;
+
+  // The merged summaries of the leaves [begin, end)
+  auto Query(size_t begin, size_t end) const noexcept -> AggregateAccumulator;
+
+  auto Size() const noexcept -> size_t;
+
+  // Whether no buffer starts before its predecessor ends, i.e. the buffers
+  // entirely inside a time range are consecutive leaves.
+  auto IsOrdered() const noexcept -> bool;
+
+private:
+  struct Node {
+    AggregateAccumulator summary;
+    std::shared_ptr<const Node> left;
+    std::shared_ptr<const Node> right;
+  };
+
+  using node_ptr = std::shared_ptr<const Node>;
+
+  node_ptr root_;
+
+  // The leaves are slots [0, capacity_), the live ones are [begin_, end_)
+  size_t capacity_ {};
+  size_t begin_ {};
+  size_t end_ {};
+
+  uint64_t back_ts_ {};
+  bool is_ordered_ {true};
+
+  static auto Set_(const node_ptr &node, size_t low, size_t high,
+                   size_t slot, const AggregateAccumulator *summary) -> node_ptr;
+
+  static auto Query_(const node_ptr &node, size_t low, size_t high,
+                     size_t begin, size_t end, AggregateAccumulator &result) noexcept -> void;
+};
+
+}
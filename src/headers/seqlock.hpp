@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace bolt {
+
+// N words written by a single thread and read by any number of threads
+// without locking. The sequence is odd while a write is in progress, a
+// reader retries until it has read all the words between two equal (even)
+// sequence values. The words themselves are relaxed atomics, so a torn
+// read is discarded instead of being a data race.
+template <size_t N>
+class Seqlock {
+public:
+  using words = std::array<uint64_t, N>;
+
+  auto Store(const words &values) noexcept -> void {
+    auto sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (size_t i = 0; i < N; i++) {
+      values_[i].store(values[i], std::memory_order_relaxed);
+    }
+    sequence_.store(sequence + 2, std::memory_order_release);
+  }
+
+  auto Load() const noexcept -> words {
+    auto values = words{};
+    while (true) {
+      auto before = sequence_.load(std::memory_order_acquire);
+      if (before & 1) continue;
+
+      for (size_t i = 0; i < N; i++) {
+        values[i] = values_[i].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (sequence_.load(std::memory_order_relaxed) == before) return values;
+    }
+  }
+
+  // A single word, only for the writing thread itself
+  auto Peek(size_t index) const noexcept -> uint64_t {
+    return values_[index].load(std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<uint32_t> sequence_ {};
+  std::array<std::atomic<uint64_t>, N> values_ {};
+};
+
+}
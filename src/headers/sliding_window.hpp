@@ -0,0 +1,82 @@
+#pragma once
+
+#include "../../include/bolt/macros.hpp"
+#include "aggregate_accumulator.hpp"
+#include "price_scale.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <utility>
+
+namespace bolt {
+
+class AggregateResult;
+
+// The rows of the last 'length' timestamps of a stream, i.e. [latest - length,
+// latest], with their aggregate values kept up to date. Adding a row and
+// retiring the ones which fell out of the window cost amortized O(1): the
+// sums are kept by an AggregateAccumulator and the min and max prices are
+// the fronts of two monotonic deques.
+//
+// Subtracting the retired rows from the double sums accumulates rounding
+// errors, the sums are therefore recomputed from the rows of the window once
+// at least as many rows were retired as it holds (and at least a fixed number),
+// which keeps the cost amortized O(1).
+//
+// Rows are retired in the order they were added, a row arriving out of order
+// stays until the rows added before it are retired, a row arriving already
+// before the start of the window is ignored.
+class SlidingWindow {
+  TEST_FRIEND(SlidingWindowTest);
+
+public:
+  SlidingWindow(uint64_t length, const PriceScale &price_scale);
+
+  auto Add(uint64_t timestamp, double price, uint32_t volume) -> void;
+
+  // Moves the end of the window to latest_ts (if later) and retires the rows
+  // before its start
+  auto Slide(uint64_t latest_ts) -> void;
+
+  auto Size() const noexcept -> size_t;
+  auto GetLength() const noexcept -> uint64_t;
+  auto ToResult() const noexcept -> AggregateResult;
+
+  // The (population) standard deviation of the prices in the window
+  auto GetStdDev() const noexcept -> double;
+
+private:
+  struct Row {
+    uint64_t timestamp;
+    double price;
+    uint32_t volume;
+  };
+
+  // (row number, price), row numbers count all the rows ever added
+  using candidate = std::pair<uint64_t, double>;
+
+  uint64_t length_;
+  uint64_t latest_ts_ {};
+  PriceScale price_scale_;
+
+  AggregateAccumulator accumulator_;
+  std::deque<Row> rows_;
+  std::deque<candidate> min_prices_;
+  std::deque<candidate> max_prices_;
+
+  uint64_t added_ {};
+  uint64_t retired_ {};
+  uint64_t retired_since_rebuild_ {};
+
+  // Sums of the deviations from the first price of the window (as of the last
+  // rebuild), which keeps the variance from cancelling out for prices far
+  // away from zero
+  double reference_price_ {};
+  double deviation_sum_ {};
+  double squared_deviation_sum_ {};
+
+  auto GetStart_() const noexcept -> uint64_t;
+  auto RebuildSums_() noexcept -> void;
+};
+
+}
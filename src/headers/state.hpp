@@ -1,46 +1,79 @@
 #pragma once
 
 #include "../../include/bolt/macros.hpp"
+#include "../../include/bolt/schema.hpp"
+#include "rollup.hpp"
+#include "raw_buffer.hpp"
+#include <cstdint>
 #include <deque>
+#include <limits>
 #include <memory>
 
 namespace bolt {
 
 class Buffer;
 
-class State {
+template <typename SchemaType>
+class BasicBuffer;
+
+// A consistent snapshot of one table, i.e. its active and sealed buffers
+template <typename BufferType>
+class BasicState {
   TEST_FRIEND(StateTest);
 
 public:
   template <typename T>
   using ptr = std::shared_ptr<T>;
 
-  using buffer = ptr<Buffer>;
+  using buffer = ptr<BufferType>;
   using sealed_list = std::deque<buffer>;
 
-  State();
-  State(ptr<Buffer> active_buffer,
-        const ptr<sealed_list> &sealed_buffers);
+  BasicState();
+  BasicState(ptr<BufferType> active_buffer,
+        const ptr<sealed_list> &sealed_buffers,
+        uint64_t retention_horizon = 0,
+        size_t active_size = std::numeric_limits<size_t>::max(),
+        const Rollup &rollup = Rollup());
 
-  State(const State &other);
-  State(State &&other) noexcept;
+  BasicState(const BasicState &other);
+  BasicState(BasicState &&other) noexcept;
 
-  auto operator=(const State &other) -> State &;
-  auto operator=(State &&other) noexcept -> State &;
+  auto operator=(const BasicState &other) -> BasicState &;
+  auto operator=(BasicState &&other) noexcept -> BasicState &;
 
-  auto operator==(const State &other) const -> bool;
-  auto operator!=(const State &other) const -> bool;
+  auto operator==(const BasicState &other) const -> bool;
+  auto operator!=(const BasicState &other) const -> bool;
 
   auto GetSealedBuffers() const noexcept -> const ptr<const sealed_list> &;
-  auto GetActiveBuffer() const noexcept -> const ptr<Buffer> &;
+  auto GetActiveBuffer() const noexcept -> const ptr<BufferType> &;
+  auto GetRetentionHorizon() const noexcept -> uint64_t;
+
+  // The number of active buffer rows published with this state, rows
+  // appended afterwards may still be written to and are not part of it.
+  // Without a published size the state takes all the rows the buffer holds
+  // when it is constructed, the buffer is never read for it afterwards.
+  auto GetActiveSize() const noexcept -> size_t;
+
+  // The summaries of the sealed buffers, only valid (and used) when it
+  // holds a leaf for each of them.
+  auto GetRollup() const noexcept -> const Rollup &;
 
 private:
   ptr<const sealed_list> sealed_buffers_;
-  ptr<Buffer> active_buffer_;
+  ptr<BufferType> active_buffer_;
+  uint64_t retention_horizon_ {};
+  size_t active_size_ {};
+  Rollup rollup_;
 
-  auto CopyFrom_(const State &other) -> void;
-  auto MoveFrom_(State &&other) noexcept -> void;
-  auto EqualityCheck_(const State &other) const -> bool;
+  auto CopyFrom_(const BasicState &other) -> void;
+  auto MoveFrom_(BasicState &&other) noexcept -> void;
+  auto EqualityCheck_(const BasicState &other) const -> bool;
 };
 
+using QuoteBuffer = BasicBuffer<QuoteSchema>;
+
+using State = BasicState<Buffer>;
+using QuoteState = BasicState<QuoteBuffer>;
+using RawState = BasicState<RawBuffer>;
+
 }
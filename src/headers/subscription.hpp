@@ -0,0 +1,46 @@
+#pragma once
+
+#include "../../include/bolt/macros.hpp"
+#include "../../include/bolt/predicate.hpp"
+#include "../../include/bolt/continuous_query.hpp"
+#include "price_scale.hpp"
+#include "seqlock.hpp"
+#include "sliding_window.hpp"
+#include <cstdint>
+
+namespace bolt {
+
+class Tick;
+class AggregateResult;
+
+// The state behind a ContinuousQuery: the aggregate values of the ticks
+// matching a predicate within a sliding window ending at the latest ingested
+// timestamp. Updated by the insert thread tick by tick, the values are
+// published through a Seqlock so that reading them never blocks the ingestion.
+class Subscription {
+  TEST_FRIEND(SubscriptionTest);
+
+public:
+  Subscription(uint64_t window,
+               const Predicate &predicate,
+               const PriceScale &price_scale,
+               ContinuousQuery::callback_func callback);
+
+  // Must only be called from a single (the insert) thread
+  auto Update(const Tick &tick) -> void;
+
+  auto GetResult() const noexcept -> AggregateResult;
+  auto GetWindow() const noexcept -> uint64_t;
+
+private:
+  Predicate predicate_;
+  ContinuousQuery::callback_func callback_;
+  SlidingWindow window_;
+
+  // count, total volume and the bits of the avg, vwap, min and max prices
+  Seqlock<6> result_;
+
+  auto Publish_() -> void;
+};
+
+}
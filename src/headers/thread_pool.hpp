@@ -41,6 +41,11 @@ public:
     return future_obj;
   }
 
+  auto GetThreadCount() const noexcept -> size_t;
+
+  // The tasks assigned but not yet taken by a worker
+  auto GetQueuedTaskCount() const noexcept -> size_t;
+
   auto Restart() noexcept -> void;
   auto Shutdown() noexcept -> void;
 
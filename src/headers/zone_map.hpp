@@ -0,0 +1,34 @@
+#pragma once
+
+#include "../../include/bolt/trade_conditions.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace bolt {
+
+// A bit per TradeConditions value (all of them are below 64)
+inline auto GetConditionBit(TradeConditions condition) noexcept -> uint64_t {
+  return uint64_t(1) << (uint8_t(condition) & 63);
+}
+
+// The value ranges of a block of rows, used to skip the blocks
+// a predicate can not match (or has to match entirely).
+struct ZoneMap {
+  size_t count {};
+  uint32_t min_symbol_id {};
+  uint32_t max_symbol_id {};
+  uint32_t min_exchange_id {};
+  uint32_t max_exchange_id {};
+  uint32_t min_volume {};
+  uint32_t max_volume {};
+  double min_price {};
+  double max_price {};
+  uint64_t conditions {};  // the bits of the conditions present
+
+  auto Add(uint32_t symbol_id, uint32_t exchange_id, double price,
+           uint32_t volume, TradeConditions condition) noexcept -> void;
+
+  auto Merge(const ZoneMap &other) noexcept -> void;
+};
+
+}
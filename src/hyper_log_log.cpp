@@ -0,0 +1,113 @@
+#include "headers/hyper_log_log.hpp"
+#include "headers/constants.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <iterator>
+
+namespace bolt {
+
+namespace {
+
+constexpr uint32_t kPrecision = Constants::kHYPER_LOG_LOG_PRECISION;
+constexpr size_t kRegisters = size_t(1) << kPrecision;
+
+// The ids list switches to the registers past the same memory
+constexpr size_t kSparseLimit = kRegisters / sizeof(uint32_t);
+
+// The splitmix64 finalizer, spreads consecutive ids over all the bits
+auto Hash(uint32_t id) noexcept -> uint64_t {
+  auto hash = uint64_t(id) + 0x9E3779B97F4A7C15ull;
+  hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+  hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+  return hash ^ (hash >> 31);
+}
+
+}
+
+auto HyperLogLog::Add(uint32_t id) -> void {
+  if (IsDense_()) {
+    AddToRegisters_(id);
+    return;
+  }
+
+  auto it = std::lower_bound(ids_.begin(), ids_.end(), id);
+  if (it != ids_.end() && *it == id) return;
+
+  ids_.insert(it, id);
+  if (ids_.size() > kSparseLimit) Densify_();
+}
+
+auto HyperLogLog::Merge(const HyperLogLog &other) -> void {
+  if (!other.IsDense_()) {
+    if (IsDense_()) {
+      for (auto id : other.ids_) AddToRegisters_(id);
+      return;
+    }
+
+    auto merged = std::vector<uint32_t>{};
+    merged.reserve(ids_.size() + other.ids_.size());
+    std::set_union(ids_.begin(), ids_.end(), other.ids_.begin(), other.ids_.end(),
+                   std::back_inserter(merged));
+    ids_ = std::move(merged);
+    if (ids_.size() > kSparseLimit) Densify_();
+    return;
+  }
+
+  if (!IsDense_()) Densify_();
+  for (size_t i = 0; i < kRegisters; i++) {
+    registers_[i] = std::max(registers_[i], other.registers_[i]);
+  }
+}
+
+auto HyperLogLog::Count() const noexcept -> uint64_t {
+  if (!IsDense_()) return ids_.size();
+
+  auto sum = 0.0;
+  size_t zeros = 0;
+  for (auto value : registers_) {
+    sum += std::ldexp(1.0, -int(value));
+    zeros += value == 0;
+  }
+
+  const auto m = double(kRegisters);
+  auto alpha = 0.7213 / (1.0 + 1.079 / m);
+  auto estimate = alpha * m * m / sum;
+
+  // Linear counting is more accurate for the small cardinalities
+  if (estimate <= 2.5 * m && zeros > 0) {
+    estimate = m * std::log(m / double(zeros));
+  }
+  return uint64_t(std::llround(estimate));
+}
+
+auto HyperLogLog::MemoryUsage() const noexcept -> size_t {
+  return sizeof(HyperLogLog) + ids_.capacity() * sizeof(uint32_t) + registers_.capacity();
+}
+
+auto HyperLogLog::IsDense_() const noexcept -> bool {
+  return !registers_.empty();
+}
+
+auto HyperLogLog::Densify_() -> void {
+  registers_.assign(kRegisters, 0);
+  for (auto id : ids_) AddToRegisters_(id);
+
+  ids_.clear();
+  ids_.shrink_to_fit();
+}
+
+auto HyperLogLog::AddToRegisters_(uint32_t id) noexcept -> void {
+  auto hash = Hash(id);
+  auto index = hash >> (64 - kPrecision);
+
+  // The position of the first set bit of the remaining bits, the guard bit
+  // caps it when they are all zero
+  auto rest = (hash << kPrecision) | (uint64_t(1) << (kPrecision - 1));
+  auto rank = uint8_t(std::countl_zero(rest) + 1);
+
+  registers_[index] = std::max(registers_[index], rank);
+}
+
+}
@@ -0,0 +1,228 @@
+#include "headers/kernels.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define BOLT_AVX2_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace bolt::kernels {
+
+namespace {
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+auto DetectInstructionSet() noexcept -> InstructionSet {
+#ifdef BOLT_AVX2_KERNELS
+  if (__builtin_cpu_supports("avx2")) return InstructionSet::kAvx2;
+#endif
+  return InstructionSet::kScalar;
+}
+
+auto AddRow(ColumnSums &sums, double price, uint32_t volume) noexcept -> void {
+  sums.min_price = std::min(sums.min_price, price);
+  sums.max_price = std::max(sums.max_price, price);
+  sums.price_sum += price;
+  sums.weighted_price_sum += price * volume;
+  sums.total_volume += volume;
+  sums.count++;
+}
+
+auto EmptySums() noexcept -> ColumnSums {
+  auto sums = ColumnSums{};
+  sums.min_price = kInfinity;
+  sums.max_price = -kInfinity;
+  return sums;
+}
+
+auto SumColumnsScalar(const double *prices, const uint32_t *volumes,
+                      size_t size) noexcept -> ColumnSums {
+  auto sums = EmptySums();
+  for (size_t i = 0; i < size; i++) {
+    AddRow(sums, prices[i], volumes[i]);
+  }
+  return sums;
+}
+
+auto SumColumnsInRangeScalar(const uint64_t *timestamps,
+                             const double *prices, const uint32_t *volumes,
+                             size_t size, uint64_t start_ts, uint64_t end_ts) noexcept -> ColumnSums {
+  auto sums = EmptySums();
+  for (size_t i = 0; i < size; i++) {
+    if (timestamps[i] >= start_ts && timestamps[i] <= end_ts) {
+      AddRow(sums, prices[i], volumes[i]);
+    }
+  }
+  return sums;
+}
+
+#ifdef BOLT_AVX2_KERNELS
+
+// Four rows per iteration, one lane per row. The lanes are reduced once at
+// the end and the remaining (size % 4) rows are added by the scalar loop.
+struct Avx2Lanes {
+  __m256d price_sum;
+  __m256d weighted_price_sum;
+  __m256d min_price;
+  __m256d max_price;
+  __m256i total_volume;
+};
+
+__attribute__((target("avx2")))
+auto InitLanes() noexcept -> Avx2Lanes {
+  return {
+    _mm256_setzero_pd(), _mm256_setzero_pd(),
+    _mm256_set1_pd(kInfinity), _mm256_set1_pd(-kInfinity),
+    _mm256_setzero_si256()
+  };
+}
+
+// AVX2 has no unsigned conversions, the volumes are converted as signed
+// integers with the sign bit flipped and shifted back by 2^31 (exact).
+__attribute__((target("avx2")))
+auto LoadVolumes(const uint32_t *volumes, __m256d &as_double) noexcept -> __m256i {
+  auto packed = _mm_loadu_si128(reinterpret_cast<const __m128i *>(volumes));
+  auto flipped = _mm_xor_si128(packed, _mm_set1_epi32(std::numeric_limits<int32_t>::min()));
+
+  as_double = _mm256_add_pd(_mm256_cvtepi32_pd(flipped), _mm256_set1_pd(2147483648.0));
+  return _mm256_cvtepu32_epi64(packed);
+}
+
+__attribute__((target("avx2")))
+auto ReduceLanes(const Avx2Lanes &lanes, ColumnSums &sums) noexcept -> void {
+  alignas(32) double price_sum[4], weighted_price_sum[4], min_price[4], max_price[4];
+  alignas(32) uint64_t total_volume[4];
+
+  _mm256_store_pd(price_sum, lanes.price_sum);
+  _mm256_store_pd(weighted_price_sum, lanes.weighted_price_sum);
+  _mm256_store_pd(min_price, lanes.min_price);
+  _mm256_store_pd(max_price, lanes.max_price);
+  _mm256_store_si256(reinterpret_cast<__m256i *>(total_volume), lanes.total_volume);
+
+  for (size_t lane = 0; lane < 4; lane++) {
+    sums.price_sum += price_sum[lane];
+    sums.weighted_price_sum += weighted_price_sum[lane];
+    sums.min_price = std::min(sums.min_price, min_price[lane]);
+    sums.max_price = std::max(sums.max_price, max_price[lane]);
+    sums.total_volume += total_volume[lane];
+  }
+}
+
+__attribute__((target("avx2")))
+auto SumColumnsAvx2(const double *prices, const uint32_t *volumes,
+                    size_t size) noexcept -> ColumnSums {
+  auto lanes = InitLanes();
+  auto vector_size = size - (size % 4);
+
+  for (size_t i = 0; i < vector_size; i += 4) {
+    auto price = _mm256_loadu_pd(prices + i);
+    auto volume_double = _mm256_setzero_pd();
+    auto volume = LoadVolumes(volumes + i, volume_double);
+
+    lanes.price_sum = _mm256_add_pd(lanes.price_sum, price);
+    lanes.weighted_price_sum = _mm256_add_pd(lanes.weighted_price_sum,
+                                             _mm256_mul_pd(price, volume_double));
+    lanes.min_price = _mm256_min_pd(lanes.min_price, price);
+    lanes.max_price = _mm256_max_pd(lanes.max_price, price);
+    lanes.total_volume = _mm256_add_epi64(lanes.total_volume, volume);
+  }
+
+  auto sums = SumColumnsScalar(prices + vector_size, volumes + vector_size,
+                               size - vector_size);
+  ReduceLanes(lanes, sums);
+  sums.count += vector_size;
+  return sums;
+}
+
+__attribute__((target("avx2")))
+auto SumColumnsInRangeAvx2(const uint64_t *timestamps,
+                           const double *prices, const uint32_t *volumes,
+                           size_t size, uint64_t start_ts, uint64_t end_ts) noexcept -> ColumnSums {
+  auto lanes = InitLanes();
+  auto vector_size = size - (size % 4);
+  size_t count = 0;
+
+  // Only signed 64-bit comparisons exist, flipping the sign bit of both
+  // sides turns them into the unsigned ones
+  const auto sign = _mm256_set1_epi64x(std::numeric_limits<int64_t>::min());
+  const auto start = _mm256_xor_si256(_mm256_set1_epi64x(int64_t(start_ts)), sign);
+  const auto end = _mm256_xor_si256(_mm256_set1_epi64x(int64_t(end_ts)), sign);
+
+  for (size_t i = 0; i < vector_size; i += 4) {
+    auto ts = _mm256_xor_si256(
+      _mm256_loadu_si256(reinterpret_cast<const __m256i *>(timestamps + i)), sign);
+
+    // All bits set for the rows outside of the range
+    auto outside = _mm256_or_si256(_mm256_cmpgt_epi64(start, ts), _mm256_cmpgt_epi64(ts, end));
+    auto outside_double = _mm256_castsi256_pd(outside);
+
+    auto price = _mm256_loadu_pd(prices + i);
+    auto volume_double = _mm256_setzero_pd();
+    auto volume = LoadVolumes(volumes + i, volume_double);
+
+    lanes.price_sum = _mm256_add_pd(lanes.price_sum, _mm256_andnot_pd(outside_double, price));
+    lanes.weighted_price_sum = _mm256_add_pd(
+      lanes.weighted_price_sum,
+      _mm256_andnot_pd(outside_double, _mm256_mul_pd(price, volume_double)));
+
+    lanes.min_price = _mm256_min_pd(
+      lanes.min_price, _mm256_blendv_pd(price, _mm256_set1_pd(kInfinity), outside_double));
+    lanes.max_price = _mm256_max_pd(
+      lanes.max_price, _mm256_blendv_pd(price, _mm256_set1_pd(-kInfinity), outside_double));
+
+    lanes.total_volume = _mm256_add_epi64(lanes.total_volume, _mm256_andnot_si256(outside, volume));
+    count += 4 - std::popcount(unsigned(_mm256_movemask_pd(outside_double)));
+  }
+
+  auto sums = SumColumnsInRangeScalar(timestamps + vector_size,
+                                      prices + vector_size, volumes + vector_size,
+                                      size - vector_size, start_ts, end_ts);
+  ReduceLanes(lanes, sums);
+  sums.count += count;
+  return sums;
+}
+
+#endif
+
+}
+
+auto GetInstructionSet() noexcept -> InstructionSet {
+  static const auto instruction_set = DetectInstructionSet();
+  return instruction_set;
+}
+
+auto SumColumns(std::span<const double> prices,
+                std::span<const uint32_t> volumes,
+                InstructionSet instruction_set) noexcept -> ColumnSums {
+#ifdef BOLT_AVX2_KERNELS
+  if (instruction_set == InstructionSet::kAvx2) {
+    return SumColumnsAvx2(prices.data(), volumes.data(), prices.size());
+  }
+#else
+  (void)instruction_set;
+#endif
+  return SumColumnsScalar(prices.data(), volumes.data(), prices.size());
+}
+
+auto SumColumnsInRange(std::span<const uint64_t> timestamps,
+                       std::span<const double> prices,
+                       std::span<const uint32_t> volumes,
+                       uint64_t start_ts,
+                       uint64_t end_ts,
+                       InstructionSet instruction_set) noexcept -> ColumnSums {
+#ifdef BOLT_AVX2_KERNELS
+  if (instruction_set == InstructionSet::kAvx2) {
+    return SumColumnsInRangeAvx2(timestamps.data(), prices.data(), volumes.data(),
+                                 timestamps.size(), start_ts, end_ts);
+  }
+#else
+  (void)instruction_set;
+#endif
+  return SumColumnsInRangeScalar(timestamps.data(), prices.data(), volumes.data(),
+                                 timestamps.size(), start_ts, end_ts);
+}
+
+}
@@ -0,0 +1,176 @@
+#include "headers/last_value_cache.hpp"
+#include "headers/constants.hpp"
+#include "../include/bolt/tick.hpp"
+#include "../include/bolt/quote.hpp"
+
+#include <bit>
+
+namespace bolt {
+
+namespace {
+
+auto Hash(uint64_t key) noexcept -> size_t {
+  return size_t((key * 0x9E3779B97F4A7C15ull) >> 32);
+}
+
+auto PairKey(uint32_t symbol_id, uint32_t exchange_id) noexcept -> uint64_t {
+  return (uint64_t(symbol_id) << 32) | exchange_id;
+}
+
+}
+
+template <typename RecordType>
+BasicLastValueCache<RecordType>::Table::Table(size_t capacity)
+  : entries(std::make_unique<Entry[]>(capacity)), capacity(capacity) {}
+
+template <typename RecordType>
+BasicLastValueCache<RecordType>::BasicLastValueCache() {
+  symbol_tables_.push_back(std::make_unique<Table>(Constants::kLAST_VALUE_INITIAL_CAPACITY));
+  pair_tables_.push_back(std::make_unique<Table>(Constants::kLAST_VALUE_INITIAL_CAPACITY));
+
+  by_symbol_.store(symbol_tables_.back().get(), std::memory_order_release);
+  by_pair_.store(pair_tables_.back().get(), std::memory_order_release);
+}
+
+template <>
+auto LastValueCache::ToWords_(const Tick &tick) noexcept -> words {
+  return {
+    tick.GetTimestamp(),
+    std::bit_cast<uint64_t>(tick.GetPrice()),
+    tick.GetVolume() | (uint64_t(tick.GetTradeCondition()) << 32),
+    tick.GetSymbolId() | (uint64_t(tick.GetExchangeId()) << 32)
+  };
+}
+
+template <>
+auto LastValueCache::FromWords_(const words &values) noexcept -> Tick {
+  return {values[0], std::bit_cast<double>(values[1]),
+          uint32_t(values[2]), uint32_t(values[3]), uint32_t(values[3] >> 32),
+          TradeConditions(values[2] >> 32)};
+}
+
+template <>
+auto QuoteLastValueCache::ToWords_(const Quote &quote) noexcept -> words {
+  return {
+    quote.GetTimestamp(),
+    std::bit_cast<uint64_t>(quote.GetBidPrice()),
+    std::bit_cast<uint64_t>(quote.GetAskPrice()),
+    quote.GetBidSize() | (uint64_t(quote.GetAskSize()) << 32),
+    quote.GetSymbolId() | (uint64_t(quote.GetExchangeId()) << 32)
+  };
+}
+
+template <>
+auto QuoteLastValueCache::FromWords_(const words &values) noexcept -> Quote {
+  return {values[0],
+          std::bit_cast<double>(values[1]), uint32_t(values[3]),
+          std::bit_cast<double>(values[2]), uint32_t(values[3] >> 32),
+          uint32_t(values[4]), uint32_t(values[4] >> 32)};
+}
+
+template <typename RecordType>
+auto BasicLastValueCache<RecordType>::Update(const RecordType &record) -> void {
+  auto values = ToWords_(record);
+
+  Update_(symbol_tables_, by_symbol_, record.GetSymbolId(), values);
+  Update_(pair_tables_, by_pair_, PairKey(record.GetSymbolId(), record.GetExchangeId()), values);
+}
+
+template <typename RecordType>
+auto BasicLastValueCache<RecordType>::Get(uint32_t symbol_id) const noexcept
+  -> std::optional<RecordType> {
+  return Get_(by_symbol_, symbol_id);
+}
+
+template <typename RecordType>
+auto BasicLastValueCache<RecordType>::Get(uint32_t symbol_id,
+                                          uint32_t exchange_id) const noexcept
+  -> std::optional<RecordType> {
+  return Get_(by_pair_, PairKey(symbol_id, exchange_id));
+}
+
+template <typename RecordType>
+auto BasicLastValueCache<RecordType>::Size() const noexcept -> size_t {
+  return by_symbol_.load(std::memory_order_acquire)->size.load(std::memory_order_relaxed);
+}
+
+template <typename RecordType>
+auto BasicLastValueCache<RecordType>::Update_(std::vector<std::unique_ptr<Table>> &tables,
+                                              std::atomic<Table *> &published,
+                                              uint64_t key, const words &values) -> void {
+  auto *table = tables.back().get();
+  auto mask = table->capacity - 1;
+
+  for (auto slot = Hash(key) & mask;; slot = (slot + 1) & mask) {
+    auto &entry = table->entries[slot];
+    auto stored_key = entry.key.load(std::memory_order_relaxed);
+
+    if (stored_key == key + 1) {
+      // Out of order records never replace a later one
+      if (values[0] >= entry.values.Peek(0)) entry.values.Store(values);
+      return;
+    }
+    if (stored_key != 0) continue;
+
+    // Kept at most half full, the probe sequences stay short
+    if (2 * (table->size.load(std::memory_order_relaxed) + 1) > table->capacity) {
+      Grow_(tables, published);
+      Update_(tables, published, key, values);
+      return;
+    }
+
+    entry.values.Store(values);
+    entry.key.store(key + 1, std::memory_order_release);
+    table->size.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+}
+
+template <typename RecordType>
+auto BasicLastValueCache<RecordType>::Get_(const std::atomic<Table *> &published,
+                                           uint64_t key) noexcept -> std::optional<RecordType> {
+  const auto *table = published.load(std::memory_order_acquire);
+  auto mask = table->capacity - 1;
+
+  for (auto slot = Hash(key) & mask;; slot = (slot + 1) & mask) {
+    const auto &entry = table->entries[slot];
+    auto stored_key = entry.key.load(std::memory_order_acquire);
+
+    if (stored_key == 0) return std::nullopt;
+    if (stored_key != key + 1) continue;
+
+    return FromWords_(entry.values.Load());
+  }
+}
+
+template <typename RecordType>
+auto BasicLastValueCache<RecordType>::Grow_(std::vector<std::unique_ptr<Table>> &tables,
+                                            std::atomic<Table *> &published) -> void {
+  const auto &table = *tables.back();
+  auto grown = std::make_unique<Table>(table.capacity * 2);
+  auto mask = grown->capacity - 1;
+
+  // Only the writer modifies the entries, they are copied as they are
+  for (size_t i = 0; i < table.capacity; i++) {
+    auto key = table.entries[i].key.load(std::memory_order_relaxed);
+    if (key == 0) continue;
+
+    auto slot = Hash(key - 1) & mask;
+    while (grown->entries[slot].key.load(std::memory_order_relaxed) != 0) {
+      slot = (slot + 1) & mask;
+    }
+
+    auto &entry = grown->entries[slot];
+    entry.values.Store(table.entries[i].values.Load());
+    entry.key.store(key, std::memory_order_relaxed);
+  }
+  grown->size.store(table.size.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+  tables.push_back(std::move(grown));
+  published.store(tables.back().get(), std::memory_order_release);
+}
+
+template class BasicLastValueCache<Tick>;
+template class BasicLastValueCache<Quote>;
+
+}
@@ -0,0 +1,109 @@
+#include "../include/bolt/predicate.hpp"
+#include "../include/bolt/tick.hpp"
+#include "headers/zone_map.hpp"
+
+#include <algorithm>
+
+namespace bolt {
+
+Predicate::Predicate() : Predicate(Node{}) {}
+
+Predicate::Predicate(Node &&node)
+  : node_(std::make_shared<const Node>(std::move(node))) {}
+
+auto Predicate::SymbolIn(std::vector<uint32_t> symbol_ids) -> Predicate {
+  std::sort(symbol_ids.begin(), symbol_ids.end());
+  symbol_ids.erase(std::unique(symbol_ids.begin(), symbol_ids.end()), symbol_ids.end());
+
+  auto node = Node();
+  node.kind = Kind::kSymbolIn;
+  node.ids = std::move(symbol_ids);
+  return Predicate(std::move(node));
+}
+
+auto Predicate::SymbolIs(uint32_t symbol_id) -> Predicate {
+  return SymbolIn({symbol_id});
+}
+
+auto Predicate::ExchangeIs(uint32_t exchange_id) -> Predicate {
+  auto node = Node();
+  node.kind = Kind::kExchangeIn;
+  node.ids = {exchange_id};
+  return Predicate(std::move(node));
+}
+
+auto Predicate::PriceBetween(double low, double high) -> Predicate {
+  auto node = Node();
+  node.kind = Kind::kPriceBetween;
+  node.low = low;
+  node.high = high;
+  return Predicate(std::move(node));
+}
+
+auto Predicate::VolumeAtLeast(uint32_t volume) -> Predicate {
+  auto node = Node();
+  node.kind = Kind::kVolumeAtLeast;
+  node.volume = volume;
+  return Predicate(std::move(node));
+}
+
+auto Predicate::ConditionNotIn(const std::vector<TradeConditions> &conditions) -> Predicate {
+  auto node = Node();
+  node.kind = Kind::kConditionNotIn;
+  for (auto condition : conditions) {
+    node.conditions |= GetConditionBit(condition);
+  }
+  return Predicate(std::move(node));
+}
+
+auto Predicate::And(const Predicate &other) const -> Predicate {
+  return Combine_(Kind::kAnd, other);
+}
+
+auto Predicate::Or(const Predicate &other) const -> Predicate {
+  return Combine_(Kind::kOr, other);
+}
+
+auto Predicate::operator&&(const Predicate &other) const -> Predicate {
+  return And(other);
+}
+
+auto Predicate::operator||(const Predicate &other) const -> Predicate {
+  return Or(other);
+}
+
+auto Predicate::Matches(const Tick &tick) const noexcept -> bool {
+  return Matches_(*node_, tick);
+}
+
+auto Predicate::Combine_(Kind kind, const Predicate &other) const -> Predicate {
+  auto node = Node();
+  node.kind = kind;
+  node.left = node_;
+  node.right = other.node_;
+  return Predicate(std::move(node));
+}
+
+auto Predicate::Matches_(const Node &node, const Tick &tick) noexcept -> bool {
+  switch (node.kind) {
+    case Kind::kAll:
+      return true;
+    case Kind::kSymbolIn:
+      return std::binary_search(node.ids.begin(), node.ids.end(), tick.GetSymbolId());
+    case Kind::kExchangeIn:
+      return std::binary_search(node.ids.begin(), node.ids.end(), tick.GetExchangeId());
+    case Kind::kPriceBetween:
+      return tick.GetPrice() >= node.low && tick.GetPrice() <= node.high;
+    case Kind::kVolumeAtLeast:
+      return tick.GetVolume() >= node.volume;
+    case Kind::kConditionNotIn:
+      return (node.conditions & GetConditionBit(tick.GetTradeCondition())) == 0;
+    case Kind::kAnd:
+      return Matches_(*node.left, tick) && Matches_(*node.right, tick);
+    case Kind::kOr:
+      return Matches_(*node.left, tick) || Matches_(*node.right, tick);
+  }
+  return false;
+}
+
+}
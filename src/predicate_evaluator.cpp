@@ -0,0 +1,161 @@
+#include "headers/predicate_evaluator.hpp"
+
+namespace bolt {
+
+namespace {
+
+using ZoneMatch = PredicateEvaluator::ZoneMatch;
+
+auto CheckRange(bool none, bool all) noexcept -> ZoneMatch {
+  if (none) return ZoneMatch::kNone;
+  return all ? ZoneMatch::kAll : ZoneMatch::kSome;
+}
+
+auto CheckIds(const std::vector<uint32_t> &ids, uint32_t min_id, uint32_t max_id) noexcept -> ZoneMatch {
+  auto it = std::lower_bound(ids.begin(), ids.end(), min_id);
+  auto any = it != ids.end() && *it <= max_id;
+  return CheckRange(!any, any && min_id == max_id);
+}
+
+// Small sets are compared against every id, which the compiler vectorizes,
+// larger ones are binary searched per row
+auto SelectIds(const std::vector<uint32_t> &ids, const uint32_t *column,
+               size_t size, uint8_t *mask) noexcept -> void {
+  if (ids.size() > Constants::kPREDICATE_SET_SCAN_LIMIT) {
+    for (size_t i = 0; i < size; i++) {
+      mask[i] = std::binary_search(ids.begin(), ids.end(), column[i]);
+    }
+    return;
+  }
+
+  std::fill(mask, mask + size, uint8_t(0));
+  for (auto id : ids) {
+    for (size_t i = 0; i < size; i++) {
+      mask[i] |= uint8_t(column[i] == id);
+    }
+  }
+}
+
+}
+
+PredicateEvaluator::PredicateEvaluator(const Predicate &predicate)
+  : node_(predicate.node_) {}
+
+auto PredicateEvaluator::Check(const ZoneMap &zone_map) const noexcept -> ZoneMatch {
+  if (zone_map.count == 0) return ZoneMatch::kNone;
+  return Check_(*node_, zone_map);
+}
+
+auto PredicateEvaluator::Select(const Buffer &buffer, size_t begin, size_t end,
+                                std::vector<uint8_t> &mask) const -> void {
+  mask.resize(end - begin);
+  Select_(*node_, buffer, begin, end, mask.data());
+}
+
+auto PredicateEvaluator::Check_(const Node &node, const ZoneMap &zone_map) noexcept -> ZoneMatch {
+  switch (node.kind) {
+    case Kind::kAll:
+      return ZoneMatch::kAll;
+
+    case Kind::kSymbolIn:
+      return CheckIds(node.ids, zone_map.min_symbol_id, zone_map.max_symbol_id);
+
+    case Kind::kExchangeIn:
+      return CheckIds(node.ids, zone_map.min_exchange_id, zone_map.max_exchange_id);
+
+    case Kind::kPriceBetween:
+      return CheckRange(zone_map.max_price < node.low || zone_map.min_price > node.high,
+                        zone_map.min_price >= node.low && zone_map.max_price <= node.high);
+
+    case Kind::kVolumeAtLeast:
+      return CheckRange(zone_map.max_volume < node.volume, zone_map.min_volume >= node.volume);
+
+    case Kind::kConditionNotIn:
+      return CheckRange((zone_map.conditions & ~node.conditions) == 0,
+                        (zone_map.conditions & node.conditions) == 0);
+
+    case Kind::kAnd: {
+      auto left = Check_(*node.left, zone_map);
+      if (left == ZoneMatch::kNone) return left;
+      auto right = Check_(*node.right, zone_map);
+      return std::min(left, right);
+    }
+
+    case Kind::kOr: {
+      auto left = Check_(*node.left, zone_map);
+      if (left == ZoneMatch::kAll) return left;
+      auto right = Check_(*node.right, zone_map);
+      return std::max(left, right);
+    }
+  }
+  return ZoneMatch::kSome;
+}
+
+auto PredicateEvaluator::Select_(const Node &node, const Buffer &buffer,
+                                 size_t begin, size_t end, uint8_t *mask) -> void {
+  auto size = end - begin;
+
+  switch (node.kind) {
+    case Kind::kAll:
+      std::fill(mask, mask + size, uint8_t(1));
+      return;
+
+    case Kind::kSymbolIn:
+      SelectIds(node.ids, buffer.GetSymbolIds().data() + begin, size, mask);
+      return;
+
+    case Kind::kExchangeIn:
+      SelectIds(node.ids, buffer.GetExchangeIds().data() + begin, size, mask);
+      return;
+
+    case Kind::kPriceBetween: {
+      // Fixed-point prices are converted exactly like 'Buffer::GetPrice'
+      const auto &price_scale = buffer.GetPriceScale();
+      if (price_scale.IsFixedPoint()) {
+        const auto *price_ticks = buffer.GetPriceTicks().data() + begin;
+        for (size_t i = 0; i < size; i++) {
+          auto price = price_scale.ToPrice(price_ticks[i]);
+          mask[i] = uint8_t(price >= node.low) & uint8_t(price <= node.high);
+        }
+      } else {
+        const auto *prices = buffer.GetPrices().data() + begin;
+        for (size_t i = 0; i < size; i++) {
+          mask[i] = uint8_t(prices[i] >= node.low) & uint8_t(prices[i] <= node.high);
+        }
+      }
+      return;
+    }
+
+    case Kind::kVolumeAtLeast: {
+      const auto *volumes = buffer.GetVolumes().data() + begin;
+      for (size_t i = 0; i < size; i++) {
+        mask[i] = uint8_t(volumes[i] >= node.volume);
+      }
+      return;
+    }
+
+    case Kind::kConditionNotIn: {
+      const auto *conditions = buffer.GetTraceCondtions().data() + begin;
+      for (size_t i = 0; i < size; i++) {
+        mask[i] = uint8_t((node.conditions & GetConditionBit(conditions[i])) == 0);
+      }
+      return;
+    }
+
+    case Kind::kAnd:
+    case Kind::kOr: {
+      auto right = std::vector<uint8_t>(size);
+      Select_(*node.left, buffer, begin, end, mask);
+      Select_(*node.right, buffer, begin, end, right.data());
+
+      if (node.kind == Kind::kAnd) {
+        for (size_t i = 0; i < size; i++) mask[i] &= right[i];
+      } else {
+        for (size_t i = 0; i < size; i++) mask[i] |= right[i];
+      }
+      return;
+    }
+  }
+}
+
+}
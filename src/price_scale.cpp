@@ -0,0 +1,41 @@
+#include "headers/price_scale.hpp"
+
+#include <cmath>
+
+namespace bolt {
+
+PriceScale::PriceScale(double scale) {
+  if (scale > 0) {
+    scale_ = scale;
+
+    // The reciprocal of a decimal scale is inexact in binary, e.g. 1.0 / 1e-5
+    // is 99999.99999999999, which would skew every conversion. It is rounded
+    // to the integral number of ticks per unit the scale stands for.
+    auto ticks_per_unit = 1.0 / scale;
+    auto rounded = std::round(ticks_per_unit);
+    ticks_per_unit_ = std::abs(ticks_per_unit - rounded) <= 1e-9 * rounded ? rounded
+                                                                           : ticks_per_unit;
+  }
+}
+
+auto PriceScale::operator==(const PriceScale &other) const noexcept -> bool {
+  return scale_ == other.scale_;
+}
+
+auto PriceScale::operator!=(const PriceScale &other) const noexcept -> bool {
+  return scale_ != other.scale_;
+}
+
+auto PriceScale::IsFixedPoint() const noexcept -> bool {
+  return scale_ > 0;
+}
+
+auto PriceScale::GetScale() const noexcept -> double {
+  return scale_;
+}
+
+auto PriceScale::GetTicksPerUnit() const noexcept -> double {
+  return ticks_per_unit_;
+}
+
+}
@@ -0,0 +1,30 @@
+#include "../include/bolt/quantile_result.hpp"
+
+#include <utility>
+
+namespace bolt {
+
+QuantileResult::QuantileResult(std::vector<double> quantiles,
+                               std::vector<double> prices,
+                               std::vector<double> volumes,
+                               size_t count)
+  : quantiles_(std::move(quantiles)), prices_(std::move(prices)),
+    volumes_(std::move(volumes)), count_(count) {}
+
+auto QuantileResult::GetQuantiles() const noexcept -> const std::vector<double> & {
+  return quantiles_;
+}
+
+auto QuantileResult::GetPrices() const noexcept -> const std::vector<double> & {
+  return prices_;
+}
+
+auto QuantileResult::GetVolumes() const noexcept -> const std::vector<double> & {
+  return volumes_;
+}
+
+auto QuantileResult::GetCount() const noexcept -> size_t {
+  return count_;
+}
+
+}
@@ -0,0 +1,130 @@
+#include "headers/quantile_sketch.hpp"
+#include "headers/constants.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace bolt {
+
+auto QuantileSketch::Add(double value) -> void {
+  if (levels_.empty()) AddLevels_(1);
+
+  min_ = count_ == 0 ? value : std::min(min_, value);
+  max_ = count_ == 0 ? value : std::max(max_, value);
+
+  levels_.front().push_back(value);
+  count_++;
+  size_++;
+  Compress_();
+}
+
+auto QuantileSketch::Merge(const QuantileSketch &other) -> void {
+  if (other.count_ == 0) return;
+
+  min_ = count_ == 0 ? other.min_ : std::min(min_, other.min_);
+  max_ = count_ == 0 ? other.max_ : std::max(max_, other.max_);
+
+  if (levels_.size() < other.levels_.size()) AddLevels_(other.levels_.size() - levels_.size());
+  for (size_t level = 0; level < other.levels_.size(); level++) {
+    levels_[level].insert(levels_[level].end(),
+                          other.levels_[level].begin(), other.levels_[level].end());
+  }
+
+  count_ += other.count_;
+  size_ += other.size_;
+  Compress_();
+}
+
+auto QuantileSketch::Count() const noexcept -> uint64_t {
+  return count_;
+}
+
+auto QuantileSketch::Quantiles(std::span<const double> qs) const -> std::vector<double> {
+  auto quantiles = std::vector<double>(qs.size());
+  if (count_ == 0) return quantiles;
+
+  // (value, weight) of every value held, the weights sum up to Count()
+  auto weighted = std::vector<std::pair<double, uint64_t>>{};
+  weighted.reserve(size_);
+  for (size_t level = 0; level < levels_.size(); level++) {
+    for (auto value : levels_[level]) {
+      weighted.emplace_back(value, uint64_t(1) << level);
+    }
+  }
+  std::sort(weighted.begin(), weighted.end());
+
+  for (size_t i = 0; i < qs.size(); i++) {
+    // The extremes are tracked exactly
+    if (qs[i] <= 0.0) {
+      quantiles[i] = min_;
+      continue;
+    }
+    if (qs[i] >= 1.0) {
+      quantiles[i] = max_;
+      continue;
+    }
+
+    auto rank = qs[i] * double(count_);
+    auto cumulative = uint64_t{};
+    quantiles[i] = max_;
+
+    for (const auto &[value, weight] : weighted) {
+      cumulative += weight;
+      if (double(cumulative) >= rank) {
+        quantiles[i] = value;
+        break;
+      }
+    }
+  }
+  return quantiles;
+}
+
+auto QuantileSketch::MemoryUsage() const noexcept -> size_t {
+  auto memory_usage = sizeof(QuantileSketch) + levels_.capacity() * sizeof(std::vector<double>);
+  for (const auto &level : levels_) {
+    memory_usage += level.capacity() * sizeof(double);
+  }
+  return memory_usage;
+}
+
+auto QuantileSketch::Capacity_(size_t level) const noexcept -> size_t {
+  auto depth = double(levels_.size() - 1 - level);
+  auto capacity = std::ceil(Constants::kQUANTILE_SKETCH_K * std::pow(2.0 / 3.0, depth));
+  return std::max<size_t>(2, size_t(capacity));
+}
+
+auto QuantileSketch::AddLevels_(size_t levels) -> void {
+  levels_.resize(levels_.size() + levels);
+
+  total_capacity_ = 0;
+  for (size_t level = 0; level < levels_.size(); level++) {
+    total_capacity_ += Capacity_(level);
+  }
+}
+
+auto QuantileSketch::Compress_() -> void {
+  while (size_ > total_capacity_) {
+    for (size_t level = 0; level < levels_.size(); level++) {
+      if (levels_[level].size() < Capacity_(level)) continue;
+      if (level + 1 == levels_.size()) AddLevels_(1);
+
+      auto &values = levels_[level];
+      auto &next = levels_[level + 1];
+      std::sort(values.begin(), values.end());
+
+      // An odd value out stays on this level
+      auto pairs = values.size() / 2;
+      for (auto i = size_t(promote_odd_); i < 2 * pairs; i += 2) {
+        next.push_back(values[i]);
+      }
+      promote_odd_ = !promote_odd_;
+
+      values.erase(values.begin(), values.begin() + 2 * pairs);
+      size_ -= pairs;
+      break;
+    }
+  }
+}
+
+}
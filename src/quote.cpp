@@ -0,0 +1,126 @@
+#include "../include/bolt/quote.hpp"
+#include <cmath>
+#include <limits>
+
+namespace bolt {
+
+Quote::Quote(uint64_t timestamp,
+             double bid_price, uint32_t bid_size,
+             double ask_price, uint32_t ask_size)
+  : timestamp_(timestamp), bid_price_(bid_price), ask_price_(ask_price),
+    bid_size_(bid_size), ask_size_(ask_size) {}
+
+Quote::Quote(uint64_t timestamp,
+             double bid_price, uint32_t bid_size,
+             double ask_price, uint32_t ask_size,
+             uint32_t symbol_id, uint32_t exchange_id)
+  : Quote(timestamp, bid_price, bid_size, ask_price, ask_size) {
+  symbol_id_ = symbol_id;
+  exchange_id_ = exchange_id;
+}
+
+Quote::Quote(const Record<QuoteSchema> &record) {
+  timestamp_ = record.Get<columns::Timestamp>();
+  symbol_id_ = record.Get<columns::SymbolId>();
+  exchange_id_ = record.Get<columns::ExchangeId>();
+
+  bid_price_ = record.Get<columns::BidPrice>();
+  bid_size_ = record.Get<columns::BidSize>();
+  ask_price_ = record.Get<columns::AskPrice>();
+  ask_size_ = record.Get<columns::AskSize>();
+}
+
+auto Quote::operator==(const Quote &other) const noexcept -> bool {
+  return check_equality_(other);
+}
+
+auto Quote::operator!=(const Quote &other) const noexcept -> bool {
+  return !check_equality_(other);
+}
+
+auto Quote::GetTimestamp() const noexcept -> uint64_t {
+  return timestamp_;
+}
+
+auto Quote::GetBidPrice() const noexcept -> double {
+  return bid_price_;
+}
+
+auto Quote::GetBidSize() const noexcept -> uint32_t {
+  return bid_size_;
+}
+
+auto Quote::GetAskPrice() const noexcept -> double {
+  return ask_price_;
+}
+
+auto Quote::GetAskSize() const noexcept -> uint32_t {
+  return ask_size_;
+}
+
+auto Quote::GetSymbolId() const noexcept -> uint32_t {
+  return symbol_id_;
+}
+
+auto Quote::GetExchangeId() const noexcept -> uint32_t {
+  return exchange_id_;
+}
+
+auto Quote::GetSpread() const noexcept -> double {
+  return ask_price_ - bid_price_;
+}
+
+auto Quote::SetTimeStamp(uint64_t timestamp) noexcept -> void {
+  timestamp_ = timestamp;
+}
+
+auto Quote::SetBid(double price, uint32_t size) noexcept -> void {
+  bid_price_ = price;
+  bid_size_ = size;
+}
+
+auto Quote::SetAsk(double price, uint32_t size) noexcept -> void {
+  ask_price_ = price;
+  ask_size_ = size;
+}
+
+auto Quote::SetSymbolId(uint32_t symbol_id) noexcept -> void {
+  symbol_id_ = symbol_id;
+}
+
+auto Quote::SetExchangeId(uint32_t exchange_id) noexcept -> void {
+  exchange_id_ = exchange_id;
+}
+
+auto Quote::ToRecord() const noexcept -> Record<QuoteSchema> {
+  return {
+    timestamp_, symbol_id_, exchange_id_,
+    bid_price_, bid_size_, ask_price_, ask_size_
+  };
+}
+
+auto Quote::Serialize(char *buffer) const -> void {
+  ToRecord().Serialize(buffer);
+}
+
+auto Quote::Deserialize(const char *buffer) -> void {
+  auto record = Record<QuoteSchema>();
+  record.Deserialize(buffer);
+  *this = Quote(record);
+}
+
+auto Quote::check_equality_(const Quote &other) const noexcept -> bool {
+  constexpr double epsilon = std::numeric_limits<double>::epsilon();
+
+  if (other.timestamp_ != timestamp_) return false;
+  if (other.symbol_id_ != symbol_id_) return false;
+  if (other.exchange_id_ != exchange_id_) return false;
+  if (other.bid_size_ != bid_size_) return false;
+  if (other.ask_size_ != ask_size_) return false;
+
+  if (std::fabs(bid_price_ - other.bid_price_) > epsilon) return false;
+  if (std::fabs(ask_price_ - other.ask_price_) > epsilon) return false;
+  return true;
+}
+
+}
@@ -0,0 +1,73 @@
+#include "../include/bolt/quote_aggregate_result.hpp"
+
+namespace bolt {
+
+QuoteAggregateResult::QuoteAggregateResult(size_t count,
+                                           double max_spread, double min_spread,
+                                           double avg_spread, double time_weighted_spread)
+  : count_(count), max_spread_(max_spread), min_spread_(min_spread),
+    avg_spread_(avg_spread), time_weighted_spread_(time_weighted_spread) {}
+
+auto QuoteAggregateResult::operator==(
+  const QuoteAggregateResult &other) const noexcept -> bool {
+  return EqualityCheck_(other);
+}
+
+auto QuoteAggregateResult::operator!=(
+  const QuoteAggregateResult &other) const noexcept -> bool {
+  return !EqualityCheck_(other);
+}
+
+auto QuoteAggregateResult::SetCount(size_t count) noexcept -> void {
+  count_ = count;
+}
+
+auto QuoteAggregateResult::SetMaxSpread(double max_spread) noexcept -> void {
+  max_spread_ = max_spread;
+}
+
+auto QuoteAggregateResult::SetMinSpread(double min_spread) noexcept -> void {
+  min_spread_ = min_spread;
+}
+
+auto QuoteAggregateResult::SetAvgSpread(double avg_spread) noexcept -> void {
+  avg_spread_ = avg_spread;
+}
+
+auto QuoteAggregateResult::SetTimeWeightedSpread(double time_weighted_spread) noexcept -> void {
+  time_weighted_spread_ = time_weighted_spread;
+}
+
+auto QuoteAggregateResult::GetCount() const noexcept -> size_t {
+  return count_;
+}
+
+auto QuoteAggregateResult::GetMaxSpread() const noexcept -> double {
+  return max_spread_;
+}
+
+auto QuoteAggregateResult::GetMinSpread() const noexcept -> double {
+  return min_spread_;
+}
+
+auto QuoteAggregateResult::GetAvgSpread() const noexcept -> double {
+  return avg_spread_;
+}
+
+auto QuoteAggregateResult::GetTimeWeightedSpread() const noexcept -> double {
+  return time_weighted_spread_;
+}
+
+auto QuoteAggregateResult::EqualityCheck_(
+  const QuoteAggregateResult &other) const noexcept -> bool {
+
+  if (other.count_ != count_) return false;
+  if (other.max_spread_ != max_spread_) return false;
+  if (other.min_spread_ != min_spread_) return false;
+  if (other.avg_spread_ != avg_spread_) return false;
+  if (other.time_weighted_spread_ != time_weighted_spread_) return false;
+
+  return true;
+}
+
+}
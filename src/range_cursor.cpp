@@ -0,0 +1,73 @@
+#include "../include/bolt/range_cursor.hpp"
+#include "../include/bolt/tick.hpp"
+
+#include "headers/buffer.hpp"
+#include "headers/state.hpp"
+
+#include <algorithm>
+
+namespace bolt {
+
+auto TickView::ToTick() const -> Tick {
+  return {
+    GetTimestamp(), GetPrice(), GetVolume(),
+    GetSymbolId(), GetExchangeId(), GetTradeCondition()
+  };
+}
+
+TickSlice::TickSlice(const Buffer &buffer, size_t begin, size_t end, bool is_sorted) {
+  auto count = end - begin;
+
+  timestamps_ = {buffer.GetTimestamps().data() + begin, count};
+  symbol_ids_ = {buffer.GetSymbolIds().data() + begin, count};
+  exchange_ids_ = {buffer.GetExchangeIds().data() + begin, count};
+  volumes_ = {buffer.GetVolumes().data() + begin, count};
+  trade_conditions_ = {buffer.GetTraceCondtions().data() + begin, count};
+
+  const auto &price_scale = buffer.GetPriceScale();
+  if (price_scale.IsFixedPoint()) {
+    price_ticks_ = {buffer.GetPriceTicks().data() + begin, count};
+  } else {
+    prices_ = {buffer.GetPrices().data() + begin, count};
+  }
+
+  ticks_per_unit_ = price_scale.GetTicksPerUnit();
+  is_fixed_point_ = price_scale.IsFixedPoint();
+  is_sorted_ = is_sorted;
+}
+
+RangeCursor::RangeCursor(std::shared_ptr<const State> state,
+                         std::vector<TickSlice> &&slices)
+  : state_(std::move(state)), slices_(std::move(slices)) {
+
+  std::erase_if(slices_, [](const TickSlice &slice) { return slice.Empty(); });
+
+  for (size_t i = 0; i < slices_.size(); i++) {
+    size_ += slices_[i].Size();
+
+    if (!slices_[i].IsSorted()) {
+      is_sorted_ = false;
+    } else if (i > 0 &&
+               slices_[i - 1].GetTimestamps().back() > slices_[i].GetTimestamps().front()) {
+      is_sorted_ = false;
+    }
+  }
+}
+
+auto RangeCursor::GetSlices() const noexcept -> const std::vector<TickSlice> & {
+  return slices_;
+}
+
+auto RangeCursor::Size() const noexcept -> size_t {
+  return size_;
+}
+
+auto RangeCursor::Empty() const noexcept -> bool {
+  return size_ == 0;
+}
+
+auto RangeCursor::IsSorted() const noexcept -> bool {
+  return is_sorted_;
+}
+
+}
@@ -0,0 +1,136 @@
+#include "headers/raw_buffer.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace bolt {
+
+RawRecord::RawRecord(const char *data) noexcept : data_(data) {}
+
+auto RawRecord::GetTimestamp() const noexcept -> uint64_t {
+  auto timestamp = uint64_t{};
+  std::memcpy(&timestamp, data_, sizeof(timestamp));
+  return timestamp;
+}
+
+auto RawRecord::GetData() const noexcept -> const char * {
+  return data_;
+}
+
+RawBuffer::RawBuffer(const RawLayout &layout, size_t reserve_capacity) : layout_(layout) {
+  timestamps_.reserve(reserve_capacity);
+  columns_.resize(layout_->size() - 1);
+  for (size_t column = 1; column < layout_->size(); column++) {
+    columns_[column - 1].reserve((*layout_)[column] * reserve_capacity);
+  }
+}
+
+auto RawBuffer::operator==(const RawBuffer &other) const noexcept -> bool {
+  return timestamps_ == other.timestamps_ && columns_ == other.columns_;
+}
+
+auto RawBuffer::operator!=(const RawBuffer &other) const noexcept -> bool {
+  return !(*this == other);
+}
+
+auto RawBuffer::InsertRecord(const RawRecord &record) noexcept -> void {
+  UpdateIsSorted_(record.GetTimestamp());
+  timestamps_.push_back(record.GetTimestamp());
+
+  const auto *data = record.GetData() + (*layout_)[0];
+  for (size_t column = 1; column < layout_->size(); column++) {
+    auto width = (*layout_)[column];
+    columns_[column - 1].insert(columns_[column - 1].end(), data, data + width);
+    data += width;
+  }
+}
+
+auto RawBuffer::InsertRow(const RawBuffer &other, size_t index) noexcept -> void {
+  if (!layout_) *this = RawBuffer(other.layout_);
+
+  UpdateIsSorted_(other.timestamps_[index]);
+  timestamps_.push_back(other.timestamps_[index]);
+
+  for (size_t column = 1; column < layout_->size(); column++) {
+    const auto *value = other.GetValue(column, index);
+    columns_[column - 1].insert(columns_[column - 1].end(), value,
+                                value + (*layout_)[column]);
+  }
+}
+
+auto RawBuffer::GetTimestamps() const noexcept -> const std::vector<uint64_t> & {
+  return timestamps_;
+}
+
+auto RawBuffer::GetLayout() const noexcept -> const RawLayout & {
+  return layout_;
+}
+
+auto RawBuffer::GetRowSize() const noexcept -> size_t {
+  return layout_ ? std::accumulate(layout_->begin(), layout_->end(), size_t{}) : 0;
+}
+
+auto RawBuffer::GetRow(size_t index, char *buffer) const noexcept -> void {
+  for (size_t column = 0; column < layout_->size(); column++) {
+    std::memcpy(buffer, GetValue(column, index), (*layout_)[column]);
+    buffer += (*layout_)[column];
+  }
+}
+
+auto RawBuffer::GetValue(size_t column, size_t index) const noexcept -> const char * {
+  if (column == 0) return reinterpret_cast<const char *>(&timestamps_[index]);
+  return columns_[column - 1].data() + index * (*layout_)[column];
+}
+
+auto RawBuffer::Size() const noexcept -> size_t {
+  return timestamps_.size();
+}
+
+auto RawBuffer::MemoryUsage() const noexcept -> size_t {
+  auto usage = sizeof(RawBuffer) + timestamps_.capacity() * sizeof(uint64_t);
+  for (const auto &column : columns_) {
+    usage += column.capacity();
+  }
+  return usage;
+}
+
+auto RawBuffer::IsSorted() const noexcept -> bool {
+  return is_sorted_;
+}
+
+auto RawBuffer::Copy() const noexcept -> RawBuffer {
+  return {*this};
+}
+
+auto RawBuffer::SortedCopy() const -> RawBuffer {
+  auto indices = std::vector<size_t>(timestamps_.size());
+  std::iota(indices.begin(), indices.end(), 0);
+
+  std::stable_sort(indices.begin(), indices.end(), [this](size_t a, size_t b) {
+    return timestamps_[a] < timestamps_[b];
+  });
+
+  if (!layout_) return {};
+
+  auto sorted = RawBuffer(layout_, indices.size());
+  for (const auto &index : indices) {
+    sorted.InsertRow(*this, index);
+  }
+  return sorted;
+}
+
+auto RawBuffer::GetRange(uint64_t start_ts, uint64_t end_ts) const noexcept
+  -> std::pair<size_t, size_t> {
+  auto it_start = std::lower_bound(timestamps_.begin(), timestamps_.end(), start_ts);
+  auto it_end = std::upper_bound(it_start, timestamps_.end(), end_ts);
+  return {size_t(it_start - timestamps_.begin()), size_t(it_end - timestamps_.begin())};
+}
+
+auto RawBuffer::UpdateIsSorted_(uint64_t timestamp) noexcept -> void {
+  if (is_sorted_ && !timestamps_.empty() && timestamps_.back() > timestamp) {
+    is_sorted_ = false;
+  }
+}
+
+}
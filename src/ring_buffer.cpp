@@ -2,17 +2,20 @@
 #include "headers/constants.hpp"
 
 #include "../include/bolt/tick.hpp"
+#include "../include/bolt/quote.hpp"
 
 using namespace Constants;
 
 namespace bolt {
 
-RingBuffer::RingBuffer() : reader_(0), writer_(0) {
+template <typename RecordType>
+BasicRingBuffer<RecordType>::BasicRingBuffer() : reader_(0), writer_(0) {
   ring_buffer_size_ = ::kRING_BUFFER_SIZE;
   buffer_.resize(ring_buffer_size_);
 }
 
-auto RingBuffer::Insert(const Tick &tick) noexcept -> bool {
+template <typename RecordType>
+auto BasicRingBuffer<RecordType>::Insert(const RecordType &record) noexcept -> bool {
   uint64_t writer_pos;
 
   do {
@@ -28,11 +31,12 @@ auto RingBuffer::Insert(const Tick &tick) noexcept -> bool {
                                           std::memory_order_relaxed));
 
   auto index = writer_pos % ring_buffer_size_;
-  buffer_[index] = tick;
+  buffer_[index] = record;
   return true;
 }
 
-auto RingBuffer::Read() noexcept -> std::optional<Tick> {
+template <typename RecordType>
+auto BasicRingBuffer<RecordType>::Read() noexcept -> std::optional<RecordType> {
   auto writer_pos = writer_.load(std::memory_order_acquire);
   auto reader_pos = reader_.load(std::memory_order_acquire);
 
@@ -42,21 +46,26 @@ auto RingBuffer::Read() noexcept -> std::optional<Tick> {
 
   auto index = reader_pos % ring_buffer_size_;
 
-  auto tick = buffer_[index];
+  auto record = buffer_[index];
   reader_.fetch_add(1, std::memory_order_acq_rel);
-  return tick;
+  return record;
 }
 
-auto RingBuffer::IsEmpty() const noexcept -> bool {
+template <typename RecordType>
+auto BasicRingBuffer<RecordType>::IsEmpty() const noexcept -> bool {
   auto writer_pos = writer_.load(std::memory_order_acquire);
   auto reader_pos = reader_.load(std::memory_order_acquire);
   return writer_pos == reader_pos;
 }
 
-auto RingBuffer::IsFull() const noexcept -> bool {
+template <typename RecordType>
+auto BasicRingBuffer<RecordType>::IsFull() const noexcept -> bool {
   auto writer_pos = writer_.load(std::memory_order_acquire);
   auto reader_pos = reader_.load(std::memory_order_acquire);
   return writer_pos - reader_pos >= ring_buffer_size_;
 }
 
+template class BasicRingBuffer<Tick>;
+template class BasicRingBuffer<Quote>;
+
 }
@@ -0,0 +1,67 @@
+#include "../include/bolt/rolling_series.hpp"
+#include "../include/bolt/aggregate_result.hpp"
+
+#include "headers/sliding_window.hpp"
+
+namespace bolt {
+
+RollingSeries::RollingSeries(RollingMetric metrics) : metrics_(metrics) {}
+
+auto RollingSeries::Size() const noexcept -> size_t {
+  return timestamps_.size();
+}
+
+auto RollingSeries::GetMetrics() const noexcept -> RollingMetric {
+  return metrics_;
+}
+
+auto RollingSeries::GetTimestamps() const noexcept -> const std::vector<uint64_t> & {
+  return timestamps_;
+}
+
+auto RollingSeries::GetSma() const noexcept -> const std::vector<double> & {
+  return sma_;
+}
+
+auto RollingSeries::GetEma() const noexcept -> const std::vector<double> & {
+  return ema_;
+}
+
+auto RollingSeries::GetVwap() const noexcept -> const std::vector<double> & {
+  return vwap_;
+}
+
+auto RollingSeries::GetStdDev() const noexcept -> const std::vector<double> & {
+  return std_dev_;
+}
+
+auto RollingSeries::GetMinPrices() const noexcept -> const std::vector<double> & {
+  return min_prices_;
+}
+
+auto RollingSeries::GetMaxPrices() const noexcept -> const std::vector<double> & {
+  return max_prices_;
+}
+
+auto RollingSeries::GetVolumes() const noexcept -> const std::vector<uint64_t> & {
+  return volumes_;
+}
+
+auto RollingSeries::Has_(RollingMetric metric) const noexcept -> bool {
+  return (metrics_ & metric) != RollingMetric::kNone;
+}
+
+auto RollingSeries::Append_(uint64_t timestamp, const SlidingWindow &window, double ema) -> void {
+  timestamps_.push_back(timestamp);
+  if (Has_(RollingMetric::kEma)) ema_.push_back(ema);
+  if (Has_(RollingMetric::kStdDev)) std_dev_.push_back(window.GetStdDev());
+
+  auto result = window.ToResult();
+  if (Has_(RollingMetric::kSma)) sma_.push_back(result.GetAvgPrice());
+  if (Has_(RollingMetric::kVwap)) vwap_.push_back(result.GetVwap());
+  if (Has_(RollingMetric::kMinPrice)) min_prices_.push_back(result.GetMinPrice());
+  if (Has_(RollingMetric::kMaxPrice)) max_prices_.push_back(result.GetMaxPrice());
+  if (Has_(RollingMetric::kVolume)) volumes_.push_back(result.GetTotalVolume());
+}
+
+}
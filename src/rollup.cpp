@@ -0,0 +1,92 @@
+#include "headers/rollup.hpp"
+
+#include <algorithm>
+
+namespace bolt {
+
+auto Rollup::PushBack(const AggregateAccumulator &summary,
+                      uint64_t front_ts,
+                      uint64_t back_ts) const -> Rollup {
+  auto rollup = *this;
+
+  // Doubling the capacity makes the current tree the left half of the new one
+  if (rollup.end_ == rollup.capacity_) {
+    if (rollup.root_) {
+      rollup.root_ = std::make_shared<const Node>(Node{rollup.root_->summary, rollup.root_, nullptr});
+    }
+    rollup.capacity_ = rollup.capacity_ == 0 ? 1 : rollup.capacity_ * 2;
+  }
+
+  if (Size() > 0 && front_ts < back_ts_) rollup.is_ordered_ = false;
+  rollup.back_ts_ = Size() > 0 ? std::max(back_ts_, back_ts) : back_ts;
+
+  rollup.root_ = Set_(rollup.root_, 0, rollup.capacity_, rollup.end_, &summary);
+  rollup.end_++;
+  return rollup;
+}
+
+auto Rollup::PopFront() const -> Rollup {
+  if (Size() == 0) return *this;
+
+  auto rollup = *this;
+  rollup.root_ = Set_(rollup.root_, 0, rollup.capacity_, rollup.begin_, nullptr);
+  rollup.begin_++;
+  return rollup;
+}
+
+auto Rollup::Query(size_t begin, size_t end) const noexcept -> AggregateAccumulator {
+  auto result = AggregateAccumulator();
+  if (begin < end) {
+    Query_(root_, 0, capacity_, begin_ + begin, begin_ + end, result);
+  }
+  return result;
+}
+
+auto Rollup::Size() const noexcept -> size_t {
+  return end_ - begin_;
+}
+
+auto Rollup::IsOrdered() const noexcept -> bool {
+  return is_ordered_;
+}
+
+auto Rollup::Set_(const node_ptr &node, size_t low, size_t high,
+                  size_t slot, const AggregateAccumulator *summary) -> node_ptr {
+  if (high - low == 1) {
+    return summary ? std::make_shared<const Node>(Node{*summary, nullptr, nullptr}) : nullptr;
+  }
+
+  auto middle = low + (high - low) / 2;
+  auto left = node ? node->left : nullptr;
+  auto right = node ? node->right : nullptr;
+
+  if (slot < middle) {
+    left = Set_(left, low, middle, slot, summary);
+  } else {
+    right = Set_(right, middle, high, slot, summary);
+  }
+
+  // Subtrees without any leaf left are dropped
+  if (!left && !right) return nullptr;
+
+  auto merged = AggregateAccumulator();
+  if (left) merged.Merge(left->summary);
+  if (right) merged.Merge(right->summary);
+  return std::make_shared<const Node>(Node{merged, std::move(left), std::move(right)});
+}
+
+auto Rollup::Query_(const node_ptr &node, size_t low, size_t high,
+                    size_t begin, size_t end, AggregateAccumulator &result) noexcept -> void {
+  if (!node || end <= low || high <= begin) return;
+
+  if (begin <= low && high <= end) {
+    result.Merge(node->summary);
+    return;
+  }
+
+  auto middle = low + (high - low) / 2;
+  Query_(node->left, low, middle, begin, end, result);
+  Query_(node->right, middle, high, begin, end, result);
+}
+
+}
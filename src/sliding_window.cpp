@@ -0,0 +1,116 @@
+#include "headers/sliding_window.hpp"
+#include "headers/constants.hpp"
+#include "../include/bolt/aggregate_result.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Constants;
+
+namespace bolt {
+
+SlidingWindow::SlidingWindow(uint64_t length, const PriceScale &price_scale)
+  : length_(length), price_scale_(price_scale), accumulator_(price_scale) {}
+
+auto SlidingWindow::Add(uint64_t timestamp, double price, uint32_t volume) -> void {
+  Slide(timestamp);
+  if (timestamp < GetStart_()) return;
+
+  // Rounded to the stored precision, the min and max are then the stored prices
+  if (price_scale_.IsFixedPoint()) price = price_scale_.ToPrice(price_scale_.ToTicks(price));
+
+  if (rows_.empty()) {
+    reference_price_ = price;
+    deviation_sum_ = 0.0;
+    squared_deviation_sum_ = 0.0;
+  }
+
+  rows_.push_back({timestamp, price, volume});
+  accumulator_.Add(price, volume);
+
+  auto deviation = price - reference_price_;
+  deviation_sum_ += deviation;
+  squared_deviation_sum_ += deviation * deviation;
+
+  // A candidate dominated by a later (and so longer living) row can never
+  // become the min or max again
+  while (!min_prices_.empty() && min_prices_.back().second >= price) min_prices_.pop_back();
+  while (!max_prices_.empty() && max_prices_.back().second <= price) max_prices_.pop_back();
+
+  min_prices_.emplace_back(added_, price);
+  max_prices_.emplace_back(added_, price);
+  added_++;
+}
+
+auto SlidingWindow::Slide(uint64_t latest_ts) -> void {
+  if (latest_ts <= latest_ts_) return;
+  latest_ts_ = latest_ts;
+
+  auto start = GetStart_();
+  while (!rows_.empty() && rows_.front().timestamp < start) {
+    const auto &row = rows_.front();
+    accumulator_.Remove(row.price, row.volume);
+
+    auto deviation = row.price - reference_price_;
+    deviation_sum_ -= deviation;
+    squared_deviation_sum_ -= deviation * deviation;
+    rows_.pop_front();
+    retired_++;
+    retired_since_rebuild_++;
+  }
+
+  if (retired_since_rebuild_ >= std::max<uint64_t>(rows_.size(),
+                                                    ::kSLIDING_WINDOW_REBUILD_INTERVAL)) {
+    RebuildSums_();
+  }
+
+  while (!min_prices_.empty() && min_prices_.front().first < retired_) min_prices_.pop_front();
+  while (!max_prices_.empty() && max_prices_.front().first < retired_) max_prices_.pop_front();
+}
+
+auto SlidingWindow::Size() const noexcept -> size_t {
+  return rows_.size();
+}
+
+auto SlidingWindow::GetLength() const noexcept -> uint64_t {
+  return length_;
+}
+
+auto SlidingWindow::ToResult() const noexcept -> AggregateResult {
+  auto result = accumulator_.ToResult();
+  if (rows_.empty()) return result;
+
+  result.SetMinPrice(min_prices_.front().second);
+  result.SetMaxPrice(max_prices_.front().second);
+  return result;
+}
+
+auto SlidingWindow::GetStdDev() const noexcept -> double {
+  if (rows_.empty()) return 0.0;
+
+  auto count = double(rows_.size());
+  auto mean = deviation_sum_ / count;
+  return std::sqrt(std::max(0.0, squared_deviation_sum_ / count - mean * mean));
+}
+
+auto SlidingWindow::GetStart_() const noexcept -> uint64_t {
+  return latest_ts_ >= length_ ? latest_ts_ - length_ : 0;
+}
+
+auto SlidingWindow::RebuildSums_() noexcept -> void {
+  accumulator_ = AggregateAccumulator(price_scale_);
+  reference_price_ = rows_.empty() ? 0.0 : rows_.front().price;
+  deviation_sum_ = 0.0;
+  squared_deviation_sum_ = 0.0;
+
+  for (const auto &row : rows_) {
+    accumulator_.Add(row.price, row.volume);
+
+    auto deviation = row.price - reference_price_;
+    deviation_sum_ += deviation;
+    squared_deviation_sum_ += deviation * deviation;
+  }
+  retired_since_rebuild_ = 0;
+}
+
+}
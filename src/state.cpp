@@ -1,67 +1,114 @@
 #include "headers/state.hpp"
 #include "headers/buffer.hpp"
+#include "headers/basic_buffer.hpp"
+
+#include <algorithm>
+#include <limits>
 
 namespace bolt {
 
-State::State() {
-  active_buffer_ = std::make_shared<Buffer>();
+template <typename BufferType>
+BasicState<BufferType>::BasicState() {
+  active_buffer_ = std::make_shared<BufferType>();
   sealed_buffers_ = std::make_shared<const sealed_list>();
 }
 
-State::State(ptr<Buffer> active_buffer,
-             const ptr<sealed_list> &sealed_buffers) {
+template <typename BufferType>
+BasicState<BufferType>::BasicState(ptr<BufferType> active_buffer,
+                                   const ptr<sealed_list> &sealed_buffers,
+                                   uint64_t retention_horizon,
+                                   size_t active_size,
+                                   const Rollup &rollup) {
   active_buffer_ = std::move(active_buffer);
   sealed_buffers_ = sealed_buffers;
+  retention_horizon_ = retention_horizon;
+  active_size_ = active_size == std::numeric_limits<size_t>::max() ? active_buffer_->Size()
+                                                                    : active_size;
+  rollup_ = rollup;
 }
 
-State::State(const State &other) {
+template <typename BufferType>
+BasicState<BufferType>::BasicState(const BasicState &other) {
   CopyFrom_(other);
 }
 
-State::State(State &&other) noexcept {
+template <typename BufferType>
+BasicState<BufferType>::BasicState(BasicState &&other) noexcept {
   MoveFrom_(std::move(other));
 }
 
-auto State::operator=(const State &other) -> State & {
+template <typename BufferType>
+auto BasicState<BufferType>::operator=(const BasicState &other) -> BasicState & {
   CopyFrom_(other);
   return *this;
 }
 
-auto State::operator=(State &&other) noexcept -> State & {
+template <typename BufferType>
+auto BasicState<BufferType>::operator=(BasicState &&other) noexcept -> BasicState & {
   MoveFrom_(std::move(other));
   return *this;
 }
 
-auto State::operator==(const State &other) const -> bool {
+template <typename BufferType>
+auto BasicState<BufferType>::operator==(const BasicState &other) const -> bool {
   return EqualityCheck_(other);
 }
 
-auto State::operator!=(const State &other) const -> bool {
+template <typename BufferType>
+auto BasicState<BufferType>::operator!=(const BasicState &other) const -> bool {
   return !EqualityCheck_(other);
 }
 
-auto State::GetSealedBuffers() const noexcept
+template <typename BufferType>
+auto BasicState<BufferType>::GetSealedBuffers() const noexcept
   -> const ptr<const sealed_list> & {
   return sealed_buffers_;
 }
 
-auto State::GetActiveBuffer() const noexcept -> const ptr<Buffer> & {
+template <typename BufferType>
+auto BasicState<BufferType>::GetActiveBuffer() const noexcept -> const ptr<BufferType> & {
   return active_buffer_;
 }
 
-auto State::CopyFrom_(const State &other) -> void {
+template <typename BufferType>
+auto BasicState<BufferType>::GetRetentionHorizon() const noexcept -> uint64_t {
+  return retention_horizon_;
+}
+
+template <typename BufferType>
+auto BasicState<BufferType>::GetActiveSize() const noexcept -> size_t {
+  return active_size_;
+}
+
+template <typename BufferType>
+auto BasicState<BufferType>::GetRollup() const noexcept -> const Rollup & {
+  return rollup_;
+}
+
+template <typename BufferType>
+auto BasicState<BufferType>::CopyFrom_(const BasicState &other) -> void {
   sealed_buffers_ = other.sealed_buffers_;
   active_buffer_ = other.active_buffer_;
+  retention_horizon_ = other.retention_horizon_;
+  active_size_ = other.active_size_;
+  rollup_ = other.rollup_;
 }
 
-auto State::MoveFrom_(State &&other) noexcept -> void {
+template <typename BufferType>
+auto BasicState<BufferType>::MoveFrom_(BasicState &&other) noexcept -> void {
   sealed_buffers_ = std::move(other.sealed_buffers_);
   active_buffer_ = std::move(other.active_buffer_);
+  retention_horizon_ = other.retention_horizon_;
+  active_size_ = other.active_size_;
+  rollup_ = std::move(other.rollup_);
 }
 
-auto State::EqualityCheck_(const State &other) const -> bool {
+template <typename BufferType>
+auto BasicState<BufferType>::EqualityCheck_(const BasicState &other) const -> bool {
   if (other.active_buffer_ != active_buffer_) return false;
   if (other.sealed_buffers_ != sealed_buffers_) return false;
+  if (other.retention_horizon_ != retention_horizon_) return false;
+  if (other.active_size_ != active_size_) return false;
 
   if (!active_buffer_ || !other.active_buffer_) return false;
   if (!sealed_buffers_ || !other.sealed_buffers_) return false;
@@ -75,4 +122,8 @@ auto State::EqualityCheck_(const State &other) const -> bool {
   return true;
 }
 
+template class BasicState<Buffer>;
+template class BasicState<QuoteBuffer>;
+template class BasicState<RawBuffer>;
+
 }
@@ -0,0 +1,53 @@
+#include "headers/subscription.hpp"
+#include "../include/bolt/aggregate_result.hpp"
+#include "../include/bolt/tick.hpp"
+
+#include <bit>
+
+namespace bolt {
+
+Subscription::Subscription(uint64_t window,
+                           const Predicate &predicate,
+                           const PriceScale &price_scale,
+                           ContinuousQuery::callback_func callback)
+  : predicate_(predicate), callback_(std::move(callback)), window_(window, price_scale) {}
+
+auto Subscription::Update(const Tick &tick) -> void {
+  auto size = window_.Size();
+
+  // Every tick moves the window, the matching ones are added to it
+  auto matches = predicate_.Matches(tick);
+  if (matches) {
+    window_.Add(tick.GetTimestamp(), tick.GetPrice(), tick.GetVolume());
+  } else {
+    window_.Slide(tick.GetTimestamp());
+  }
+
+  if (matches || window_.Size() != size) Publish_();
+}
+
+auto Subscription::GetResult() const noexcept -> AggregateResult {
+  auto values = result_.Load();
+  return {
+    size_t(values[0]), values[1],
+    std::bit_cast<double>(values[5]), std::bit_cast<double>(values[4]),
+    std::bit_cast<double>(values[2]), std::bit_cast<double>(values[3])
+  };
+}
+
+auto Subscription::GetWindow() const noexcept -> uint64_t {
+  return window_.GetLength();
+}
+
+auto Subscription::Publish_() -> void {
+  auto result = window_.ToResult();
+  result_.Store({
+    result.GetCount(), result.GetTotalVolume(),
+    std::bit_cast<uint64_t>(result.GetAvgPrice()), std::bit_cast<uint64_t>(result.GetVwap()),
+    std::bit_cast<uint64_t>(result.GetMinPrice()), std::bit_cast<uint64_t>(result.GetMaxPrice())
+  });
+
+  if (callback_) callback_(result);
+}
+
+}
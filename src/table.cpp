@@ -0,0 +1,102 @@
+#include "../include/bolt/table.hpp"
+#include "headers/buffer_manager.hpp"
+#include "headers/raw_buffer.hpp"
+#include "headers/state.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+
+namespace bolt {
+
+RawTable::RawTable(const std::shared_ptr<ThreadPool> &pool,
+                   const Config &config,
+                   const std::vector<size_t> &column_widths)
+  : pool_(pool), column_widths_(column_widths) {
+
+  auto layout = std::make_shared<const std::vector<size_t>>(column_widths);
+  storage_handler_ = std::make_unique<RawBufferManager>(*pool_, config, layout);
+}
+
+RawTable::~RawTable() = default;
+
+auto RawTable::Insert(const char *rows, size_t count) noexcept -> void {
+  auto row_size = std::accumulate(column_widths_.begin(), column_widths_.end(), size_t{});
+
+  auto lock = std::unique_lock<std::mutex>(insert_mutex_);
+  for (size_t i = 0; i < count; i++) {
+    storage_handler_->Insert(RawRecord(rows + i * row_size));
+  }
+}
+
+template <typename Func>
+auto RawTable::ForEachRowInOrder_(uint64_t start_ts, uint64_t end_ts, Func &&func) const
+  -> void {
+  auto state = storage_handler_->GetState();
+  start_ts = std::max(start_ts, state->GetRetentionHorizon());
+  if (start_ts > end_ts) return;
+
+  using row = std::tuple<uint64_t, const RawBuffer *, size_t>;
+  auto rows = std::vector<row>{};
+  auto sorted = true;
+
+  auto add = [&](const RawBuffer &buffer, size_t index) {
+    auto timestamp = buffer.GetTimestamps()[index];
+    if (sorted && !rows.empty() && std::get<0>(rows.back()) > timestamp) sorted = false;
+    rows.emplace_back(timestamp, &buffer, index);
+  };
+
+  for (const auto &buffer : *state->GetSealedBuffers()) {
+    auto [begin, end] = buffer->GetRange(start_ts, end_ts);
+    for (auto index = begin; index < end; index++) {
+      add(*buffer, index);
+    }
+  }
+
+  // Only the rows published with the state are read from the active buffer
+  const auto &active = *state->GetActiveBuffer();
+  for (size_t index = 0; index < state->GetActiveSize(); index++) {
+    auto timestamp = active.GetTimestamps()[index];
+    if (timestamp >= start_ts && timestamp <= end_ts) add(active, index);
+  }
+
+  if (!sorted) {
+    std::stable_sort(rows.begin(), rows.end(), [](const row &a, const row &b) {
+      return std::get<0>(a) < std::get<0>(b);
+    });
+  }
+
+  for (const auto &[timestamp, buffer, index] : rows) {
+    func(*buffer, index);
+  }
+}
+
+auto RawTable::GetRowsForRange(uint64_t start_ts, uint64_t end_ts) const
+  -> std::vector<char> {
+  auto row_size = std::accumulate(column_widths_.begin(), column_widths_.end(), size_t{});
+  auto rows = std::vector<char>{};
+
+  ForEachRowInOrder_(start_ts, end_ts, [&](const RawBuffer &buffer, size_t index) {
+    rows.resize(rows.size() + row_size);
+    buffer.GetRow(index, rows.data() + rows.size() - row_size);
+  });
+  return rows;
+}
+
+auto RawTable::GetColumnForRange(size_t column, uint64_t start_ts, uint64_t end_ts) const
+  -> std::vector<char> {
+  auto width = column_widths_[column];
+  auto values = std::vector<char>{};
+
+  ForEachRowInOrder_(start_ts, end_ts, [&](const RawBuffer &buffer, size_t index) {
+    const auto *value = buffer.GetValue(column, index);
+    values.insert(values.end(), value, value + width);
+  });
+  return values;
+}
+
+auto RawTable::MemoryUsage() const noexcept -> size_t {
+  return storage_handler_->MemoryUsage();
+}
+
+}
@@ -13,6 +13,15 @@ ThreadPool::ThreadPool() : stop_workers_(false) {
   StartPoolBase_();
 }
 
+auto ThreadPool::GetThreadCount() const noexcept -> size_t {
+  return number_of_threads_;
+}
+
+auto ThreadPool::GetQueuedTaskCount() const noexcept -> size_t {
+  auto lock = std::unique_lock<std::mutex>(pool_mutex_);
+  return tasks_.size();
+}
+
 auto ThreadPool::Restart() noexcept -> void {
   StopWorkersBase_();
   StartPoolBase_();
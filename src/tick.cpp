@@ -1,6 +1,5 @@
 #include "../include/bolt/tick.hpp"
 #include <cmath>
-#include <cstring>
 #include <limits>
 
 namespace bolt {
@@ -30,6 +29,16 @@ Tick::Tick(uint64_t timestamp, double price, uint32_t volume,
   trade_condition_ = trade_condition;
 }
 
+Tick::Tick(const Record<TickSchema> &record) {
+  timestamp_ = record.Get<columns::Timestamp>();
+  price_ = record.Get<columns::Price>();
+  volume_ = record.Get<columns::Volume>();
+
+  symbol_id_ = record.Get<columns::SymbolId>();
+  exchange_id_ = record.Get<columns::ExchangeId>();
+  trade_condition_ = record.Get<columns::TradeCondition>();
+}
+
 auto Tick::operator==(const Tick &other) const noexcept -> bool {
   return check_equality_(other);
 }
@@ -86,12 +95,21 @@ auto Tick::SetTradeCondition(const TradeConditions &trade_condition) noexcept ->
   trade_condition_ = trade_condition;
 }
 
+auto Tick::ToRecord() const noexcept -> Record<TickSchema> {
+  return {
+    timestamp_, symbol_id_, exchange_id_,
+    price_, volume_, trade_condition_
+  };
+}
+
 auto Tick::Serialize(char *buffer) const -> void {
-  std::memcpy(buffer, this, GetSerializedSize());
+  ToRecord().Serialize(buffer);
 }
 
 auto Tick::Deserialize(const char *buffer) -> void {
-  std::memcpy(this, buffer, GetSerializedSize());
+  auto record = Record<TickSchema>();
+  record.Deserialize(buffer);
+  *this = Tick(record);
 }
 
 auto Tick::check_equality_(const Tick &other) const noexcept -> bool {
@@ -0,0 +1,122 @@
+#include "../include/bolt/tick_columns.hpp"
+#include "../include/bolt/range_cursor.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <span>
+
+namespace bolt {
+
+namespace {
+
+template <typename T>
+auto AppendSpan(std::vector<T> &column, std::span<const T> values) -> void {
+  auto offset = column.size();
+  column.resize(offset + values.size());
+
+  if (!values.empty()) {
+    std::memcpy(column.data() + offset, values.data(), values.size_bytes());
+  }
+}
+
+template <typename T>
+auto Permute(std::vector<T> &column, const std::vector<size_t> &indices) -> void {
+  if (column.empty()) return;
+
+  auto permuted = std::vector<T>(indices.size());
+  for (size_t i = 0; i < indices.size(); i++) {
+    permuted[i] = column[indices[i]];
+  }
+  column = std::move(permuted);
+}
+
+}
+
+TickColumns::TickColumns(TickColumn columns) : columns_(columns) {}
+
+auto TickColumns::Size() const noexcept -> size_t {
+  return size_;
+}
+
+auto TickColumns::GetColumns() const noexcept -> TickColumn {
+  return columns_;
+}
+
+auto TickColumns::GetTimestamps() const noexcept -> const std::vector<uint64_t> & {
+  return timestamps_;
+}
+
+auto TickColumns::GetSymbolIds() const noexcept -> const std::vector<uint32_t> & {
+  return symbol_ids_;
+}
+
+auto TickColumns::GetExchangeIds() const noexcept -> const std::vector<uint32_t> & {
+  return exchange_ids_;
+}
+
+auto TickColumns::GetPrices() const noexcept -> const std::vector<double> & {
+  return prices_;
+}
+
+auto TickColumns::GetVolumes() const noexcept -> const std::vector<uint32_t> & {
+  return volumes_;
+}
+
+auto TickColumns::GetTradeConditions() const noexcept
+  -> const std::vector<TradeConditions> & {
+  return trade_conditions_;
+}
+
+auto TickColumns::Has_(TickColumn column) const noexcept -> bool {
+  return (columns_ & column) != TickColumn::kNone;
+}
+
+auto TickColumns::Reserve_(size_t size) -> void {
+  if (Has_(TickColumn::kTimestamp)) timestamps_.reserve(size);
+  if (Has_(TickColumn::kSymbolId)) symbol_ids_.reserve(size);
+  if (Has_(TickColumn::kExchangeId)) exchange_ids_.reserve(size);
+  if (Has_(TickColumn::kPrice)) prices_.reserve(size);
+  if (Has_(TickColumn::kVolume)) volumes_.reserve(size);
+  if (Has_(TickColumn::kTradeCondition)) trade_conditions_.reserve(size);
+}
+
+auto TickColumns::AppendSlice_(const TickSlice &slice) -> void {
+  if (Has_(TickColumn::kTimestamp)) AppendSpan(timestamps_, slice.GetTimestamps());
+  if (Has_(TickColumn::kSymbolId)) AppendSpan(symbol_ids_, slice.GetSymbolIds());
+  if (Has_(TickColumn::kExchangeId)) AppendSpan(exchange_ids_, slice.GetExchangeIds());
+  if (Has_(TickColumn::kVolume)) AppendSpan(volumes_, slice.GetVolumes());
+
+  if (Has_(TickColumn::kTradeCondition)) {
+    AppendSpan(trade_conditions_, slice.GetTradeConditions());
+  }
+
+  if (Has_(TickColumn::kPrice)) {
+    if (!slice.IsFixedPoint()) {
+      AppendSpan(prices_, slice.GetPrices());
+    } else {
+      for (size_t i = 0; i < slice.Size(); i++) {
+        prices_.push_back(slice.GetPrice(i));
+      }
+    }
+  }
+  size_ += slice.Size();
+}
+
+auto TickColumns::SortByTimestamp_(const std::vector<uint64_t> &timestamps) -> void {
+  auto indices = std::vector<size_t>(timestamps.size());
+  std::iota(indices.begin(), indices.end(), 0);
+
+  std::stable_sort(indices.begin(), indices.end(), [&timestamps](size_t a, size_t b) {
+    return timestamps[a] < timestamps[b];
+  });
+
+  Permute(timestamps_, indices);
+  Permute(symbol_ids_, indices);
+  Permute(exchange_ids_, indices);
+  Permute(prices_, indices);
+  Permute(volumes_, indices);
+  Permute(trade_conditions_, indices);
+}
+
+}
@@ -0,0 +1,24 @@
+#include "../include/bolt/tick_page.hpp"
+
+#include "headers/buffer.hpp"
+#include "headers/state.hpp"
+
+namespace bolt {
+
+auto ContinuationToken::HasMore() const noexcept -> bool {
+  return sources_ != nullptr;
+}
+
+auto TickPage::GetTicks() const noexcept -> const std::vector<Tick> & {
+  return ticks_;
+}
+
+auto TickPage::HasMore() const noexcept -> bool {
+  return token_.HasMore();
+}
+
+auto TickPage::GetContinuationToken() const noexcept -> const ContinuationToken & {
+  return token_;
+}
+
+}
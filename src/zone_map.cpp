@@ -0,0 +1,49 @@
+#include "headers/zone_map.hpp"
+
+#include <algorithm>
+
+namespace bolt {
+
+auto ZoneMap::Add(uint32_t symbol_id, uint32_t exchange_id, double price,
+                  uint32_t volume, TradeConditions condition) noexcept -> void {
+  if (count == 0) {
+    min_symbol_id = max_symbol_id = symbol_id;
+    min_exchange_id = max_exchange_id = exchange_id;
+    min_volume = max_volume = volume;
+    min_price = max_price = price;
+  } else {
+    min_symbol_id = std::min(min_symbol_id, symbol_id);
+    max_symbol_id = std::max(max_symbol_id, symbol_id);
+    min_exchange_id = std::min(min_exchange_id, exchange_id);
+    max_exchange_id = std::max(max_exchange_id, exchange_id);
+    min_volume = std::min(min_volume, volume);
+    max_volume = std::max(max_volume, volume);
+    min_price = std::min(min_price, price);
+    max_price = std::max(max_price, price);
+  }
+
+  conditions |= GetConditionBit(condition);
+  count++;
+}
+
+auto ZoneMap::Merge(const ZoneMap &other) noexcept -> void {
+  if (other.count == 0) return;
+
+  if (count == 0) {
+    *this = other;
+    return;
+  }
+
+  min_symbol_id = std::min(min_symbol_id, other.min_symbol_id);
+  max_symbol_id = std::max(max_symbol_id, other.max_symbol_id);
+  min_exchange_id = std::min(min_exchange_id, other.min_exchange_id);
+  max_exchange_id = std::max(max_exchange_id, other.max_exchange_id);
+  min_volume = std::min(min_volume, other.min_volume);
+  max_volume = std::max(max_volume, other.max_volume);
+  min_price = std::min(min_price, other.min_price);
+  max_price = std::max(max_price, other.max_price);
+  conditions |= other.conditions;
+  count += other.count;
+}
+
+}
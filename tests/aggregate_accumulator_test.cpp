@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include "../src/headers/aggregate_accumulator.hpp"
+#include "../include/bolt/aggregate_result.hpp"
+#include <vector>
+
+namespace bolt {
+
+class AggregateAccumulatorTest {
+public:
+  static auto empty_test() -> void {
+    auto accumulator = AggregateAccumulator();
+    EXPECT_EQ(accumulator.GetCount(), 0);
+    EXPECT_TRUE(accumulator.ToResult() == AggregateResult());
+
+    accumulator = AggregateAccumulator(PriceScale(1e-4));
+    EXPECT_TRUE(accumulator.ToResult() == AggregateResult());
+  }
+
+  static auto floating_point_test() -> void {
+    auto accumulator = AggregateAccumulator();
+    accumulator.Add(100.0, 10);
+    accumulator.Add(150.0, 20);
+    accumulator.Add(120.0, 30);
+
+    auto avg_price = (100.0 + 150.0 + 120.0) / 3;
+    auto vwap = (100.0*10 + 150.0*20 + 120.0*30) / 60.0;
+
+    EXPECT_EQ(accumulator.GetCount(), 3);
+    EXPECT_TRUE(accumulator.ToResult() ==
+                AggregateResult(3, 60, 150.0, 100.0, avg_price, vwap));
+  }
+
+  static auto fixed_point_test() -> void {
+    auto accumulator = AggregateAccumulator(PriceScale(1e-4));
+    accumulator.AddFixed(1000001, 3);
+    accumulator.Add(100.0002, 1);
+    accumulator.AddFixed(999999, 0);
+
+    EXPECT_TRUE(accumulator.price_ticks_sum_ == 3000002);
+    EXPECT_TRUE(accumulator.weighted_price_ticks_sum_ == 4000005);
+    EXPECT_EQ(accumulator.min_price_ticks_, 999999);
+    EXPECT_EQ(accumulator.max_price_ticks_, 1000002);
+
+    auto result = accumulator.ToResult();
+    EXPECT_EQ(result.GetCount(), 3);
+    EXPECT_EQ(result.GetTotalVolume(), 4);
+    EXPECT_EQ(result.GetMinPrice(), 99.9999);
+    EXPECT_EQ(result.GetMaxPrice(), 100.0002);
+    EXPECT_DOUBLE_EQ(result.GetVwap(), 100.000125);
+    EXPECT_DOUBLE_EQ(result.GetAvgPrice(), 3000002.0 / 3 / 10000);
+  }
+
+  static auto exact_sums_test() -> void {
+    auto floating = AggregateAccumulator();
+    auto fixed = AggregateAccumulator(PriceScale(1e-4));
+
+    // Large notional values where the double sums start to lose precision
+    for (int i = 0; i < 1000000; i++) {
+      floating.Add(12345.6789, 4000000000U);
+      fixed.Add(12345.6789, 4000000000U);
+    }
+    floating.Add(0.0001, 1);
+    fixed.Add(0.0001, 1);
+
+    auto expected_ticks = (wide_int(123456789) * 4000000000U * 1000000) + 1;
+    EXPECT_TRUE(fixed.weighted_price_ticks_sum_ == expected_ticks);
+    EXPECT_EQ(fixed.ToResult().GetTotalVolume(), floating.ToResult().GetTotalVolume());
+  }
+
+  static auto column_test() -> void {
+    auto prices = std::vector<double>{100.0, 150.0, 120.0, 99.5};
+    auto price_ticks = std::vector<int64_t>{1000000, 1500000, 1200000, 995000};
+    auto volumes = std::vector<uint32_t>{10, 20, 30, 40};
+
+    auto per_row = AggregateAccumulator();
+    auto per_column = AggregateAccumulator();
+    auto fixed_per_row = AggregateAccumulator(PriceScale(1e-4));
+    auto fixed_per_column = AggregateAccumulator(PriceScale(1e-4));
+
+    for (size_t i = 0; i < prices.size(); i++) {
+      per_row.Add(prices[i], volumes[i]);
+      fixed_per_row.AddFixed(price_ticks[i], volumes[i]);
+    }
+
+    // Split in two spans, the second continues the first
+    per_column.Add(std::span(prices).first(1), std::span(volumes).first(1));
+    per_column.Add(std::span(prices).subspan(1), std::span(volumes).subspan(1));
+    per_column.Add(std::span<const double>{}, std::span<const uint32_t>{});
+
+    fixed_per_column.AddFixed(std::span(price_ticks).first(3), std::span(volumes).first(3));
+    fixed_per_column.AddFixed(std::span(price_ticks).subspan(3), std::span(volumes).subspan(3));
+
+    EXPECT_EQ(per_column.GetCount(), 4);
+    EXPECT_TRUE(per_column.ToResult() == per_row.ToResult());
+    EXPECT_TRUE(fixed_per_column.ToResult() == fixed_per_row.ToResult());
+
+    // Floating point prices fed to a fixed-point accumulator are quantised
+    auto quantised = AggregateAccumulator(PriceScale(1e-4));
+    quantised.Add(std::span(prices), std::span(volumes));
+    EXPECT_TRUE(quantised.ToResult() == fixed_per_row.ToResult());
+  }
+
+  static auto merge_test() -> void {
+    auto all = AggregateAccumulator(PriceScale(1e-4));
+    auto first = AggregateAccumulator(PriceScale(1e-4));
+    auto second = AggregateAccumulator(PriceScale(1e-4));
+    auto empty = AggregateAccumulator(PriceScale(1e-4));
+
+    for (int64_t i = 0; i < 10; i++) {
+      all.AddFixed(1000000 + i * 7 % 5, uint32_t(i));
+      (i < 4 ? first : second).AddFixed(1000000 + i * 7 % 5, uint32_t(i));
+    }
+
+    auto merged = AggregateAccumulator(PriceScale(1e-4));
+    merged.Merge(empty);
+    merged.Merge(second);
+    merged.Merge(first);
+    merged.Merge(empty);
+
+    EXPECT_EQ(merged.GetCount(), 10);
+    EXPECT_TRUE(merged.ToResult() == all.ToResult());
+
+    auto floating = AggregateAccumulator();
+    floating.Add(100.0, 10);
+    auto other = AggregateAccumulator();
+    other.Add(150.0, 20);
+    other.Add(120.0, 30);
+
+    floating.Merge(other);
+    auto vwap = (100.0*10 + 150.0*20 + 120.0*30) / 60.0;
+    EXPECT_TRUE(floating.ToResult() ==
+                AggregateResult(3, 60, 150.0, 100.0, (100.0 + 150.0 + 120.0) / 3, vwap));
+  }
+
+  static auto remove_test() -> void {
+    auto accumulator = AggregateAccumulator(PriceScale(1e-4));
+    auto expected = AggregateAccumulator(PriceScale(1e-4));
+
+    accumulator.Add(100.0001, 3);
+    accumulator.Add(99.9999, 5);
+    accumulator.Add(100.0003, 1);
+    accumulator.Remove(99.9999, 5);
+
+    expected.Add(100.0001, 3);
+    expected.Add(100.0003, 1);
+
+    // The sums are exact again, the min price is kept
+    auto result = accumulator.ToResult();
+    EXPECT_EQ(result.GetCount(), 2);
+    EXPECT_EQ(result.GetTotalVolume(), 4);
+    EXPECT_EQ(result.GetVwap(), expected.ToResult().GetVwap());
+    EXPECT_EQ(result.GetAvgPrice(), expected.ToResult().GetAvgPrice());
+    EXPECT_DOUBLE_EQ(result.GetMinPrice(), 99.9999);
+
+    accumulator.Remove(100.0001, 3);
+    accumulator.Remove(100.0003, 1);
+    EXPECT_EQ(accumulator.GetCount(), 0);
+    EXPECT_TRUE(accumulator.ToResult() == AggregateResult());
+
+    auto floating = AggregateAccumulator();
+    floating.Add(100.0, 10);
+    floating.Add(150.0, 20);
+    floating.Remove(100.0, 10);
+    EXPECT_EQ(floating.ToResult().GetVwap(), 150.0);
+    EXPECT_EQ(floating.ToResult().GetAvgPrice(), 150.0);
+  }
+};
+
+}
+
+using namespace bolt;
+
+TEST(AggregateAccumulatorTest, EmptyTest) {
+  AggregateAccumulatorTest::empty_test();
+}
+
+TEST(AggregateAccumulatorTest, FloatingPointTest) {
+  AggregateAccumulatorTest::floating_point_test();
+}
+
+TEST(AggregateAccumulatorTest, FixedPointTest) {
+  AggregateAccumulatorTest::fixed_point_test();
+}
+
+TEST(AggregateAccumulatorTest, ExactSumsTest) {
+  AggregateAccumulatorTest::exact_sums_test();
+}
+
+TEST(AggregateAccumulatorTest, ColumnTest) {
+  AggregateAccumulatorTest::column_test();
+}
+
+TEST(AggregateAccumulatorTest, MergeTest) {
+  AggregateAccumulatorTest::merge_test();
+}
+
+TEST(AggregateAccumulatorTest, RemoveTest) {
+  AggregateAccumulatorTest::remove_test();
+}
@@ -0,0 +1,27 @@
+#include <gtest/gtest.h>
+#include "../include/bolt/as_of_row.hpp"
+
+namespace bolt {
+
+class AsOfRowTest {
+public:
+  static auto getters_test() -> void {
+    auto tick = Tick(100, 10.0, 5, 1, 0);
+
+    auto joined = JoinedTick(tick, Tick(98, 20.0, 1, 2, 0));
+    EXPECT_TRUE(joined.GetLeft() == tick);
+    EXPECT_TRUE(joined.HasMatch());
+    EXPECT_EQ(joined.GetRight()->GetTimestamp(), 98);
+
+    auto unmatched = JoinedQuote(tick, std::nullopt);
+    EXPECT_TRUE(unmatched.GetLeft() == tick);
+    EXPECT_FALSE(unmatched.HasMatch());
+    EXPECT_FALSE(unmatched.GetRight());
+  }
+};
+
+TEST(AsOfRowTest, GettersTest) {
+  AsOfRowTest::getters_test();
+}
+
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "../include/bolt/bar.hpp"
+
+namespace bolt {
+
+class BarTest {
+public:
+  static auto constructor_test() -> void {
+    auto obj = Bar();
+
+    EXPECT_EQ(obj.timestamp_, {});
+    EXPECT_DOUBLE_EQ(obj.open_, {});
+    EXPECT_DOUBLE_EQ(obj.high_, {});
+    EXPECT_DOUBLE_EQ(obj.low_, {});
+    EXPECT_DOUBLE_EQ(obj.close_, {});
+    EXPECT_EQ(obj.volume_, {});
+    EXPECT_DOUBLE_EQ(obj.vwap_, {});
+    EXPECT_EQ(obj.count_, {});
+
+    obj = Bar(60, 10.5, 12.0, 9.5, 11.0, 300, 10.75, 4);
+
+    EXPECT_EQ(obj.timestamp_, 60);
+    EXPECT_DOUBLE_EQ(obj.open_, 10.5);
+    EXPECT_DOUBLE_EQ(obj.high_, 12.0);
+    EXPECT_DOUBLE_EQ(obj.low_, 9.5);
+    EXPECT_DOUBLE_EQ(obj.close_, 11.0);
+    EXPECT_EQ(obj.volume_, 300);
+    EXPECT_DOUBLE_EQ(obj.vwap_, 10.75);
+    EXPECT_EQ(obj.count_, 4);
+  }
+
+  static auto getter_test() -> void {
+    auto obj = Bar(60, 10.5, 12.0, 9.5, 11.0, 300, 10.75, 4);
+
+    EXPECT_EQ(obj.GetTimestamp(), 60);
+    EXPECT_DOUBLE_EQ(obj.GetOpen(), 10.5);
+    EXPECT_DOUBLE_EQ(obj.GetHigh(), 12.0);
+    EXPECT_DOUBLE_EQ(obj.GetLow(), 9.5);
+    EXPECT_DOUBLE_EQ(obj.GetClose(), 11.0);
+    EXPECT_EQ(obj.GetVolume(), 300);
+    EXPECT_DOUBLE_EQ(obj.GetVwap(), 10.75);
+    EXPECT_EQ(obj.GetCount(), 4);
+  }
+
+  static auto setter_test() -> void {
+    auto obj = Bar();
+
+    obj.SetTimestamp(60);
+    obj.SetOpen(10.5);
+    obj.SetHigh(12.0);
+    obj.SetLow(9.5);
+    obj.SetClose(11.0);
+    obj.SetVolume(300);
+    obj.SetVwap(10.75);
+    obj.SetCount(4);
+
+    EXPECT_EQ(obj.timestamp_, 60);
+    EXPECT_DOUBLE_EQ(obj.open_, 10.5);
+    EXPECT_DOUBLE_EQ(obj.high_, 12.0);
+    EXPECT_DOUBLE_EQ(obj.low_, 9.5);
+    EXPECT_DOUBLE_EQ(obj.close_, 11.0);
+    EXPECT_EQ(obj.volume_, 300);
+    EXPECT_DOUBLE_EQ(obj.vwap_, 10.75);
+    EXPECT_EQ(obj.count_, 4);
+  }
+
+  static auto equality_operator_test() -> void {
+    auto obj = Bar(60, 10.5, 12.0, 9.5, 11.0, 300, 10.75, 4);
+    auto obj2 = obj;
+    EXPECT_TRUE(obj2 == obj);
+
+    obj.SetClose(11.5);
+    EXPECT_TRUE(obj2 != obj);
+  }
+};
+
+}
+
+using namespace bolt;
+
+TEST(BarTest, ConstructorTest) {
+  BarTest::constructor_test();
+}
+
+TEST(BarTest, GettersTest) {
+  BarTest::getter_test();
+}
+
+TEST(BarTest, SettersTest) {
+  BarTest::setter_test();
+}
+
+TEST(BarTest, EqualityOperatorTest) {
+  BarTest::equality_operator_test();
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include "../src/headers/basic_buffer.hpp"
+
+namespace bolt {
+
+using FeedSchema = Schema<
+  Column<columns::Timestamp, uint64_t>,
+  Column<columns::ExchangeId, uint16_t>,
+  Column<columns::Price, double>,
+  Column<columns::SequenceNumber, uint64_t>
+>;
+
+using FeedRecord = Record<FeedSchema>;
+using FeedBuffer = BasicBuffer<FeedSchema>;
+
+class BasicBufferTest {
+public:
+  static auto constructors_test() -> void {
+    auto buffer = FeedBuffer(5);
+    EXPECT_EQ(std::get<0>(buffer.columns_).capacity(), 5);
+    EXPECT_EQ(std::get<1>(buffer.columns_).capacity(), 5);
+    EXPECT_EQ(std::get<2>(buffer.columns_).capacity(), 5);
+    EXPECT_EQ(std::get<3>(buffer.columns_).capacity(), 5);
+
+    auto records = std::vector<FeedRecord>{
+      FeedRecord(1001, 1, 100.5, 10),
+      FeedRecord(1002, 2, 100.6, 11)
+    };
+
+    buffer = FeedBuffer(records);
+    EXPECT_EQ(buffer.Size(), 2);
+    EXPECT_TRUE(buffer.GetRecord(0) == records[0]);
+    EXPECT_TRUE(buffer.GetRecord(1) == records[1]);
+  }
+
+  static auto getters_test() -> void {
+    auto buffer = FeedBuffer({
+      FeedRecord(1001, 1, 100.5, 10),
+      FeedRecord(1002, 2, 100.6, 11)
+    });
+
+    EXPECT_EQ(buffer.GetTimestamps(), (std::vector<uint64_t>{1001, 1002}));
+    EXPECT_EQ(buffer.Get<columns::ExchangeId>(), (std::vector<uint16_t>{1, 2}));
+    EXPECT_EQ(buffer.Get<columns::Price>(), (std::vector<double>{100.5, 100.6}));
+    EXPECT_EQ(buffer.Get<columns::SequenceNumber>(), (std::vector<uint64_t>{10, 11}));
+  }
+
+  static auto sort_test() -> void {
+    auto buffer = FeedBuffer({
+      FeedRecord(1003, 3, 100.7, 12),
+      FeedRecord(1001, 1, 100.5, 10),
+      FeedRecord(1002, 2, 100.6, 11)
+    });
+    EXPECT_FALSE(buffer.IsSorted());
+
+    buffer.Sort();
+    EXPECT_TRUE(buffer.IsSorted());
+    EXPECT_EQ(buffer.GetTimestamps(), (std::vector<uint64_t>{1001, 1002, 1003}));
+    EXPECT_EQ(buffer.Get<columns::ExchangeId>(), (std::vector<uint16_t>{1, 2, 3}));
+    EXPECT_EQ(buffer.Get<columns::SequenceNumber>(), (std::vector<uint64_t>{10, 11, 12}));
+
+    buffer.Sort(false);
+    EXPECT_FALSE(buffer.IsSorted());
+    EXPECT_EQ(buffer.Get<columns::Price>(), (std::vector<double>{100.7, 100.6, 100.5}));
+  }
+
+  static auto range_query_test() -> void {
+    auto buffer = FeedBuffer({
+      FeedRecord(1003, 3, 100.7, 12),
+      FeedRecord(1001, 1, 100.5, 10),
+      FeedRecord(1002, 2, 100.6, 11),
+      FeedRecord(1005, 5, 100.9, 14)
+    });
+
+    auto records = buffer.GetForRange(1002, 1004);
+    ASSERT_EQ(records.size(), 2);
+    EXPECT_EQ(records[0].Get<columns::SequenceNumber>(), 11);
+    EXPECT_EQ(records[1].Get<columns::SequenceNumber>(), 12);
+
+    buffer.Sort();
+    EXPECT_EQ(buffer.GetForRange(1000, 1001).size(), 1);
+    EXPECT_EQ(buffer.GetForRange(1002, 1004), records);
+    EXPECT_TRUE(buffer.GetForRange(1006, 1010).empty());
+  }
+
+  static auto insert_row_and_memory_usage_test() -> void {
+    auto buffer = FeedBuffer({
+      FeedRecord(1001, 1, 100.5, 10),
+      FeedRecord(1002, 2, 100.6, 11)
+    });
+
+    auto other = FeedBuffer(4);
+    other.InsertRow(buffer, 1);
+    other.InsertRow(buffer, 0);
+
+    EXPECT_FALSE(other.IsSorted());
+    EXPECT_TRUE(other.GetRecord(0) == buffer.GetRecord(1));
+
+    auto row_size = sizeof(uint64_t) + sizeof(uint16_t) + sizeof(double) + sizeof(uint64_t);
+    EXPECT_EQ(other.MemoryUsage(), sizeof(FeedBuffer) + (4 * row_size));
+
+    auto copy = other.Copy();
+    EXPECT_TRUE(copy == other);
+    EXPECT_FALSE(copy != other);
+  }
+};
+
+}
+
+using namespace bolt;
+
+TEST(BasicBufferTest, ConstructorsTest) {
+  BasicBufferTest::constructors_test();
+}
+
+TEST(BasicBufferTest, GettersTest) {
+  BasicBufferTest::getters_test();
+}
+
+TEST(BasicBufferTest, SortTest) {
+  BasicBufferTest::sort_test();
+}
+
+TEST(BasicBufferTest, RangeQueryTest) {
+  BasicBufferTest::range_query_test();
+}
+
+TEST(BasicBufferTest, InsertRowAndMemoryUsageTest) {
+  BasicBufferTest::insert_row_and_memory_usage_test();
+}
@@ -1,4 +1,7 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
 
 #include "../src/headers/buffer_manager.hpp"
 #include "../src/headers/thread_pool.hpp"
@@ -13,7 +16,6 @@ public:
   static auto simple_insert_test() -> void {
     auto pool = ThreadPool();
     auto manager = BufferManager(pool);
-    manager.maximum_sealed_buffers_ = 5;
 
     auto ticks = std::vector<Tick>{};
     for (int i = 0; i < 3; i++) {
@@ -44,11 +46,38 @@ public:
     EXPECT_EQ(manager.active_buffer_->Size(), 1);
   }
 
-  static auto eviction_occurs() -> void {
+  static auto seal_copies_active_test() -> void {
     auto pool = ThreadPool();
     auto manager = BufferManager(pool);
+    manager.maximum_buffer_size_ = 5;
+
+    // Sorted, and still the active buffer of the states published so far
+    auto active = manager.active_buffer_;
+    for (int i = 0; i < 6; i++) {
+      manager.Insert(Tick(100 * i, 1.1 * i, 10 * i));
+    }
+    manager.pool_.Shutdown();
+
+    ASSERT_EQ(manager.sealed_buffers_->size(), 1);
+    const auto &sealed = manager.sealed_buffers_->front();
+    EXPECT_NE(sealed.get(), active.get());
+    EXPECT_TRUE(sealed->GetSummary());
+    EXPECT_TRUE(sealed->GetZoneMap());
+
+    // Readers of the older states never see it being summarized
+    EXPECT_FALSE(active->GetSummary());
+    EXPECT_FALSE(active->GetZoneMap());
+    EXPECT_FALSE(active->GetPriceSketch());
+    EXPECT_FALSE(active->GetSymbolSketches());
+  }
+
+  static auto eviction_occurs() -> void {
+    auto pool = ThreadPool();
+    auto config = Config();
+    config.SetMemoryBudget(4 * Buffer(2).MemoryUsage());
+
+    auto manager = BufferManager(pool, config);
     manager.maximum_buffer_size_ = 2;
-    manager.maximum_sealed_buffers_ = 2;
 
     for (int round = 0; round < 5; round++) {
       auto ticks = std::vector<Tick>{};
@@ -60,7 +89,205 @@ public:
 
     manager.pool_.Shutdown();
     auto sealed = manager.sealed_buffers_;
-    EXPECT_LE(sealed->size(), 2);
+    EXPECT_FALSE(sealed->empty());
+    EXPECT_LT(sealed->size(), 7);
+
+    EXPECT_LE(manager.MemoryUsage(), config.GetMemoryBudget());
+    EXPECT_EQ(manager.MemoryUsage(),
+              manager.sealed_memory_usage_ + manager.active_buffer_->MemoryUsage());
+
+    // The rollup follows the evictions
+    auto state = manager.GetState();
+    EXPECT_EQ(state->GetRollup().Size(), state->GetSealedBuffers()->size());
+
+    auto rows = size_t{};
+    for (const auto &buffer : *state->GetSealedBuffers()) rows += buffer->Size();
+    EXPECT_EQ(state->GetRollup().Query(0, state->GetRollup().Size()).GetCount(), rows);
+  }
+
+  static auto lowered_budget_test() -> void {
+    auto pool = ThreadPool();
+    auto manager = BufferManager(pool);
+
+    manager.SetNewState_(create_buffer({1, 2}));
+    manager.SetNewState_(create_buffer({3, 4}));
+    manager.SetNewState_(create_buffer({5, 6}));
+    ASSERT_EQ(manager.GetState()->GetSealedBuffers()->size(), 3);
+
+    // The oldest buffers are evicted right away, not only with the next sealed one
+    manager.SetMemoryBudget(manager.MemoryUsage() - 1);
+    auto state = manager.GetState();
+    ASSERT_EQ(state->GetSealedBuffers()->size(), 2);
+    EXPECT_EQ(state->GetSealedBuffers()->front()->GetTimestamps().front(), 3);
+    EXPECT_LT(manager.MemoryUsage(), manager.memory_budget_);
+  }
+
+  static auto no_eviction_under_budget_test() -> void {
+    auto pool = ThreadPool();
+    auto manager = BufferManager(pool);
+    manager.maximum_buffer_size_ = 2;
+
+    auto ticks = std::vector<Tick>{};
+    for (int i = 0; i < 20; i++) {
+      ticks.emplace_back(i, 1.1 * i, 10 * i);
+    }
+
+    manager.Insert(ticks);
+    manager.pool_.Shutdown();
+
+    EXPECT_EQ(manager.sealed_buffers_->size(), 10);
+    EXPECT_EQ(manager.GetState()->GetSealedBuffers()->front()->GetTimestamps().front(), 0);
+  }
+
+  static auto retention_expiry_test() -> void {
+    auto pool = ThreadPool();
+    auto config = Config();
+    config.SetRetentionPeriod(10);
+
+    auto manager = BufferManager(pool, config);
+    manager.maximum_buffer_size_ = 4;
+
+    auto ticks = std::vector<Tick>{};
+    for (int i = 0; i < 40; i++) {
+      ticks.emplace_back(i, 1.1 * i, 10 * i);
+    }
+
+    manager.Insert(ticks);
+    manager.pool_.Shutdown();
+
+    auto state = manager.GetState();
+    EXPECT_EQ(state->GetRetentionHorizon(), 29);
+
+    // Only whole buffers behind the horizon are dropped, {28, 29, 30, 31} stays
+    const auto &sealed = *state->GetSealedBuffers();
+    ASSERT_EQ(sealed.size(), 3);
+    EXPECT_EQ(sealed.front()->GetTimestamps().front(), 28);
+    EXPECT_EQ(sealed.back()->GetTimestamps().back(), 39);
+    EXPECT_EQ(manager.earliest_sealed_expiry_, 31);
+  }
+
+  static auto background_expiry_test() -> void {
+    auto pool = ThreadPool();
+    auto config = Config();
+    config.SetRetentionPeriod(1'000'000);
+    config.SetExpiryInterval(1);
+
+    auto manager = BufferManager(pool, config);
+    manager.maximum_buffer_size_ = 4;
+    EXPECT_TRUE(manager.expiry_thread_.joinable());
+
+    auto ticks = std::vector<Tick>{};
+    for (int i = 0; i < 10; i++) {
+      ticks.emplace_back(i, 1.1 * i, 10 * i);
+    }
+    manager.Insert(ticks);
+
+    // Nothing is ingested anymore, the horizon still moves past the sealed buffers
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    auto expired = [&manager] {
+      auto state = manager.GetState();
+      return state->GetActiveSize() == 2 && state->GetRetentionHorizon() > 7 &&
+             state->GetSealedBuffers()->empty();
+    };
+    while (!expired() && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    auto state = manager.GetState();
+    EXPECT_TRUE(state->GetSealedBuffers()->empty());
+    EXPECT_GT(state->GetRetentionHorizon(), 7);
+    EXPECT_EQ(state->GetActiveSize(), 2);
+    EXPECT_EQ(manager.sealed_memory_usage_, 0);
+
+    // Without an interval no expiry task is started
+    auto idle_manager = BufferManager(pool);
+    EXPECT_FALSE(idle_manager.expiry_thread_.joinable());
+
+    // The queued expiry tasks run before the managers are destroyed
+    pool.Shutdown();
+  }
+
+  static auto late_ingest_expiry_test() -> void {
+    auto pool = ThreadPool();
+    auto config = Config();
+    config.SetRetentionPeriod(50'000'000);
+    config.SetExpiryInterval(60'000);
+
+    auto manager = BufferManager(pool, config);
+    manager.Insert(Tick(100, 1.1, 10));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_GT(manager.GetRetentionHorizon_(), 0);
+
+    // A replayed tick does not move the latest timestamp, the feed is still active
+    manager.Insert(Tick(50, 1.2, 20));
+    EXPECT_EQ(manager.GetRetentionHorizon_(), 0);
+
+    pool.Shutdown();
+  }
+
+  static auto compaction_test() -> void {
+    auto pool = ThreadPool();
+    auto manager = BufferManager(pool);
+    manager.maximum_buffer_size_ = 4;
+
+    // {0, 10, 20, 30}, {15, 25, 35, 45} overlap, {50} and {70} are undersized
+    manager.SetNewState_(create_buffer({0, 10, 20, 30}));
+    manager.SetNewState_(create_buffer({15, 25, 35, 45}));
+    manager.SetNewState_(create_buffer({50}));
+    manager.SetNewState_(create_buffer({70}));
+    manager.SetNewState_(create_buffer({100, 110, 120, 130}));
+
+    manager.Compact_();
+    pool.Shutdown();
+
+    auto sealed = manager.GetState()->GetSealedBuffers();
+    ASSERT_EQ(sealed->size(), 4);
+
+    check_timestamps_(sealed->at(0), {0, 10, 15, 20});
+    check_timestamps_(sealed->at(1), {25, 30, 35, 45});
+    check_timestamps_(sealed->at(2), {50, 70});
+    check_timestamps_(sealed->at(3), {100, 110, 120, 130});
+
+    auto memory_usage = size_t{};
+    for (const auto &buffer : *sealed) memory_usage += buffer->MemoryUsage();
+    EXPECT_EQ(manager.sealed_memory_usage_, memory_usage);
+
+    // The merged buffers are summarized again
+    for (size_t i = 0; i < 3; i++) {
+      ASSERT_TRUE(sealed->at(i)->GetSummary());
+      EXPECT_EQ(sealed->at(i)->GetSummary()->GetCount(), sealed->at(i)->Size());
+    }
+  }
+
+  static auto compaction_on_seal_test() -> void {
+    auto pool = ThreadPool();
+    auto manager = BufferManager(pool);
+    manager.maximum_buffer_size_ = 5;
+
+    // Every other batch arrives late and overlaps the previously sealed buffer
+    auto ticks = std::vector<Tick>{};
+    for (int round = 0; round < 10; round++) {
+      auto base = (round % 2 == 0) ? round * 100 : (round - 1) * 100 + 5;
+      for (int i = 0; i < 5; i++) {
+        ticks.emplace_back(base + (i * 20), 1.0, 1);
+      }
+    }
+    manager.Insert(ticks);
+    pool.Shutdown();
+
+    auto sealed = manager.GetState()->GetSealedBuffers();
+    ASSERT_EQ(sealed->size(), 10);
+
+    for (size_t i = 0; i < sealed->size(); i++) {
+      const auto &ts_list = sealed->at(i)->GetTimestamps();
+      EXPECT_TRUE(std::is_sorted(ts_list.begin(), ts_list.end()));
+
+      if (i > 0) {
+        EXPECT_LE(sealed->at(i - 1)->GetTimestamps().back(), ts_list.front());
+      }
+      ASSERT_TRUE(sealed->at(i)->GetSummary());
+      EXPECT_EQ(sealed->at(i)->GetSummary()->GetCount(), ts_list.size());
+    }
   }
 
   static auto get_state_test() -> void {
@@ -77,6 +304,22 @@ public:
     EXPECT_EQ(state->GetActiveBuffer()->Size(), 3);
     EXPECT_EQ(state->GetActiveBuffer()->GetTimestamps().back(), 101);
   }
+
+private:
+  static auto create_buffer(const std::vector<uint64_t> &timestamps)
+    -> std::shared_ptr<Buffer> {
+
+    auto buffer = std::make_shared<Buffer>(timestamps.size());
+    for (const auto &ts : timestamps) {
+      buffer->InsertTick(Tick(ts, 1.0, 1));
+    }
+    return buffer;
+  }
+
+  static auto check_timestamps_(const std::shared_ptr<Buffer> &buffer,
+                                const std::vector<uint64_t> &timestamps) -> void {
+    EXPECT_EQ(buffer->GetTimestamps(), timestamps);
+  }
 };
 
 }
@@ -91,10 +334,42 @@ TEST(BufferManagerTest, TriggerSealingTest) {
   BufferManagerTest::trigger_sealing_test();
 }
 
+TEST(BufferManagerTest, SealCopiesActiveTest) {
+  BufferManagerTest::seal_copies_active_test();
+}
+
 TEST(BufferManagerTest, EvictionOccursTest) {
   BufferManagerTest::eviction_occurs();
 }
 
+TEST(BufferManagerTest, NoEvictionUnderBudgetTest) {
+  BufferManagerTest::no_eviction_under_budget_test();
+}
+
+TEST(BufferManagerTest, RetentionExpiryTest) {
+  BufferManagerTest::retention_expiry_test();
+}
+
+TEST(BufferManagerTest, LoweredBudgetTest) {
+  BufferManagerTest::lowered_budget_test();
+}
+
+TEST(BufferManagerTest, BackgroundExpiryTest) {
+  BufferManagerTest::background_expiry_test();
+}
+
+TEST(BufferManagerTest, LateIngestExpiryTest) {
+  BufferManagerTest::late_ingest_expiry_test();
+}
+
+TEST(BufferManagerTest, CompactionTest) {
+  BufferManagerTest::compaction_test();
+}
+
+TEST(BufferManagerTest, CompactionOnSealTest) {
+  BufferManagerTest::compaction_on_seal_test();
+}
+
 TEST(BufferManagerTest, GetStateTest) {
   BufferManagerTest::get_state_test();
 }
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include "../src/headers//buffer.hpp"
 #include "../include/bolt/tick.hpp"
+#include "../include/bolt/aggregate_result.hpp"
 
 namespace bolt {
 
@@ -104,6 +105,17 @@ public:
     check_columns_equality_(buffer.trace_conditions_, buffer.GetTraceCondtions());
   }
 
+  static auto get_tick_test() -> void {
+    auto ticks = std::vector<Tick> {
+      Tick(1001, 100.01, 100, 1, 2, TradeConditions::kAcquisition),
+      Tick(1002, 100.02, 101, 2, 3, TradeConditions::kCashSale)
+    };
+
+    auto buffer = Buffer(ticks);
+    EXPECT_EQ(buffer.GetTick(0), ticks[0]);
+    EXPECT_EQ(buffer.GetTick(1), ticks[1]);
+  }
+
   static auto store_tick_test() -> void {
     auto buffer = Buffer();
     buffer.InsertTick(Tick(1001, 100.001, 100, 1, 2, TradeConditions::kCashSale));
@@ -169,6 +181,166 @@ public:
     });
   }
 
+  static auto sorted_copy_test() -> void {
+    auto buffer = Buffer({
+      Tick(1003, 100.03, 103),
+      Tick(1001, 100.01, 101),
+      Tick(1002, 100.02, 102)
+    });
+    const auto *timestamps = buffer.timestamps_.data();
+
+    auto sorted = buffer.SortedCopy();
+    EXPECT_TRUE(sorted.IsSorted());
+    check_columns_equality_(sorted.timestamps_, {1001, 1002, 1003});
+    check_columns_equality_(sorted.volumes_, {101, 102, 103});
+
+    // The source buffer is left untouched
+    EXPECT_FALSE(buffer.IsSorted());
+    EXPECT_EQ(buffer.timestamps_.data(), timestamps);
+    check_columns_equality_(buffer.timestamps_, {1003, 1001, 1002});
+  }
+
+  static auto summary_test() -> void {
+    auto buffer = Buffer({
+      Tick(1003, 100.0, 10),
+      Tick(1001, 150.0, 20),
+      Tick(1002, 120.0, 30)
+    });
+    EXPECT_FALSE(buffer.GetSummary());
+
+    buffer.ComputeSummary();
+    ASSERT_TRUE(buffer.GetSummary());
+
+    auto vwap = (100.0*10 + 150.0*20 + 120.0*30) / 60.0;
+    EXPECT_TRUE(buffer.GetSummary()->ToResult() ==
+                AggregateResult(3, 60, 150.0, 100.0, (100.0 + 150.0 + 120.0) / 3, vwap));
+
+    // Kept by copies, discarded once a row is appended
+    EXPECT_TRUE(buffer.Copy().GetSummary());
+    buffer.InsertTick(Tick(1004, 110.0, 1));
+    EXPECT_FALSE(buffer.GetSummary());
+
+    auto fixed = Buffer(2, PriceScale(1e-4));
+    fixed.InsertTick(Tick(1001, 100.0001, 1));
+    fixed.InsertTick(Tick(1002, 100.0003, 1));
+    fixed.ComputeSummary();
+
+    EXPECT_EQ(fixed.GetSummary()->ToResult().GetMaxPrice(), 100.0003);
+    EXPECT_EQ(fixed.GetSummary()->ToResult().GetAvgPrice(), 100.0002);
+  }
+
+  static auto block_summaries_test() -> void {
+    auto buffer = Buffer(1000, PriceScale(1e-2));
+    for (uint64_t i = 0; i < 1000; i++) {
+      buffer.InsertTick(Tick(i, 10.0 + double(i % 17) / 100, uint32_t(i % 7)));
+    }
+
+    // Computed on the fly without summaries
+    auto scanned = std::vector<AggregateResult>{};
+    auto ranges = std::vector<std::pair<size_t, size_t>>{
+      {0, 1000}, {0, 256}, {1, 255}, {100, 900}, {256, 768}, {300, 301}, {700, 1000}
+    };
+    for (auto [begin, end] : ranges) {
+      scanned.push_back(buffer.Summarize(begin, end).ToResult());
+    }
+
+    buffer.ComputeSummary();
+    EXPECT_EQ(buffer.GetBlockSummaries().size(), 4);
+    EXPECT_EQ(buffer.GetBlockSummaries().back().GetCount(), 1000 - 3 * 256);
+
+    for (size_t i = 0; i < ranges.size(); i++) {
+      auto [begin, end] = ranges[i];
+      EXPECT_EQ(buffer.Summarize(begin, end).GetCount(), end - begin);
+      EXPECT_TRUE(buffer.Summarize(begin, end).ToResult() == scanned[i]);
+    }
+  }
+
+  static auto zone_maps_test() -> void {
+    auto buffer = Buffer(600, PriceScale(1e-2));
+    for (uint64_t i = 0; i < 600; i++) {
+      auto condition = i < 256 ? TradeConditions::kRegularSale : TradeConditions::kOddLotTrade;
+      buffer.InsertTick(Tick(i, 10.0 + double(i) / 100, uint32_t(i % 7), i / 100, 2, condition));
+    }
+    EXPECT_FALSE(buffer.GetZoneMap());
+
+    buffer.ComputeSummary();
+    ASSERT_TRUE(buffer.GetZoneMap());
+    ASSERT_EQ(buffer.GetBlockZoneMaps().size(), 3);
+
+    const auto &zone_map = *buffer.GetZoneMap();
+    EXPECT_EQ(zone_map.count, 600);
+    EXPECT_EQ(zone_map.min_symbol_id, 0);
+    EXPECT_EQ(zone_map.max_symbol_id, 5);
+    EXPECT_EQ(zone_map.min_exchange_id, 2);
+    EXPECT_EQ(zone_map.max_exchange_id, 2);
+    EXPECT_EQ(zone_map.min_volume, 0);
+    EXPECT_EQ(zone_map.max_volume, 6);
+    EXPECT_DOUBLE_EQ(zone_map.min_price, 10.0);
+    EXPECT_DOUBLE_EQ(zone_map.max_price, 15.99);
+
+    const auto &first = buffer.GetBlockZoneMaps().front();
+    EXPECT_EQ(first.count, 256);
+    EXPECT_EQ(first.max_symbol_id, 2);
+    EXPECT_DOUBLE_EQ(first.max_price, 12.55);
+    EXPECT_EQ(first.conditions, GetConditionBit(TradeConditions::kRegularSale));
+    EXPECT_EQ(buffer.GetBlockZoneMaps().back().count, 600 - 2 * 256);
+    EXPECT_EQ(zone_map.conditions, GetConditionBit(TradeConditions::kRegularSale) |
+                                   GetConditionBit(TradeConditions::kOddLotTrade));
+
+    // Appending a row discards them
+    buffer.InsertTick(Tick(600, 1.0, 1));
+    EXPECT_FALSE(buffer.GetZoneMap());
+    EXPECT_TRUE(buffer.GetBlockZoneMaps().empty());
+  }
+
+  static auto quantile_sketches_test() -> void {
+    auto buffer = Buffer(100, PriceScale(1e-2));
+    for (uint64_t i = 0; i < 100; i++) {
+      buffer.InsertTick(Tick(i, 10.0 + double(i) / 100, uint32_t(i % 10)));
+    }
+    EXPECT_FALSE(buffer.GetPriceSketch());
+
+    buffer.ComputeSummary();
+    ASSERT_TRUE(buffer.GetPriceSketch());
+    ASSERT_TRUE(buffer.GetVolumeSketch());
+    EXPECT_EQ(buffer.GetPriceSketch()->Count(), 100);
+
+    auto qs = std::vector<double>{0.0, 0.5, 1.0};
+    EXPECT_EQ(buffer.GetPriceSketch()->Quantiles(qs), (std::vector<double>{10.0, 10.49, 10.99}));
+    EXPECT_EQ(buffer.GetVolumeSketch()->Quantiles(qs), (std::vector<double>{0.0, 4.0, 9.0}));
+
+    // Kept by copies, discarded once a row is appended
+    EXPECT_TRUE(buffer.Copy().GetPriceSketch());
+    buffer.InsertTick(Tick(100, 1.0, 1));
+    EXPECT_FALSE(buffer.GetPriceSketch());
+    EXPECT_FALSE(buffer.GetVolumeSketch());
+  }
+
+  static auto symbol_sketches_test() -> void {
+    auto buffer = Buffer(600);
+    for (uint64_t i = 0; i < 600; i++) {
+      buffer.InsertTick(Tick(i, 10.0, 1, uint32_t(i % 50), uint32_t(i % 3 == 0 ? 7 : 2)));
+    }
+    EXPECT_FALSE(buffer.GetSymbolSketches());
+
+    buffer.ComputeSummary();
+    ASSERT_TRUE(buffer.GetSymbolSketches());
+
+    // Sorted by exchange id
+    const auto &sketches = *buffer.GetSymbolSketches();
+    ASSERT_EQ(sketches.size(), 2);
+    EXPECT_EQ(sketches[0].exchange_id, 2);
+    EXPECT_EQ(sketches[1].exchange_id, 7);
+
+    // Every symbol trades on both exchanges
+    EXPECT_EQ(sketches[0].symbols.Count(), 50);
+    EXPECT_EQ(sketches[1].symbols.Count(), 50);
+
+    EXPECT_TRUE(buffer.Copy().GetSymbolSketches());
+    buffer.InsertTick(Tick(600, 1.0, 1));
+    EXPECT_FALSE(buffer.GetSymbolSketches());
+  }
+
   static auto copy_test() -> void {
     auto buffer = Buffer({
       Tick(1001, 100.01, 100, 1, 2, TradeConditions::kAcquisition)
@@ -194,6 +366,53 @@ public:
     EXPECT_FALSE(buffer.IsSorted());
   }
 
+  static auto fixed_point_price_test() -> void {
+    auto buffer = Buffer(2, PriceScale(1e-4));
+    EXPECT_EQ(buffer.price_ticks_.capacity(), 2);
+    EXPECT_EQ(buffer.prices_.capacity(), 0);
+
+    buffer.InsertTick(Tick(1002, 100.0123, 100, 1, 2, TradeConditions::kCashSale));
+    buffer.InsertTick(Tick(1001, 99.5, 101, 2, 3, TradeConditions::kAcquisition));
+
+    EXPECT_TRUE(buffer.GetPrices().empty());
+    check_columns_equality_(buffer.GetPriceTicks(), {1000123, 995000});
+
+    EXPECT_EQ(buffer.GetPrice(0), 100.0123);
+    EXPECT_EQ(buffer.GetTick(1),
+              Tick(1001, 99.5, 101, 2, 3, TradeConditions::kAcquisition));
+
+    buffer.Sort();
+    check_columns_equality_(buffer.price_ticks_, {995000, 1000123});
+    EXPECT_TRUE(buffer.IsSorted());
+
+    // Rows are copied without going through double
+    auto other = Buffer(1, PriceScale(1e-4));
+    other.InsertRow(buffer, 1);
+    check_columns_equality_(other.price_ticks_, {1000123});
+
+    auto copy = buffer.Copy();
+    check_buffer_equality_(copy, buffer);
+    EXPECT_FALSE(copy == Buffer({buffer.GetTick(0), buffer.GetTick(1)}));
+  }
+
+  static auto memory_usage_test() -> void {
+    auto buffer = Buffer();
+    auto empty_usage = buffer.MemoryUsage();
+    EXPECT_EQ(empty_usage, sizeof(Buffer));
+
+    buffer = Buffer(100);
+    auto row_size = sizeof(uint64_t) + (sizeof(uint32_t) * 3)
+      + sizeof(double) + sizeof(TradeConditions);
+    EXPECT_EQ(buffer.MemoryUsage(), empty_usage + (100 * row_size));
+
+    // Reserved capacity is accounted for, not just the stored rows
+    buffer.InsertTick(Tick(1001, 100.01, 100));
+    EXPECT_EQ(buffer.MemoryUsage(), empty_usage + (100 * row_size));
+
+    buffer = Buffer(100, PriceScale(1e-4));
+    EXPECT_EQ(buffer.MemoryUsage(), empty_usage + (100 * row_size));
+  }
+
 private:
   static auto check_buffer_tick_equality_(const Buffer &buffer,
                                           const std::vector<Tick> &ticks) -> void {
@@ -216,6 +435,7 @@ private:
 
     check_columns_equality_(buffer1.timestamps_, buffer2.timestamps_);
     check_columns_equality_(buffer1.prices_, buffer2.prices_);
+    check_columns_equality_(buffer1.price_ticks_, buffer2.price_ticks_);
     check_columns_equality_(buffer1.volumes_, buffer2.volumes_);
 
     check_columns_equality_(buffer1.symbol_ids_, buffer2.symbol_ids_);
@@ -252,6 +472,10 @@ TEST(BufferTest, GettersTest) {
   BufferTest::getters_test();
 }
 
+TEST(BufferTest, GetTickTest) {
+  BufferTest::get_tick_test();
+}
+
 TEST(BufferTest, StoreTickTest) {
   BufferTest::store_tick_test();
 }
@@ -260,6 +484,30 @@ TEST(BufferTest, SortTest) {
   BufferTest::sort_test();
 }
 
+TEST(BufferTest, SortedCopyTest) {
+  BufferTest::sorted_copy_test();
+}
+
+TEST(BufferTest, SummaryTest) {
+  BufferTest::summary_test();
+}
+
+TEST(BufferTest, BlockSummariesTest) {
+  BufferTest::block_summaries_test();
+}
+
+TEST(BufferTest, ZoneMapsTest) {
+  BufferTest::zone_maps_test();
+}
+
+TEST(BufferTest, QuantileSketchesTest) {
+  BufferTest::quantile_sketches_test();
+}
+
+TEST(BufferTest, SymbolSketchesTest) {
+  BufferTest::symbol_sketches_test();
+}
+
 TEST(BufferTest, CopyMethodTest) {
   BufferTest::copy_test();
 }
@@ -267,3 +515,11 @@ TEST(BufferTest, CopyMethodTest) {
 TEST(BufferTest, IsSortedTest) {
   BufferTest::is_sorted_test();
 }
+
+TEST(BufferTest, FixedPointPriceTest) {
+  BufferTest::fixed_point_price_test();
+}
+
+TEST(BufferTest, MemoryUsageTest) {
+  BufferTest::memory_usage_test();
+}
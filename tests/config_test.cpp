@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include "../include/bolt/config.hpp"
+#include "../src/headers/constants.hpp"
+
+namespace bolt {
+
+class ConfigTest {
+public:
+  static auto constructor_test() -> void {
+    auto config = Config();
+    EXPECT_EQ(config.memory_budget_, Constants::kDEFAULT_MEMORY_BUDGET);
+    EXPECT_DOUBLE_EQ(config.quote_memory_share_, Constants::kDEFAULT_QUOTE_MEMORY_SHARE);
+    EXPECT_DOUBLE_EQ(config.table_memory_share_, Constants::kDEFAULT_TABLE_MEMORY_SHARE);
+    EXPECT_EQ(config.retention_period_, 0);
+    EXPECT_EQ(config.expiry_interval_, 0);
+    EXPECT_DOUBLE_EQ(config.price_scale_, 0);
+    EXPECT_EQ(config.parallel_query_threshold_, Constants::kDEFAULT_PARALLEL_QUERY_THRESHOLD);
+  }
+
+  static auto setters_and_getters_test() -> void {
+    auto config = Config();
+
+    config.SetMemoryBudget(1024);
+    EXPECT_EQ(config.memory_budget_, 1024);
+    EXPECT_EQ(config.GetMemoryBudget(), 1024);
+
+    config.SetQuoteMemoryShare(0.5);
+    EXPECT_DOUBLE_EQ(config.quote_memory_share_, 0.5);
+    EXPECT_DOUBLE_EQ(config.GetQuoteMemoryShare(), 0.5);
+    config.SetQuoteMemoryShare(2.0);
+    EXPECT_DOUBLE_EQ(config.GetQuoteMemoryShare(), 1.0);
+
+    config.SetTableMemoryShare(0.2);
+    EXPECT_DOUBLE_EQ(config.table_memory_share_, 0.2);
+    EXPECT_DOUBLE_EQ(config.GetTableMemoryShare(), 0.2);
+    config.SetTableMemoryShare(-1.0);
+    EXPECT_DOUBLE_EQ(config.GetTableMemoryShare(), 0.0);
+
+    config.SetRetentionPeriod(4000);
+    EXPECT_EQ(config.retention_period_, 4000);
+    EXPECT_EQ(config.GetRetentionPeriod(), 4000);
+
+    config.SetExpiryInterval(250);
+    EXPECT_EQ(config.expiry_interval_, 250);
+    EXPECT_EQ(config.GetExpiryInterval(), 250);
+
+    config.SetPriceScale(1e-4);
+    EXPECT_DOUBLE_EQ(config.price_scale_, 1e-4);
+    EXPECT_DOUBLE_EQ(config.GetPriceScale(), 1e-4);
+
+    config.SetParallelQueryThreshold(50000);
+    EXPECT_EQ(config.parallel_query_threshold_, 50000);
+    EXPECT_EQ(config.GetParallelQueryThreshold(), 50000);
+  }
+};
+
+}
+
+using namespace bolt;
+
+TEST(ConfigTest, ConstructorTest) {
+  ConfigTest::constructor_test();
+}
+
+TEST(ConfigTest, SettersAndGettersTest) {
+  ConfigTest::setters_and_getters_test();
+}
@@ -1,13 +1,25 @@
 #include <gtest/gtest.h>
 #include <algorithm>
+#include <future>
+#include <limits>
+#include <set>
+#include <thread>
 
 #include "../include/bolt/database.hpp"
 #include "../include/bolt/tick.hpp"
 #include "../include/bolt/aggregate_result.hpp"
+#include "../include/bolt/bar.hpp"
+#include "../include/bolt/quote.hpp"
+#include "../include/bolt/quote_aggregate_result.hpp"
 
+#include "../src/headers/aggregate_accumulator.hpp"
 #include "../src/headers/buffer_manager.hpp"
 #include "../src/headers/buffer.hpp"
+#include "../src/headers/basic_buffer.hpp"
 #include "../src/headers/state.hpp"
+#include "../src/headers/subscription.hpp"
+#include "../src/headers/thread_pool.hpp"
+#include "../src/headers/constants.hpp"
 
 namespace bolt {
 
@@ -47,6 +59,16 @@ public:
     EXPECT_EQ(range_data.front().GetTimestamp(), 100);
     EXPECT_EQ(range_data.back().GetTimestamp(), 102);
 
+    // {100, 101, 102} and {100} are sorted runs, out of order with each other
+    auto collect = [](const Buffer &buffer, size_t begin, size_t end, bool,
+                      std::vector<Tick> &ticks) {
+      for (auto i = begin; i < end; i++) ticks.push_back(buffer.GetTick(i));
+    };
+    auto state = db.storage_handler_->GetState();
+    EXPECT_FALSE(db.GetTicksFromActiveBuffer_(state, 100, 103, collect).first);
+    EXPECT_TRUE(db.GetTicksFromActiveBuffer_(state, 101, 102, collect).first);
+    EXPECT_TRUE(db.GetTicksFromActiveBuffer_(state, 99, 99, collect).first);
+
     range_data = db.GetForRange(99, 105, [](const Tick &tick) {
       return tick.GetVolume() >= 3;
     });
@@ -126,6 +148,103 @@ public:
     db.Flush();
   }
 
+  static auto memory_budget_test() -> void {
+    auto config = Config();
+    config.SetMemoryBudget(1024 * 1024);
+
+    auto db = Database(config);
+    auto ticks = std::vector<Tick>{};
+    for (uint64_t i = 1; i <= 60000; i++) {
+      ticks.emplace_back(i, 1.0, 1);
+    }
+    db.Insert(ticks);
+    db.Flush();
+
+    EXPECT_LE(db.MemoryUsage(), config.GetMemoryBudget());
+    EXPECT_GT(db.Size(), 0);
+    EXPECT_LT(db.Size(), 60000);
+
+    // The oldest data is evicted first
+    EXPECT_TRUE(db.GetForRange(1, 100).empty());
+    EXPECT_EQ(db.GetForRange(59901, 60000).size(), 100);
+  }
+
+  static auto shared_memory_budget_test() -> void {
+    auto config = Config();
+    config.SetMemoryBudget(4 * 1024 * 1024);
+    config.SetQuoteMemoryShare(0.5);
+
+    auto db = Database(config);
+    auto ticks = std::vector<Tick>{};
+    auto quotes = std::vector<Quote>{};
+    for (uint64_t i = 1; i <= 150000; i++) {
+      ticks.emplace_back(i, 1.0, 1);
+      quotes.emplace_back(i, 1.0, 1, 1.1, 1, 1, 1);
+    }
+    db.Insert(ticks);
+    db.Insert(quotes);
+    db.Flush();
+
+    // Both tables evict within their own part, never above the whole budget
+    EXPECT_LE(db.storage_handler_->MemoryUsage(), config.GetMemoryBudget() / 2);
+    EXPECT_LE(db.quote_storage_handler_->MemoryUsage(), config.GetMemoryBudget() / 2);
+    EXPECT_LE(db.MemoryUsage(), config.GetMemoryBudget());
+    EXPECT_LT(db.Size(), 150000);
+    EXPECT_TRUE(db.GetQuotesForRange(1, 100).empty());
+  }
+
+  static auto retention_period_test() -> void {
+    auto config = Config();
+    config.SetRetentionPeriod(100);
+
+    auto db = Database(config);
+    auto ticks = std::vector<Tick>{};
+    for (uint64_t i = 1; i <= 25000; i++) {
+      ticks.emplace_back(i, 1.0, 1);
+    }
+    db.Insert(ticks);
+    db.Flush();
+
+    // Whole expired buffers are gone, the boundary buffer is trimmed at query time
+    EXPECT_LT(db.Size(), 20000);
+
+    auto range_data = db.GetForRange(0, 30000);
+    ASSERT_EQ(range_data.size(), 101);
+    EXPECT_EQ(range_data.front().GetTimestamp(), 24900);
+    EXPECT_EQ(range_data.back().GetTimestamp(), 25000);
+
+    auto result = db.Aggregate(0, 24950);
+    EXPECT_EQ(result.GetCount(), 51);
+  }
+
+  static auto fixed_point_price_test() -> void {
+    auto config = Config();
+    config.SetPriceScale(1e-4);
+
+    auto db = Database(config);
+    db.Insert({
+      Tick(100, 100.0001, 10),
+      Tick(101, 100.0002, 20),
+      Tick(102, 100.0003, 30)
+    });
+    db.Flush();
+
+    auto state = db.storage_handler_->GetState();
+    EXPECT_TRUE(state->GetActiveBuffer()->GetPrices().empty());
+    EXPECT_EQ(state->GetActiveBuffer()->GetPriceTicks().size(), 3);
+
+    auto range_data = db.GetForRange(100, 102);
+    ASSERT_EQ(range_data.size(), 3);
+    EXPECT_EQ(range_data[1].GetPrice(), 100.0002);
+
+    // (1000001*10 + 1000002*20 + 1000003*30) / 60 = 1000002 + 1/3 ticks
+    auto result = db.Aggregate(100, 102);
+    EXPECT_EQ(result.GetMinPrice(), 100.0001);
+    EXPECT_EQ(result.GetMaxPrice(), 100.0003);
+    EXPECT_EQ(result.GetAvgPrice(), 100.0002);
+    EXPECT_DOUBLE_EQ(result.GetVwap(), (1000002.0 + (1.0 / 3)) / 10000);
+  }
+
   static auto aggregate_result_test() -> void {
     auto db = Database();
     db.Insert({
@@ -178,6 +297,883 @@ public:
     EXPECT_DOUBLE_EQ(result.GetVwap(), 110.0);
   }
 
+  static auto sealed_aggregate_test() -> void {
+    auto db = Database();
+    auto n = size_t(Constants::kMAXIMUM_SEALED_BUFFER_SIZE) + 10;
+
+    // The active buffer ends up unsorted, the rows are aggregated in storage order
+    auto ticks = std::vector<Tick>{};
+    for (size_t i = 0; i < n; i++) {
+      auto ts = i < n - 10 ? i : 2 * n - i;
+      ticks.emplace_back(ts, 1.0 + (i % 7), uint32_t(i % 5), i % 2, 1);
+    }
+    db.Insert(ticks);
+    db.Flush();
+
+    auto state = db.storage_handler_->GetState();
+    EXPECT_EQ(state->GetSealedBuffers()->size(), 1);
+    EXPECT_FALSE(state->GetActiveBuffer()->IsSorted());
+
+    auto start_ts = n / 2, end_ts = n + 5;
+    auto expected = AggregateAccumulator();
+    for (const auto &tick : db.GetForRange(start_ts, end_ts)) {
+      expected.Add(tick.GetPrice(), tick.GetVolume());
+    }
+
+    auto result = db.Aggregate(start_ts, end_ts);
+    EXPECT_EQ(result.GetCount(), expected.GetCount());
+    EXPECT_EQ(result.GetTotalVolume(), expected.ToResult().GetTotalVolume());
+    EXPECT_EQ(result.GetMinPrice(), expected.ToResult().GetMinPrice());
+    EXPECT_EQ(result.GetMaxPrice(), expected.ToResult().GetMaxPrice());
+    EXPECT_DOUBLE_EQ(result.GetAvgPrice(), expected.ToResult().GetAvgPrice());
+    EXPECT_DOUBLE_EQ(result.GetVwap(), expected.ToResult().GetVwap());
+
+    // Whole buffers are taken from their summary
+    auto all = AggregateAccumulator();
+    for (const auto &tick : db.GetForRange(0, 2 * n)) {
+      all.Add(tick.GetPrice(), tick.GetVolume());
+    }
+    EXPECT_TRUE(state->GetSealedBuffers()->front()->GetSummary());
+    EXPECT_TRUE(db.Aggregate(0, 2 * n) == all.ToResult());
+
+    // The filtered variant sees the same rows
+    auto filtered = db.Aggregate(start_ts, end_ts, [](const Tick &tick) {
+      return tick.GetSymbolId() == 1;
+    });
+    auto symbol_rows = 0;
+    for (const auto &tick : db.GetForRange(start_ts, end_ts)) {
+      if (tick.GetSymbolId() == 1) symbol_rows++;
+    }
+    EXPECT_EQ(filtered.GetCount(), symbol_rows);
+  }
+
+  static auto rollup_aggregate_test() -> void {
+    auto config = Config();
+    config.SetPriceScale(1e-4);
+    auto db = Database(config);
+
+    auto n = 8 * size_t(Constants::kMAXIMUM_SEALED_BUFFER_SIZE) + 300;
+    auto ticks = std::vector<Tick>{};
+    for (size_t i = 0; i < n; i++) {
+      ticks.emplace_back(2 * i, 100.0 + double(i % 89) / 100, uint32_t(i % 11));
+    }
+    db.Insert(ticks);
+    db.Flush();
+
+    auto state = db.storage_handler_->GetState();
+    ASSERT_EQ(state->GetRollup().Size(), state->GetSealedBuffers()->size());
+    EXPECT_TRUE(state->GetRollup().IsOrdered());
+
+    auto ranges = std::vector<std::pair<uint64_t, uint64_t>>{
+      {0, 2 * n}, {1, 2 * n - 3}, {20000, 40000}, {19999, 40001},
+      {12345, 12345}, {12344, 12346}, {50001, 150001}, {2 * n - 500, 4 * n}
+    };
+
+    for (auto [start_ts, end_ts] : ranges) {
+      auto expected = AggregateAccumulator(PriceScale(1e-4));
+      for (const auto &tick : db.GetForRange(start_ts, end_ts)) {
+        expected.Add(tick.GetPrice(), tick.GetVolume());
+      }
+      EXPECT_TRUE(db.Aggregate(start_ts, end_ts) == expected.ToResult());
+    }
+  }
+
+  static auto parallel_query_test() -> void {
+    auto serial_config = Config();
+    serial_config.SetPriceScale(1e-4);
+    serial_config.SetParallelQueryThreshold(std::numeric_limits<size_t>::max());
+
+    auto parallel_config = serial_config;
+    parallel_config.SetParallelQueryThreshold(1);
+
+    auto serial_db = Database(serial_config);
+    auto parallel_db = Database(parallel_config);
+
+    // Several sealed buffers, overlapping in time with some late ticks
+    auto n = 6 * size_t(Constants::kMAXIMUM_SEALED_BUFFER_SIZE) + 500;
+    auto ticks = std::vector<Tick>{};
+    for (size_t i = 0; i < n; i++) {
+      auto ts = i % 1000 == 999 && i > 15000 ? i - 15000 : i;
+      ticks.emplace_back(ts, 100.0 + double(i % 97) / 100, uint32_t(i % 13), i % 3, 1);
+    }
+    serial_db.Insert(ticks);
+    parallel_db.Insert(ticks);
+    serial_db.Flush();
+    parallel_db.Flush();
+
+    EXPECT_GE(parallel_db.storage_handler_->GetState()->GetSealedBuffers()->size(), 6);
+
+    for (auto [start_ts, end_ts] : {std::pair<uint64_t, uint64_t>{0, n},
+                                    {12345, 54321},
+                                    {n - 100, n}}) {
+      // Fixed-point sums are exact, the results do not depend on the split
+      EXPECT_TRUE(parallel_db.Aggregate(start_ts, end_ts) ==
+                  serial_db.Aggregate(start_ts, end_ts));
+
+      auto is_symbol_1 = [](const Tick &tick) { return tick.GetSymbolId() == 1; };
+      EXPECT_TRUE(parallel_db.Aggregate(start_ts, end_ts, is_symbol_1) ==
+                  serial_db.Aggregate(start_ts, end_ts, is_symbol_1));
+
+      EXPECT_EQ(parallel_db.AggregateBySymbol(start_ts, end_ts),
+                serial_db.AggregateBySymbol(start_ts, end_ts));
+
+      auto parallel_ticks = parallel_db.GetForRange(start_ts, end_ts);
+      auto serial_ticks = serial_db.GetForRange(start_ts, end_ts);
+
+      ASSERT_EQ(parallel_ticks.size(), serial_ticks.size());
+      EXPECT_TRUE(std::is_sorted(parallel_ticks.begin(), parallel_ticks.end(),
+                                 [](const Tick &a, const Tick &b) {
+        return a.GetTimestamp() < b.GetTimestamp();
+      }));
+
+      for (size_t i = 0; i < parallel_ticks.size(); i++) {
+        EXPECT_EQ(parallel_ticks[i].GetTimestamp(), serial_ticks[i].GetTimestamp());
+      }
+      EXPECT_EQ(parallel_db.GetForRange(start_ts, end_ts, is_symbol_1).size(),
+                serial_db.GetForRange(start_ts, end_ts, is_symbol_1).size());
+    }
+  }
+
+  static auto parallel_query_during_ingest_test() -> void {
+    auto config = Config();
+    config.SetPriceScale(1e-4);
+    config.SetParallelQueryThreshold(1);
+    auto db = Database(config);
+
+    auto n = 6 * size_t(Constants::kMAXIMUM_SEALED_BUFFER_SIZE);
+    auto ticks = std::vector<Tick>{};
+    for (size_t i = 0; i < n; i++) {
+      ticks.emplace_back(i, 100.0 + double(i % 97) / 100, uint32_t(i % 13), i % 3, 1);
+    }
+    db.Insert(ticks);
+    db.Flush();
+    auto expected = db.Aggregate(0, n - 1, [](const TickView &) { return true; });
+
+    // The ticks ingested meanwhile are all after the queried range, and few
+    // enough for the memory budget to never evict the queried ones
+    auto ingesting = std::atomic<bool>(true);
+    auto ingest = std::thread([&db, &ingesting, n] {
+      for (auto ts = n; ts < 4 * n; ts++) {
+        db.Insert(Tick(ts, 1.0, 1));
+      }
+      ingesting.store(false, std::memory_order_release);
+    });
+    do {
+      EXPECT_TRUE(db.Aggregate(0, n - 1, [](const TickView &) { return true; }) == expected);
+    } while (ingesting.load(std::memory_order_acquire));
+    ingest.join();
+    db.Flush();
+
+    // With every free worker busy and tasks queued behind them, the query
+    // runs on the calling thread instead of waiting for the pool
+    auto release = std::promise<void>();
+    auto released = release.get_future().share();
+    auto blocked = std::vector<std::future<void>>{};
+    for (size_t i = 0; i < db.thread_pool_->GetThreadCount(); i++) {
+      blocked.push_back(db.thread_pool_->AssignTask([released] { released.wait(); }));
+    }
+
+    auto query = std::async(std::launch::async, [&db, n] {
+      return db.Aggregate(0, n - 1, [](const TickView &) { return true; });
+    });
+    auto status = query.wait_for(std::chrono::seconds(10));
+    release.set_value();
+
+    ASSERT_EQ(status, std::future_status::ready);
+    EXPECT_TRUE(query.get() == expected);
+    for (auto &task : blocked) {
+      task.get();
+    }
+  }
+
+  static auto quotes_test() -> void {
+    auto db = Database();
+    db.Insert({
+      Quote(100, 10.0, 1, 10.2, 1, 1, 1),
+      Quote(104, 20.0, 1, 20.5, 1, 2, 1),
+      Quote(102, 10.1, 1, 10.2, 1, 1, 2),
+      Quote(106, 10.0, 1, 10.4, 1, 1, 1)
+    });
+    db.Insert(Tick(100, 1.1, 1));
+    db.Flush();
+
+    EXPECT_EQ(db.quote_storage_handler_->GetState()->GetActiveBuffer()->Size(), 4);
+    EXPECT_EQ(db.Size(), 1);
+
+    auto quotes = db.GetQuotesForRange(101, 106);
+    ASSERT_EQ(quotes.size(), 3);
+    EXPECT_EQ(quotes[0].GetTimestamp(), 102);
+    EXPECT_EQ(quotes[1].GetTimestamp(), 104);
+    EXPECT_EQ(quotes[2].GetTimestamp(), 106);
+
+    auto is_symbol_1 = [](const Quote &quote) { return quote.GetSymbolId() == 1; };
+    EXPECT_EQ(db.GetQuotesForRange(100, 106, is_symbol_1).size(), 3);
+
+    // spread 0.2 in force for 2, 0.1 for 4, the last one (0.4) carries no weight
+    auto result = db.AggregateQuotes(100, 106, is_symbol_1);
+    EXPECT_EQ(result.GetCount(), 3);
+    EXPECT_NEAR(result.GetMinSpread(), 0.1, 1e-9);
+    EXPECT_NEAR(result.GetMaxSpread(), 0.4, 1e-9);
+    EXPECT_NEAR(result.GetAvgSpread(), 0.7 / 3, 1e-9);
+    EXPECT_NEAR(result.GetTimeWeightedSpread(), (0.2 * 2 + 0.1 * 4) / 6, 1e-9);
+
+    result = db.AggregateQuotes(106, 106);
+    EXPECT_EQ(result.GetCount(), 1);
+    EXPECT_NEAR(result.GetTimeWeightedSpread(), 0.4, 1e-9);
+    EXPECT_TRUE(db.AggregateQuotes(200, 300) == QuoteAggregateResult());
+
+    EXPECT_EQ(db.GetLatestQuote(1)->GetTimestamp(), 106);
+    EXPECT_EQ(db.GetLatestQuote(1, 2)->GetTimestamp(), 102);
+    EXPECT_EQ(db.GetLatestQuote(2)->GetTimestamp(), 104);
+    EXPECT_FALSE(db.GetLatestQuote(3));
+  }
+
+  static auto sealed_quotes_test() -> void {
+    auto db = Database();
+    auto n = size_t(Constants::kMAXIMUM_SEALED_BUFFER_SIZE) + 10;
+
+    auto quotes = std::vector<Quote>{};
+    for (size_t i = 0; i < n; i++) {
+      // symbol 1 only quotes within the first (sealed) buffer
+      auto symbol_id = i < 100 ? 1 : 2;
+      quotes.emplace_back(Quote(i, 10.0, 1, 10.5, 1, symbol_id, 1));
+    }
+    db.Insert(quotes);
+    db.Flush();
+
+    auto state = db.quote_storage_handler_->GetState();
+    EXPECT_EQ(state->GetSealedBuffers()->size(), 1);
+    EXPECT_EQ(state->GetActiveBuffer()->Size(), 10);
+
+    auto range_data = db.GetQuotesForRange(n - 20, n);
+    ASSERT_EQ(range_data.size(), 20);
+    EXPECT_EQ(range_data.front().GetTimestamp(), n - 20);
+    EXPECT_EQ(range_data.back().GetTimestamp(), n - 1);
+
+    EXPECT_EQ(db.GetLatestQuote(1)->GetTimestamp(), 99);
+    EXPECT_EQ(db.GetLatestQuote(2)->GetTimestamp(), n - 1);
+  }
+
+  static auto latest_quote_retention_test() -> void {
+    auto config = Config();
+    config.SetRetentionPeriod(100);
+    auto db = Database(config);
+
+    db.Insert({
+      Quote(1000, 10.0, 1, 10.5, 1, 1, 1),
+      Quote(1050, 20.0, 1, 20.5, 1, 2, 1),
+      Quote(1020, 21.0, 1, 21.5, 1, 2, 1),
+      Quote(1200, 30.0, 1, 30.5, 1, 3, 1)
+    });
+    db.Flush();
+
+    // Symbol 1 only quoted behind the horizon (1100), a late quote never wins
+    EXPECT_FALSE(db.GetLatestQuote(1));
+    EXPECT_FALSE(db.GetLatestQuote(2));
+    EXPECT_TRUE(*db.GetLatestQuote(3) == Quote(1200, 30.0, 1, 30.5, 1, 3, 1));
+
+    db.Insert(Quote(1150, 22.0, 1, 22.5, 1, 2, 1));
+    db.Flush();
+    EXPECT_TRUE(*db.GetLatestQuote(2, 1) == Quote(1150, 22.0, 1, 22.5, 1, 2, 1));
+  }
+
+  static auto columns_for_range_test() -> void {
+    auto db = Database();
+
+    // {20, 30, 40} sealed after {10, 25} and an active buffer of {5, 50}
+    auto sealed_1 = std::make_shared<Buffer>(
+      std::vector<Tick>{Tick(10, 1.0, 1), Tick(25, 2.0, 2)}
+    );
+    auto sealed_2 = std::make_shared<Buffer>(
+      std::vector<Tick>{Tick(20, 3.0, 3), Tick(30, 4.0, 4), Tick(40, 5.0, 5)}
+    );
+    auto active = std::make_shared<Buffer>(
+      std::vector<Tick>{Tick(50, 6.0, 6), Tick(5, 7.0, 7)}
+    );
+
+    auto sealed_list = std::make_shared<State::sealed_list>();
+    sealed_list->push_back(sealed_1);
+    sealed_list->push_back(sealed_2);
+
+    auto new_state = std::make_shared<const State>(active, sealed_list);
+    db.storage_handler_->current_state_.store(new_state);
+
+    auto columns = db.GetColumnsForRange(0, 100, TickColumn::kTimestamp | TickColumn::kPrice);
+    EXPECT_EQ(columns.GetTimestamps(), (std::vector<uint64_t>{5, 10, 20, 25, 30, 40, 50}));
+    EXPECT_EQ(columns.GetPrices(), (std::vector<double>{7.0, 1.0, 3.0, 2.0, 4.0, 5.0, 6.0}));
+
+    columns = db.GetColumnsForRange(26, 45, TickColumn::kVolume);
+    EXPECT_EQ(columns.GetVolumes(), (std::vector<uint32_t>{4, 5}));
+  }
+
+  static auto aggregate_by_test() -> void {
+    auto db = Database();
+    auto n = size_t(Constants::kMAXIMUM_SEALED_BUFFER_SIZE) + 10;
+
+    // Symbols 0..6 on exchanges 0..2, partly in the unsorted active buffer
+    auto ticks = std::vector<Tick>{};
+    for (size_t i = 0; i < n; i++) {
+      auto ts = i < n - 10 ? i : 2 * n - i;
+      ticks.emplace_back(ts, 1.0 + (i % 11), uint32_t(i % 5), i % 7, i % 3);
+    }
+    db.Insert(ticks);
+    db.Flush();
+
+    EXPECT_EQ(db.storage_handler_->GetState()->GetSealedBuffers()->size(), 1);
+
+    auto start_ts = n / 2, end_ts = n + 5;
+    auto by_symbol = db.AggregateBySymbol(start_ts, end_ts);
+    auto by_exchange = db.AggregateByExchange(start_ts, end_ts);
+    ASSERT_EQ(by_symbol.size(), 7);
+    ASSERT_EQ(by_exchange.size(), 3);
+
+    for (uint32_t id = 0; id < 7; id++) {
+      EXPECT_TRUE(by_symbol[id] == db.Aggregate(start_ts, end_ts, [id](const Tick &tick) {
+        return tick.GetSymbolId() == id;
+      }));
+    }
+
+    for (uint32_t id = 0; id < 3; id++) {
+      EXPECT_TRUE(by_exchange[id] == db.Aggregate(start_ts, end_ts, [id](const Tick &tick) {
+        return tick.GetExchangeId() == id;
+      }));
+    }
+
+    EXPECT_TRUE(db.AggregateBySymbol(3 * n, 4 * n).empty());
+    EXPECT_TRUE(db.AggregateByExchange(end_ts, start_ts).empty());
+  }
+
+  static auto predicate_test() -> void {
+    auto config = Config();
+    config.SetPriceScale(1e-4);
+    config.SetParallelQueryThreshold(1);
+    auto db = Database(config);
+
+    // Sealed buffers whose blocks hold a few symbols each, and an unsorted active buffer
+    auto n = 3 * size_t(Constants::kMAXIMUM_SEALED_BUFFER_SIZE) + 40;
+    auto ticks = std::vector<Tick>{};
+    for (size_t i = 0; i < n; i++) {
+      auto ts = i < n - 40 ? i : 2 * n - i;
+      auto condition = i % 10 == 0 ? TradeConditions::kOddLotTrade : TradeConditions::kRegularSale;
+      ticks.emplace_back(ts, 100.0 + double(i % 89) / 100, uint32_t(i % 7),
+                         uint32_t(i / 1000), uint32_t(i % 3), condition);
+    }
+    db.Insert(ticks);
+    db.Flush();
+
+    EXPECT_GE(db.storage_handler_->GetState()->GetSealedBuffers()->size(), 3);
+
+    auto predicates = std::vector<Predicate>{
+      Predicate(),
+      Predicate::SymbolIs(4),
+      Predicate::SymbolIn({2, 3, 25, 30}) && Predicate::VolumeAtLeast(3),
+      Predicate::ExchangeIs(1) || Predicate::PriceBetween(100.1, 100.2),
+      Predicate::ConditionNotIn({TradeConditions::kOddLotTrade}) && Predicate::SymbolIn({7, 8, 9})
+    };
+
+    for (auto [start_ts, end_ts] : {std::pair<uint64_t, uint64_t>{0, 2 * n},
+                                    {1234, 23456},
+                                    {n - 100, n + 30}}) {
+      for (const auto &predicate : predicates) {
+        auto matches = [&predicate](const Tick &tick) { return predicate.Matches(tick); };
+
+        // Fixed-point sums are exact, so the results match the filtered scan exactly
+        EXPECT_TRUE(db.Aggregate(start_ts, end_ts, predicate) ==
+                    db.Aggregate(start_ts, end_ts, matches));
+
+        auto selected = db.GetForRange(start_ts, end_ts, predicate);
+        auto filtered = db.GetForRange(start_ts, end_ts, matches);
+        ASSERT_EQ(selected.size(), filtered.size());
+        for (size_t i = 0; i < selected.size(); i++) {
+          EXPECT_EQ(selected[i].GetTimestamp(), filtered[i].GetTimestamp());
+        }
+      }
+    }
+
+    EXPECT_TRUE(db.GetForRange(0, 2 * n, Predicate::SymbolIs(100)).empty());
+    EXPECT_TRUE(db.Aggregate(0, 2 * n, Predicate::SymbolIs(100)) == AggregateResult());
+  }
+
+  static auto inlined_filter_test() -> void {
+    auto config = Config();
+    config.SetPriceScale(1e-4);
+    config.SetParallelQueryThreshold(1);
+    auto db = Database(config);
+
+    auto n = 2 * size_t(Constants::kMAXIMUM_SEALED_BUFFER_SIZE) + 40;
+    auto ticks = std::vector<Tick>{};
+    for (size_t i = 0; i < n; i++) {
+      auto ts = i < n - 40 ? i : 2 * n - i;
+      ticks.emplace_back(ts, 100.0 + double(i % 89) / 100, uint32_t(i % 7), uint32_t(i % 5), 1);
+    }
+    db.Insert(ticks);
+    db.Flush();
+
+    auto by_view = [](const TickView &tick) { return tick.GetSymbolId() == 2 && tick.GetVolume() > 3; };
+    auto by_tick = [](const Tick &tick) { return tick.GetSymbolId() == 2 && tick.GetVolume() > 3; };
+    auto generic = [](const auto &tick) { return tick.GetSymbolId() == 2 && tick.GetVolume() > 3; };
+    auto erased = Database::filter_func(by_tick);
+
+    // Uses members only a Tick has, it must never be instantiated for a TickView
+    auto generic_tick = [](const auto &tick) {
+      return tick.ToRecord().template Get<columns::SymbolId>() == 2 && tick.GetVolume() > 3;
+    };
+
+    static_assert(TickFilter<decltype(by_view)>);
+    static_assert(TickFilter<decltype(by_tick)>);
+    static_assert(TickFilter<decltype(generic) &>);
+    static_assert(TickFilter<decltype(generic_tick) &>);
+    static_assert(!TickFilter<Database::filter_func &>);
+    static_assert(!TickFilter<Predicate>);
+
+    for (auto [start_ts, end_ts] : {std::pair<uint64_t, uint64_t>{0, 2 * n}, {1234, n + 20}}) {
+      auto expected = db.Aggregate(start_ts, end_ts, erased);
+      EXPECT_GT(expected.GetCount(), 0);
+      EXPECT_TRUE(db.Aggregate(start_ts, end_ts, by_view) == expected);
+      EXPECT_TRUE(db.Aggregate(start_ts, end_ts, by_tick) == expected);
+      EXPECT_TRUE(db.Aggregate(start_ts, end_ts, generic) == expected);
+      EXPECT_TRUE(db.Aggregate(start_ts, end_ts, generic_tick) == expected);
+
+      auto expected_ticks = db.GetForRange(start_ts, end_ts, erased);
+      for (const auto &selected : {db.GetForRange(start_ts, end_ts, by_view),
+                                   db.GetForRange(start_ts, end_ts, by_tick),
+                                   db.GetForRange(start_ts, end_ts, generic),
+                                   db.GetForRange(start_ts, end_ts, generic_tick)}) {
+        ASSERT_EQ(selected.size(), expected_ticks.size());
+        for (size_t i = 0; i < selected.size(); i++) {
+          EXPECT_EQ(selected[i].GetTimestamp(), expected_ticks[i].GetTimestamp());
+          EXPECT_EQ(selected[i].GetPrice(), expected_ticks[i].GetPrice());
+        }
+      }
+    }
+  }
+
+  static auto overlapping_buffers_test() -> void {
+    auto db = Database();
+
+    // Four sealed buffers interleaving each other (with equal timestamps
+    // across them) and an unsorted active buffer
+    auto sealed_list = std::make_shared<State::sealed_list>();
+    auto all_ticks = std::vector<Tick>{};
+
+    for (uint32_t buffer = 0; buffer < 4; buffer++) {
+      auto ticks = std::vector<Tick>{};
+      for (uint64_t i = 0; i < 300; i++) {
+        ticks.emplace_back(buffer * 50 + i * (buffer + 1), double(buffer * 1000 + i), 1);
+      }
+      all_ticks.insert(all_ticks.end(), ticks.begin(), ticks.end());
+
+      auto sealed = std::make_shared<Buffer>(ticks);
+      sealed->ComputeSummary();
+      sealed_list->push_back(sealed);
+    }
+
+    auto active_ticks = std::vector<Tick>{Tick(500, -1.0, 1), Tick(7, -2.0, 1), Tick(500, -3.0, 1)};
+    all_ticks.insert(all_ticks.end(), active_ticks.begin(), active_ticks.end());
+
+    auto new_state = std::make_shared<const State>(std::make_shared<Buffer>(active_ticks), sealed_list);
+    db.storage_handler_->current_state_.store(new_state);
+
+    std::stable_sort(all_ticks.begin(), all_ticks.end(), [](const Tick &a, const Tick &b) {
+      return a.GetTimestamp() < b.GetTimestamp();
+    });
+
+    for (auto [start_ts, end_ts] : {std::pair<uint64_t, uint64_t>{0, 2000}, {100, 600}, {499, 500}}) {
+      auto expected = std::vector<Tick>{};
+      std::copy_if(all_ticks.begin(), all_ticks.end(), std::back_inserter(expected),
+                   [start_ts, end_ts](const Tick &tick) {
+        return tick.GetTimestamp() >= start_ts && tick.GetTimestamp() <= end_ts;
+      });
+
+      auto ticks = db.GetForRange(start_ts, end_ts);
+      ASSERT_EQ(ticks.size(), expected.size());
+      for (size_t i = 0; i < ticks.size(); i++) {
+        EXPECT_EQ(ticks[i].GetTimestamp(), expected[i].GetTimestamp());
+        EXPECT_EQ(ticks[i].GetPrice(), expected[i].GetPrice());
+      }
+    }
+  }
+
+  static auto latest_tick_test() -> void {
+    auto config = Config();
+    config.SetRetentionPeriod(100);
+    auto db = Database(config);
+
+    EXPECT_FALSE(db.GetLatestTick(1).has_value());
+
+    auto ticks = std::vector<Tick>{};
+    for (uint64_t i = 1; i <= 25000; i++) {
+      ticks.emplace_back(i, double(i), 1, uint32_t(i % 3), uint32_t(i % 2));
+    }
+    ticks.emplace_back(10, 1.0, 1, 7, 1);
+    db.Insert(ticks);
+    db.Flush();
+
+    EXPECT_TRUE(*db.GetLatestTick(0) == Tick(24999, 24999.0, 1, 0, 1));
+    EXPECT_TRUE(*db.GetLatestTick(1) == Tick(25000, 25000.0, 1, 1, 0));
+    EXPECT_TRUE(*db.GetLatestTick(1, 1) == Tick(24997, 24997.0, 1, 1, 1));
+    EXPECT_FALSE(db.GetLatestTick(3).has_value());
+
+    // Kept even though the tick itself is past the retention period
+    EXPECT_TRUE(db.GetForRange(0, 100).empty());
+    EXPECT_TRUE(*db.GetLatestTick(7) == Tick(10, 1.0, 1, 7, 1));
+    EXPECT_FALSE(db.GetLatestTick(7, 0).has_value());
+  }
+
+  static auto continuous_query_test() -> void {
+    auto config = Config();
+    config.SetPriceScale(1e-4);
+    auto db = Database(config);
+
+    auto notified = std::make_shared<std::atomic<size_t>>(0);
+    auto all = db.RegisterContinuousQuery(1000);
+    auto symbol = db.RegisterContinuousQuery(500, Predicate::SymbolIs(3),
+                                             [notified](const AggregateResult &) { (*notified)++; });
+    EXPECT_EQ(all.GetWindow(), 1000);
+    EXPECT_TRUE(all.GetResult() == AggregateResult());
+
+    auto ticks = std::vector<Tick>{};
+    for (uint64_t i = 1; i <= 25000; i++) {
+      ticks.emplace_back(i, 100.0 + double(i % 13) * 1e-4, uint32_t(i % 7), uint32_t(i % 5), 0);
+    }
+    db.Insert(ticks);
+    db.Flush();
+
+    // The same values as aggregating the window of the latest timestamp
+    EXPECT_TRUE(all.GetResult() == db.Aggregate(24000, 25000));
+    EXPECT_TRUE(symbol.GetResult() == db.Aggregate(24500, 25000, Predicate::SymbolIs(3)));
+    EXPECT_GT(notified->load(), 0);
+
+    // Dropping the last handle unregisters the query
+    EXPECT_EQ(db.subscriptions_.size(), 2);
+    symbol = ContinuousQuery();
+    EXPECT_EQ(symbol.GetWindow(), 0);
+    db.Insert(Tick(25001, 100.0, 1, 3, 0));
+    db.Flush();
+    EXPECT_EQ(db.subscriptions_.size(), 1);
+    EXPECT_EQ(all.GetResult().GetCount(), 1001);
+  }
+
+  static auto quantiles_test() -> void {
+    auto config = Config();
+    config.SetPriceScale(1e-4);
+    auto db = Database(config);
+
+    // Sealed buffers and an active one, the ranges below start and end
+    // within buffers so the edge rows are scanned and the rest merged
+    auto ticks = std::vector<Tick>{};
+    for (uint64_t i = 1; i <= 45000; i++) {
+      ticks.emplace_back(i, 100.0 + double((i * 7919) % 10007) * 1e-4, uint32_t((i * 31) % 1000));
+    }
+    db.Insert(ticks);
+    db.Flush();
+
+    auto sorted_column = [&db](uint64_t start_ts, uint64_t end_ts, bool prices) {
+      auto column = std::vector<double>{};
+      for (const auto &tick : db.GetForRange(start_ts, end_ts)) {
+        column.push_back(prices ? tick.GetPrice() : double(tick.GetVolume()));
+      }
+      std::sort(column.begin(), column.end());
+      return column;
+    };
+    auto rank = [](const std::vector<double> &sorted, double value) {
+      return double(std::lower_bound(sorted.begin(), sorted.end(), value) - sorted.begin()) /
+             double(sorted.size());
+    };
+
+    auto qs = std::vector<double>{0.0, 0.5, 0.95, 0.99, 1.0};
+
+    // Small ranges are exact
+    auto small = db.Quantiles(9951, 10050, qs);
+    auto small_prices = sorted_column(9951, 10050, true);
+    EXPECT_EQ(small.GetCount(), 100);
+    EXPECT_EQ(small.GetQuantiles(), qs);
+    EXPECT_EQ(small.GetPrices()[0], small_prices.front());
+    EXPECT_EQ(small.GetPrices()[1], small_prices[49]);
+    EXPECT_EQ(small.GetPrices()[3], small_prices[98]);
+    EXPECT_EQ(small.GetPrices()[4], small_prices.back());
+
+    auto result = db.Quantiles(5500, 42000, qs);
+    auto prices = sorted_column(5500, 42000, true);
+    auto volumes = sorted_column(5500, 42000, false);
+    EXPECT_EQ(result.GetCount(), prices.size());
+
+    for (size_t i = 0; i < qs.size(); i++) {
+      EXPECT_NEAR(rank(prices, result.GetPrices()[i]), qs[i], 0.01) << qs[i];
+      EXPECT_NEAR(rank(volumes, result.GetVolumes()[i]), qs[i], 0.01) << qs[i];
+    }
+    EXPECT_EQ(result.GetPrices().back(), prices.back());
+    EXPECT_EQ(result.GetVolumes().front(), volumes.front());
+
+    auto empty = db.Quantiles(50000, 60000, qs);
+    EXPECT_EQ(empty.GetCount(), 0);
+    EXPECT_EQ(empty.GetPrices(), std::vector<double>(qs.size()));
+  }
+
+  static auto distinct_count_test() -> void {
+    auto db = Database();
+
+    // Symbol s trades on exchange s % 4 and, every third tick of the even
+    // ones, on 9
+    auto ticks = std::vector<Tick>{};
+    for (uint64_t i = 1; i <= 45000; i++) {
+      auto symbol_id = uint32_t((i * 7919) % 3000);
+      auto exchange_id = (i % 3 == 0 && symbol_id % 2 == 0) ? 9u : symbol_id % 4;
+      ticks.emplace_back(i, 100.0, 1, symbol_id, exchange_id);
+    }
+    db.Insert(ticks);
+    db.Flush();
+
+    auto exact = [&db](uint64_t start_ts, uint64_t end_ts, std::optional<uint32_t> exchange_id) {
+      auto symbols = std::set<uint32_t>{};
+      for (const auto &tick : db.GetForRange(start_ts, end_ts)) {
+        if (!exchange_id || tick.GetExchangeId() == *exchange_id) symbols.insert(tick.GetSymbolId());
+      }
+      return symbols.size();
+    };
+
+    // Small counts are exact
+    EXPECT_EQ(db.CountDistinctSymbols(9901, 10200), exact(9901, 10200, std::nullopt));
+    EXPECT_EQ(db.CountDistinctSymbols(9901, 10200, 1), exact(9901, 10200, 1));
+    EXPECT_EQ(db.CountDistinctExchanges(9901, 10200), 5);
+    EXPECT_EQ(db.CountDistinctExchanges(5500, 42000), 5);
+
+    // Sealed buffers merged, edges and the active buffer scanned
+    for (std::optional<uint32_t> exchange_id : {std::optional<uint32_t>(), std::optional<uint32_t>(9u),
+                                                std::optional<uint32_t>(3u)}) {
+      auto expected = double(exact(5500, 42000, exchange_id));
+      auto count = exchange_id ? db.CountDistinctSymbols(5500, 42000, *exchange_id)
+                               : db.CountDistinctSymbols(5500, 42000);
+      EXPECT_NEAR(double(count), expected, expected * 0.05);
+    }
+
+    EXPECT_EQ(db.CountDistinctSymbols(9901, 10200, 5), 0);
+    EXPECT_EQ(db.CountDistinctSymbols(50000, 60000), 0);
+    EXPECT_EQ(db.CountDistinctExchanges(50000, 60000), 0);
+  }
+
+  static auto as_of_join_test() -> void {
+    auto db = Database();
+    db.Insert({
+      Tick(99, 20.0, 1, 2, 0),
+      Tick(100, 10.0, 1, 1, 0),
+      Tick(105, 10.5, 1, 1, 0),
+      Tick(105, 20.5, 1, 2, 0),
+      Tick(110, 11.0, 1, 1, 0),
+      Tick(150, 21.5, 1, 2, 0),
+      Tick(200, 12.0, 1, 1, 0)
+    });
+    db.Flush();
+
+    // The right tick may lie before the range, or at the same timestamp
+    auto rows = db.AsOfJoin(100, 200, Predicate::SymbolIs(1), Predicate::SymbolIs(2), 20);
+    ASSERT_EQ(rows.size(), 4);
+    EXPECT_EQ(rows[0].GetLeft().GetTimestamp(), 100);
+    EXPECT_EQ(rows[0].GetRight()->GetTimestamp(), 99);
+    EXPECT_EQ(rows[1].GetRight()->GetPrice(), 20.5);
+    EXPECT_EQ(rows[2].GetLeft().GetTimestamp(), 110);
+    EXPECT_EQ(rows[2].GetRight()->GetTimestamp(), 105);
+    EXPECT_FALSE(rows[3].HasMatch());
+
+    rows = db.AsOfJoin(100, 200, Predicate::SymbolIs(1), Predicate::SymbolIs(2), 0);
+    ASSERT_EQ(rows.size(), 4);
+    EXPECT_FALSE(rows[0].HasMatch());
+    EXPECT_TRUE(rows[1].HasMatch());
+    EXPECT_FALSE(rows[2].HasMatch());
+    EXPECT_TRUE(db.AsOfJoin(300, 400, Predicate::SymbolIs(1), Predicate::SymbolIs(2), 20).empty());
+
+    // Sealed and active buffers, inserted slightly out of order
+    auto large_db = Database();
+    auto ticks = std::vector<Tick>{};
+    for (uint64_t i = 4; i < 45000; i++) {
+      auto ts = i ^ 3;
+      if (ts % 7 == 0) continue;
+      ticks.emplace_back(ts, double(ts), 1, uint32_t(ts % 3), 0);
+    }
+    large_db.Insert(ticks);
+    large_db.Flush();
+
+    auto joined = large_db.AsOfJoin(5500, 44000, Predicate::SymbolIs(1), Predicate::SymbolIs(2), 3);
+
+    // Joined by hand over the (unique) timestamps
+    auto expected = std::vector<std::pair<uint64_t, std::optional<uint64_t>>>{};
+    auto latest = std::optional<uint64_t>();
+    for (const auto &tick : large_db.GetForRange(5500 - 3, 44000)) {
+      if (tick.GetSymbolId() == 2) latest = tick.GetTimestamp();
+      if (tick.GetSymbolId() != 1 || tick.GetTimestamp() < 5500) continue;
+
+      auto is_match = latest && tick.GetTimestamp() - *latest <= 3;
+      expected.emplace_back(tick.GetTimestamp(), is_match ? latest : std::nullopt);
+    }
+
+    ASSERT_EQ(joined.size(), expected.size());
+    auto matched = size_t{};
+    for (size_t i = 0; i < joined.size(); i++) {
+      EXPECT_EQ(joined[i].GetLeft().GetTimestamp(), expected[i].first);
+      ASSERT_EQ(joined[i].HasMatch(), expected[i].second.has_value());
+      if (joined[i].HasMatch()) {
+        EXPECT_EQ(joined[i].GetRight()->GetTimestamp(), *expected[i].second);
+        matched++;
+      }
+    }
+    EXPECT_GT(matched, 0);
+    EXPECT_LT(matched, joined.size());
+  }
+
+  static auto as_of_join_quotes_test() -> void {
+    auto db = Database();
+    db.Insert({
+      Quote(95, 9.9, 1, 10.1, 1, 1, 0),
+      Quote(100, 10.0, 1, 10.2, 1, 1, 0),
+      Quote(101, 20.0, 1, 20.5, 1, 2, 0),
+      Quote(120, 10.1, 1, 10.3, 1, 1, 0)
+    });
+    db.Insert({
+      Tick(100, 10.1, 5, 1, 0),
+      Tick(102, 20.2, 5, 2, 0),
+      Tick(110, 10.2, 5, 1, 0),
+      Tick(160, 10.3, 5, 1, 0)
+    });
+    db.Flush();
+
+    auto is_symbol_1 = [](const Quote &quote) { return quote.GetSymbolId() == 1; };
+    auto rows = db.AsOfJoinQuotes(100, 200, Predicate::SymbolIs(1), is_symbol_1, 50);
+    ASSERT_EQ(rows.size(), 3);
+    EXPECT_EQ(rows[0].GetRight()->GetTimestamp(), 100);
+    EXPECT_EQ(rows[1].GetLeft().GetTimestamp(), 110);
+    EXPECT_EQ(rows[1].GetRight()->GetTimestamp(), 100);
+    ASSERT_TRUE(rows[2].HasMatch());
+    EXPECT_EQ(rows[2].GetRight()->GetBidPrice(), 10.1);
+
+    rows = db.AsOfJoinQuotes(100, 200, Predicate::SymbolIs(1), is_symbol_1, 5);
+    ASSERT_EQ(rows.size(), 3);
+    EXPECT_TRUE(rows[0].HasMatch());
+    EXPECT_FALSE(rows[1].HasMatch());
+    EXPECT_FALSE(rows[2].HasMatch());
+
+    // Quotes and ticks spread over sealed buffers and unsorted active ones,
+    // the quotes are streamed in timestamp order alongside the ticks
+    auto large_db = Database();
+    auto n = 2 * size_t(Constants::kMAXIMUM_SEALED_BUFFER_SIZE) + 30;
+    auto quotes = std::vector<Quote>{};
+    auto ticks = std::vector<Tick>{};
+    for (size_t i = 0; i < n; i++) {
+      auto ts = i < n - 30 ? 2 * i : 4 * n - 2 * i;
+      quotes.emplace_back(ts + 1, 10.0 + double(i % 7), 1, 11.0, 1, uint32_t(i % 3), 0);
+      ticks.emplace_back(ts, 10.0, 1, uint32_t(i % 2), 0);
+    }
+    large_db.Insert(quotes);
+    large_db.Insert(ticks);
+    large_db.Flush();
+
+    auto is_symbol_2 = [](const Quote &quote) { return quote.GetSymbolId() == 2; };
+    auto all_quotes = large_db.GetQuotesForRange(0, 4 * n, is_symbol_2);
+    ASSERT_TRUE(std::is_sorted(all_quotes.begin(), all_quotes.end(), [](const auto &a, const auto &b) {
+      return a.GetTimestamp() < b.GetTimestamp();
+    }));
+
+    rows = large_db.AsOfJoinQuotes(1000, 4 * n, Predicate::SymbolIs(1), is_symbol_2, 3);
+    auto trades = large_db.GetForRange(1000, 4 * n, Predicate::SymbolIs(1));
+    ASSERT_EQ(rows.size(), trades.size());
+
+    size_t next = 0, matches = 0;
+    for (size_t i = 0; i < rows.size(); i++) {
+      auto ts = trades[i].GetTimestamp();
+      EXPECT_EQ(rows[i].GetLeft().GetTimestamp(), ts);
+
+      while (next < all_quotes.size() && all_quotes[next].GetTimestamp() <= ts) next++;
+      auto is_match = next > 0 && ts - all_quotes[next - 1].GetTimestamp() <= 3;
+      ASSERT_EQ(rows[i].HasMatch(), is_match);
+
+      if (is_match) {
+        EXPECT_EQ(rows[i].GetRight()->GetTimestamp(), all_quotes[next - 1].GetTimestamp());
+        matches++;
+      }
+    }
+    EXPECT_GT(matches, 0);
+    EXPECT_LT(matches, rows.size());
+  }
+
+  static auto bars_test() -> void {
+    auto config = Config();
+    config.SetPriceScale(1e-4);
+    auto db = Database(config);
+    auto n = size_t(Constants::kMAXIMUM_SEALED_BUFFER_SIZE) + 10;
+
+    // A sealed buffer and an unsorted active buffer, no duplicate timestamps
+    auto ticks = std::vector<Tick>{};
+    for (size_t i = 0; i < n; i++) {
+      auto ts = i < n - 10 ? i : 2 * n - i;
+      ticks.emplace_back(ts, 100.0 + double(i % 13) / 100, uint32_t(i % 5), i % 3, 1);
+    }
+    db.Insert(ticks);
+    db.Flush();
+
+    auto state = db.storage_handler_->GetState();
+    EXPECT_EQ(state->GetSealedBuffers()->size(), 1);
+    EXPECT_FALSE(state->GetActiveBuffer()->IsSorted());
+
+    auto expected_bars = [&db](uint64_t start_ts, uint64_t end_ts, uint64_t interval,
+                               std::optional<uint32_t> symbol_id) {
+      auto bars = std::vector<Bar>{};
+      auto accumulator = AggregateAccumulator(PriceScale(1e-4));
+      auto bar = Bar();
+
+      auto flush = [&bars, &accumulator, &bar]() {
+        if (accumulator.GetCount() == 0) return;
+        auto result = accumulator.ToResult();
+        bar.SetHigh(result.GetMaxPrice());
+        bar.SetLow(result.GetMinPrice());
+        bar.SetVolume(result.GetTotalVolume());
+        bar.SetVwap(result.GetVwap());
+        bar.SetCount(result.GetCount());
+        bars.push_back(bar);
+        accumulator = AggregateAccumulator(PriceScale(1e-4));
+      };
+
+      for (const auto &tick : db.GetForRange(start_ts, end_ts)) {
+        if (symbol_id && tick.GetSymbolId() != *symbol_id) continue;
+
+        auto bucket_ts = start_ts + (tick.GetTimestamp() - start_ts) / interval * interval;
+        if (accumulator.GetCount() > 0 && bucket_ts != bar.GetTimestamp()) flush();
+
+        if (accumulator.GetCount() == 0) {
+          bar.SetTimestamp(bucket_ts);
+          bar.SetOpen(tick.GetPrice());
+        }
+        bar.SetClose(tick.GetPrice());
+        accumulator.Add(tick.GetPrice(), tick.GetVolume());
+      }
+      flush();
+      return bars;
+    };
+
+    auto cases = std::vector<std::tuple<uint64_t, uint64_t, uint64_t>>{
+      {0, 2 * n, 60}, {3, 2 * n, 1000}, {n - 50, n + 20, 7}, {100, 100, 5}, {0, 2 * n, 1}
+    };
+
+    for (auto [start_ts, end_ts, interval] : cases) {
+      EXPECT_EQ(db.Bars(start_ts, end_ts, interval),
+                expected_bars(start_ts, end_ts, interval, std::nullopt));
+      EXPECT_EQ(db.Bars(start_ts, end_ts, interval, 1),
+                expected_bars(start_ts, end_ts, interval, 1));
+    }
+
+    // Buckets spread over a long range are kept sparse
+    auto end_ts = std::numeric_limits<uint64_t>::max();
+    auto bars = db.Bars(0, end_ts, 2);
+    EXPECT_EQ(bars.size(), n / 2 + 1);
+    EXPECT_EQ(bars, expected_bars(0, end_ts, 2, std::nullopt));
+
+    bars = db.Bars(0, 2 * n, 2 * n + 1);
+    ASSERT_EQ(bars.size(), 1);
+    EXPECT_EQ(bars.front().GetCount(), n);
+    EXPECT_DOUBLE_EQ(bars.front().GetOpen(), 100.0);
+    EXPECT_DOUBLE_EQ(bars.front().GetClose(), ticks[n - 10].GetPrice());
+    EXPECT_TRUE(db.Bars(0, 2 * n, 0).empty());
+    EXPECT_TRUE(db.Bars(3 * n, 4 * n, 10).empty());
+  }
+
 private:
   static auto create_sorted_buffer(int64_t start_ts,
                                    int64_t step,
@@ -215,6 +1211,98 @@ TEST(DatabaseTest, SizeTest) {
   DatabaseTest::size_test();
 }
 
+TEST(DatabaseTest, MemoryBudgetTest) {
+  DatabaseTest::memory_budget_test();
+}
+
+TEST(DatabaseTest, SharedMemoryBudgetTest) {
+  DatabaseTest::shared_memory_budget_test();
+}
+
+TEST(DatabaseTest, RetentionPeriodTest) {
+  DatabaseTest::retention_period_test();
+}
+
+TEST(DatabaseTest, FixedPointPriceTest) {
+  DatabaseTest::fixed_point_price_test();
+}
+
 TEST(DatabaseTest, AggregateResultTest) {
   DatabaseTest::aggregate_result_test();
 }
+
+TEST(DatabaseTest, SealedAggregateTest) {
+  DatabaseTest::sealed_aggregate_test();
+}
+
+TEST(DatabaseTest, RollupAggregateTest) {
+  DatabaseTest::rollup_aggregate_test();
+}
+
+TEST(DatabaseTest, LatestQuoteRetentionTest) {
+  DatabaseTest::latest_quote_retention_test();
+}
+
+TEST(DatabaseTest, ParallelQueryTest) {
+  DatabaseTest::parallel_query_test();
+}
+
+TEST(DatabaseTest, ParallelQueryDuringIngestTest) {
+  DatabaseTest::parallel_query_during_ingest_test();
+}
+
+TEST(DatabaseTest, QuotesTest) {
+  DatabaseTest::quotes_test();
+}
+
+TEST(DatabaseTest, SealedQuotesTest) {
+  DatabaseTest::sealed_quotes_test();
+}
+
+TEST(DatabaseTest, ColumnsForRangeTest) {
+  DatabaseTest::columns_for_range_test();
+}
+
+TEST(DatabaseTest, AggregateByTest) {
+  DatabaseTest::aggregate_by_test();
+}
+
+TEST(DatabaseTest, PredicateTest) {
+  DatabaseTest::predicate_test();
+}
+
+TEST(DatabaseTest, InlinedFilterTest) {
+  DatabaseTest::inlined_filter_test();
+}
+
+TEST(DatabaseTest, OverlappingBuffersTest) {
+  DatabaseTest::overlapping_buffers_test();
+}
+
+TEST(DatabaseTest, LatestTickTest) {
+  DatabaseTest::latest_tick_test();
+}
+
+TEST(DatabaseTest, ContinuousQueryTest) {
+  DatabaseTest::continuous_query_test();
+}
+
+TEST(DatabaseTest, QuantilesTest) {
+  DatabaseTest::quantiles_test();
+}
+
+TEST(DatabaseTest, DistinctCountTest) {
+  DatabaseTest::distinct_count_test();
+}
+
+TEST(DatabaseTest, AsOfJoinTest) {
+  DatabaseTest::as_of_join_test();
+}
+
+TEST(DatabaseTest, AsOfJoinQuotesTest) {
+  DatabaseTest::as_of_join_quotes_test();
+}
+
+TEST(DatabaseTest, BarsTest) {
+  DatabaseTest::bars_test();
+}
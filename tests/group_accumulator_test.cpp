@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include "../src/headers/group_accumulator.hpp"
+#include "../src/headers/constants.hpp"
+#include "../include/bolt/aggregate_result.hpp"
+#include <set>
+#include <vector>
+
+namespace bolt {
+
+class GroupAccumulatorTest {
+public:
+  static auto add_test() -> void {
+    auto groups = GroupAccumulator();
+    EXPECT_EQ(groups.Size(), 0);
+    EXPECT_TRUE(groups.ToResults().empty());
+
+    auto keys = std::vector<uint32_t>{7, 7, 3, 7, 3};
+    auto prices = std::vector<double>{100.0, 150.0, 10.0, 120.0, 20.0};
+    auto volumes = std::vector<uint32_t>{10, 20, 1, 30, 3};
+    groups.Add(keys, prices, volumes);
+
+    EXPECT_EQ(groups.Size(), 2);
+    auto results = groups.ToResults();
+    ASSERT_EQ(results.size(), 2);
+
+    auto expected = AggregateAccumulator();
+    expected.Add(100.0, 10);
+    expected.Add(150.0, 20);
+    expected.Add(120.0, 30);
+    EXPECT_TRUE(results[7] == expected.ToResult());
+
+    expected = AggregateAccumulator();
+    expected.Add(10.0, 1);
+    expected.Add(20.0, 3);
+    EXPECT_TRUE(results[3] == expected.ToResult());
+  }
+
+  static auto fixed_point_test() -> void {
+    auto price_scale = PriceScale(1e-4);
+    auto groups = GroupAccumulator(price_scale);
+
+    auto keys = std::vector<uint32_t>{1, 2, 1};
+    auto price_ticks = std::vector<int64_t>{1000001, 999999, 1000003};
+    auto volumes = std::vector<uint32_t>{3, 5, 1};
+    groups.AddFixed(keys, price_ticks, volumes);
+
+    auto expected = AggregateAccumulator(price_scale);
+    expected.AddFixed(1000001, 3);
+    expected.AddFixed(1000003, 1);
+
+    auto results = groups.ToResults();
+    EXPECT_TRUE(results[1] == expected.ToResult());
+    EXPECT_EQ(results[2].GetCount(), 1);
+    EXPECT_DOUBLE_EQ(results[2].GetVwap(), 99.9999);
+  }
+
+  static auto growth_test() -> void {
+    auto groups = GroupAccumulator();
+    auto n = 50 * uint32_t(Constants::kGROUP_TABLE_INITIAL_CAPACITY);
+
+    // Strided keys, every one collides with others before the table grows
+    auto keys = std::vector<uint32_t>{};
+    auto prices = std::vector<double>{};
+    auto volumes = std::vector<uint32_t>{};
+    for (uint32_t i = 0; i < 2 * n; i++) {
+      keys.push_back((i % n) * 1024);
+      prices.push_back(double(i));
+      volumes.push_back(1);
+    }
+    groups.Add(keys, prices, volumes);
+
+    EXPECT_EQ(groups.Size(), n);
+    EXPECT_LE(2 * groups.Size(), groups.keys_.size());
+
+    auto results = groups.ToResults();
+    ASSERT_EQ(results.size(), n);
+    for (uint32_t i = 0; i < n; i++) {
+      EXPECT_EQ(results[i * 1024].GetCount(), 2);
+      EXPECT_DOUBLE_EQ(results[i * 1024].GetMinPrice(), double(i));
+      EXPECT_DOUBLE_EQ(results[i * 1024].GetMaxPrice(), double(i + n));
+    }
+  }
+
+  static auto lookup_without_growth_test() -> void {
+    auto groups = GroupAccumulator();
+    auto capacity = size_t(Constants::kGROUP_TABLE_INITIAL_CAPACITY);
+
+    // Exactly half full, as full as the table gets before growing
+    auto keys = std::vector<uint32_t>{};
+    for (uint32_t key = 0; key < capacity / 2; key++) {
+      keys.push_back(key);
+    }
+    groups.Add(keys, std::vector<double>(keys.size(), 1.0),
+               std::vector<uint32_t>(keys.size(), 1));
+    ASSERT_EQ(groups.keys_.size(), capacity);
+
+    // The keys already present are found in place, only a new one grows the table
+    groups.Add(keys, std::vector<double>(keys.size(), 2.0),
+               std::vector<uint32_t>(keys.size(), 1));
+    EXPECT_EQ(groups.keys_.size(), capacity);
+    EXPECT_EQ(groups.ToResults()[0].GetCount(), 2);
+
+    groups.Add(std::vector<uint32_t>{1000}, std::vector<double>{1.0},
+               std::vector<uint32_t>{1});
+    EXPECT_EQ(groups.keys_.size(), 2 * capacity);
+    EXPECT_EQ(groups.Size(), capacity / 2 + 1);
+  }
+
+  static auto home_slot_test() -> void {
+    // Keys sharing their low bits, with a low-bit hash all of them collide
+    auto slots = std::set<size_t>{};
+    for (uint32_t i = 0; i < 16; i++) {
+      auto slot = GroupAccumulator::HomeSlot_(i << 16, 64);
+      EXPECT_LT(slot, 64);
+      slots.insert(slot);
+    }
+    EXPECT_GE(slots.size(), 12);
+
+    // Consecutive keys still spread over the table
+    slots.clear();
+    for (uint32_t i = 0; i < 16; i++) {
+      slots.insert(GroupAccumulator::HomeSlot_(i, 16));
+    }
+    EXPECT_GE(slots.size(), 12);
+  }
+
+  static auto merge_test() -> void {
+    auto keys = std::vector<uint32_t>{1, 2, 3, 1};
+    auto prices = std::vector<double>{1.0, 2.0, 3.0, 4.0};
+    auto volumes = std::vector<uint32_t>{1, 2, 3, 4};
+
+    auto all = GroupAccumulator();
+    all.Add(keys, prices, volumes);
+
+    auto left = GroupAccumulator(), right = GroupAccumulator();
+    left.Add(std::span(keys).first(2), std::span(prices).first(2), std::span(volumes).first(2));
+    right.Add(std::span(keys).subspan(2), std::span(prices).subspan(2), std::span(volumes).subspan(2));
+
+    left.Merge(right);
+    left.Merge(GroupAccumulator());
+    EXPECT_EQ(left.Size(), 3);
+    EXPECT_EQ(left.ToResults(), all.ToResults());
+  }
+};
+
+}
+
+using namespace bolt;
+
+TEST(GroupAccumulatorTest, AddTest) {
+  GroupAccumulatorTest::add_test();
+}
+
+TEST(GroupAccumulatorTest, FixedPointTest) {
+  GroupAccumulatorTest::fixed_point_test();
+}
+
+TEST(GroupAccumulatorTest, GrowthTest) {
+  GroupAccumulatorTest::growth_test();
+}
+
+TEST(GroupAccumulatorTest, LookupWithoutGrowthTest) {
+  GroupAccumulatorTest::lookup_without_growth_test();
+}
+
+TEST(GroupAccumulatorTest, HomeSlotTest) {
+  GroupAccumulatorTest::home_slot_test();
+}
+
+TEST(GroupAccumulatorTest, MergeTest) {
+  GroupAccumulatorTest::merge_test();
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include "../src/headers/hyper_log_log.hpp"
+
+#include <cmath>
+
+namespace bolt {
+
+class HyperLogLogTest {
+public:
+  static auto relative_error(uint64_t estimate, uint64_t expected) -> double {
+    return std::abs(double(estimate) - double(expected)) / double(expected);
+  }
+
+  static auto exact_test() -> void {
+    auto sketch = HyperLogLog();
+    EXPECT_EQ(sketch.Count(), 0);
+
+    for (uint32_t i = 0; i < 3000; i++) sketch.Add(i % 500);
+    EXPECT_EQ(sketch.Count(), 500);
+    EXPECT_FALSE(sketch.IsDense_());
+    EXPECT_EQ(sketch.ids_.front(), 0);
+    EXPECT_EQ(sketch.ids_.back(), 499);
+  }
+
+  static auto estimate_test() -> void {
+    for (uint32_t cardinality : {2000u, 20000u, 1000000u}) {
+      auto sketch = HyperLogLog();
+      for (uint32_t i = 0; i < cardinality; i++) {
+        sketch.Add(i * 2654435761u);
+        sketch.Add(i * 2654435761u);
+      }
+      EXPECT_TRUE(sketch.IsDense_());
+      EXPECT_LT(relative_error(sketch.Count(), cardinality), 0.05) << cardinality;
+    }
+  }
+
+  static auto merge_test() -> void {
+    // Sparse with sparse stays exact
+    auto left = HyperLogLog();
+    auto right = HyperLogLog();
+    for (uint32_t i = 0; i < 300; i++) left.Add(i);
+    for (uint32_t i = 200; i < 600; i++) right.Add(i);
+    left.Merge(right);
+    EXPECT_EQ(left.Count(), 600);
+    EXPECT_FALSE(left.IsDense_());
+
+    // Overlapping parts, each sparse or dense, agree with a single sketch
+    auto merged = HyperLogLog();
+    auto whole = HyperLogLog();
+    for (uint32_t part = 0; part < 20; part++) {
+      auto sketch = HyperLogLog();
+      auto size = part % 2 ? 5000u : 100u;
+      for (uint32_t i = 0; i < size; i++) {
+        sketch.Add(part * 2500 + i);
+        whole.Add(part * 2500 + i);
+      }
+      merged.Merge(sketch);
+    }
+    EXPECT_EQ(merged.Count(), whole.Count());
+    EXPECT_EQ(merged.registers_, whole.registers_);
+
+    // Merging a dense sketch into a sparse one
+    auto sparse = HyperLogLog();
+    sparse.Add(1);
+    sparse.Merge(whole);
+    EXPECT_EQ(sparse.registers_, whole.registers_);
+  }
+};
+
+TEST(HyperLogLogTest, ExactTest) {
+  HyperLogLogTest::exact_test();
+}
+
+TEST(HyperLogLogTest, EstimateTest) {
+  HyperLogLogTest::estimate_test();
+}
+
+TEST(HyperLogLogTest, MergeTest) {
+  HyperLogLogTest::merge_test();
+}
+
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include "../src/headers/kernels.hpp"
+
+#include <random>
+#include <vector>
+
+namespace bolt {
+
+class KernelsTest {
+public:
+  static auto ExpectSameSums(const kernels::ColumnSums &a,
+                             const kernels::ColumnSums &b) -> void {
+    EXPECT_EQ(a.count, b.count);
+    EXPECT_EQ(a.total_volume, b.total_volume);
+    if (a.count == 0) return;
+
+    // The vectorized sums are added in a different order
+    EXPECT_DOUBLE_EQ(a.price_sum, b.price_sum);
+    EXPECT_NEAR(a.weighted_price_sum, b.weighted_price_sum, 1e-9 * b.weighted_price_sum);
+    EXPECT_EQ(a.min_price, b.min_price);
+    EXPECT_EQ(a.max_price, b.max_price);
+  }
+
+  static auto sum_columns_test() -> void {
+    auto prices = std::vector<double>{100.0, 150.0, 120.0, 99.5, 101.25};
+    auto volumes = std::vector<uint32_t>{10, 20, 30, 40, 4000000000U};
+
+    auto sums = kernels::SumColumns(prices, volumes, kernels::InstructionSet::kScalar);
+    EXPECT_EQ(sums.count, 5);
+    EXPECT_EQ(sums.total_volume, 4000000100ULL);
+    EXPECT_EQ(sums.price_sum, 570.75);
+    EXPECT_EQ(sums.weighted_price_sum, 1000.0 + 3000.0 + 3600.0 + 3980.0 + 101.25 * 4e9);
+    EXPECT_EQ(sums.min_price, 99.5);
+    EXPECT_EQ(sums.max_price, 150.0);
+
+    // Integral values, the summation order does not matter
+    ExpectSameSums(kernels::SumColumns(prices, volumes), sums);
+  }
+
+  static auto instruction_set_test() -> void {
+    auto rng = std::mt19937_64(42);
+    auto price_dist = std::uniform_real_distribution<double>(1.0, 1000.0);
+    auto volume_dist = std::uniform_int_distribution<uint32_t>(0, 4294967295U);
+
+    // Every length up to a few vectors, to cover the scalar tails
+    for (size_t size = 0; size < 40; size++) {
+      auto timestamps = std::vector<uint64_t>(size);
+      auto prices = std::vector<double>(size);
+      auto volumes = std::vector<uint32_t>(size);
+
+      for (size_t i = 0; i < size; i++) {
+        timestamps[i] = rng() % 100;
+        prices[i] = price_dist(rng);
+        volumes[i] = volume_dist(rng);
+      }
+
+      auto scalar = kernels::SumColumns(prices, volumes, kernels::InstructionSet::kScalar);
+      ExpectSameSums(kernels::SumColumns(prices, volumes), scalar);
+
+      auto in_range = kernels::SumColumnsInRange(timestamps, prices, volumes, 20, 60,
+                                                 kernels::InstructionSet::kScalar);
+      ExpectSameSums(kernels::SumColumnsInRange(timestamps, prices, volumes, 20, 60), in_range);
+    }
+  }
+
+  static auto in_range_test() -> void {
+    // Includes timestamps with the highest bit set, compared as unsigned
+    auto timestamps = std::vector<uint64_t>{5, 1, 9, 3, 18446744073709551615ULL, 4, 2, 7};
+    auto prices = std::vector<double>{5.0, 1.0, 9.0, 3.0, 100.0, 4.0, 2.0, 7.0};
+    auto volumes = std::vector<uint32_t>{5, 1, 9, 3, 100, 4, 2, 7};
+
+    for (auto instruction_set : {kernels::InstructionSet::kScalar, kernels::GetInstructionSet()}) {
+      auto sums = kernels::SumColumnsInRange(timestamps, prices, volumes, 3, 7, instruction_set);
+      EXPECT_EQ(sums.count, 4);
+      EXPECT_EQ(sums.total_volume, 19);
+      EXPECT_EQ(sums.price_sum, 19.0);
+      EXPECT_EQ(sums.weighted_price_sum, 25.0 + 9.0 + 16.0 + 49.0);
+      EXPECT_EQ(sums.min_price, 3.0);
+      EXPECT_EQ(sums.max_price, 7.0);
+
+      sums = kernels::SumColumnsInRange(timestamps, prices, volumes,
+                                        10, 18446744073709551615ULL, instruction_set);
+      EXPECT_EQ(sums.count, 1);
+      EXPECT_EQ(sums.max_price, 100.0);
+
+      sums = kernels::SumColumnsInRange(timestamps, prices, volumes, 10, 20, instruction_set);
+      EXPECT_EQ(sums.count, 0);
+      EXPECT_EQ(sums.total_volume, 0);
+    }
+  }
+};
+
+}
+
+using namespace bolt;
+
+TEST(KernelsTest, SumColumnsTest) {
+  KernelsTest::sum_columns_test();
+}
+
+TEST(KernelsTest, InstructionSetTest) {
+  KernelsTest::instruction_set_test();
+}
+
+TEST(KernelsTest, InRangeTest) {
+  KernelsTest::in_range_test();
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include "../src/headers/last_value_cache.hpp"
+#include "../src/headers/constants.hpp"
+#include "../include/bolt/tick.hpp"
+#include "../include/bolt/quote.hpp"
+#include <atomic>
+#include <thread>
+
+namespace bolt {
+
+class LastValueCacheTest {
+public:
+  static auto update_test() -> void {
+    auto cache = LastValueCache();
+    EXPECT_EQ(cache.Size(), 0);
+    EXPECT_FALSE(cache.Get(1).has_value());
+    EXPECT_FALSE(cache.Get(1, 2).has_value());
+
+    cache.Update(Tick(100, 1.5, 10, 1, 2, TradeConditions::kCashSale));
+    cache.Update(Tick(102, 2.5, 20, 1, 3));
+    cache.Update(Tick(101, 3.5, 30, 1, 2));
+    cache.Update(Tick(99, 4.5, 40, 5, 2));
+
+    EXPECT_EQ(cache.Size(), 2);
+    ASSERT_TRUE(cache.Get(1).has_value());
+    EXPECT_TRUE(*cache.Get(1) == Tick(102, 2.5, 20, 1, 3));
+    EXPECT_TRUE(*cache.Get(1, 2) == Tick(101, 3.5, 30, 1, 2));
+    EXPECT_TRUE(*cache.Get(1, 3) == Tick(102, 2.5, 20, 1, 3));
+    EXPECT_TRUE(*cache.Get(5) == Tick(99, 4.5, 40, 5, 2));
+    EXPECT_FALSE(cache.Get(5, 3).has_value());
+
+    // An older tick does not replace the latest one, an equal timestamp does
+    cache.Update(Tick(50, 9.9, 1, 1, 3));
+    EXPECT_EQ(cache.Get(1)->GetTimestamp(), 102);
+
+    cache.Update(Tick(102, 7.5, 70, 1, 3, TradeConditions::kCashSale));
+    EXPECT_TRUE(*cache.Get(1) == Tick(102, 7.5, 70, 1, 3, TradeConditions::kCashSale));
+  }
+
+  static auto quote_test() -> void {
+    auto cache = QuoteLastValueCache();
+    EXPECT_FALSE(cache.Get(1).has_value());
+
+    cache.Update(Quote(100, 10.0, 1, 10.5, 2, 1, 2));
+    cache.Update(Quote(102, 10.1, 3, 10.6, 4, 1, 3));
+    cache.Update(Quote(101, 10.2, 5, 10.7, 6, 1, 2));
+    cache.Update(Quote(90, 9.9, 7, 10.9, 8, 1, 3));
+
+    EXPECT_EQ(cache.Size(), 1);
+    EXPECT_TRUE(*cache.Get(1) == Quote(102, 10.1, 3, 10.6, 4, 1, 3));
+    EXPECT_TRUE(*cache.Get(1, 2) == Quote(101, 10.2, 5, 10.7, 6, 1, 2));
+    EXPECT_FALSE(cache.Get(1, 4).has_value());
+  }
+
+  static auto growth_test() -> void {
+    auto cache = LastValueCache();
+    auto n = 20 * uint32_t(Constants::kLAST_VALUE_INITIAL_CAPACITY);
+
+    for (uint32_t symbol = 0; symbol < n; symbol++) {
+      cache.Update(Tick(symbol, double(symbol), symbol, symbol, symbol % 3));
+    }
+
+    EXPECT_EQ(cache.Size(), n);
+    EXPECT_GT(cache.symbol_tables_.size(), 1);
+    for (uint32_t symbol = 0; symbol < n; symbol++) {
+      ASSERT_TRUE(cache.Get(symbol).has_value());
+      EXPECT_EQ(cache.Get(symbol)->GetVolume(), symbol);
+      EXPECT_EQ(cache.Get(symbol, symbol % 3)->GetPrice(), double(symbol));
+    }
+  }
+
+  static auto concurrent_read_test() -> void {
+    auto cache = LastValueCache();
+    auto done = std::atomic<bool>{false};
+
+    // Every tick written has price == volume == timestamp, a torn read would break it
+    auto reader = std::thread([&cache, &done] {
+      uint64_t last_ts = 0;
+      while (!done.load(std::memory_order_acquire)) {
+        auto tick = cache.Get(7);
+        if (!tick) continue;
+
+        EXPECT_EQ(tick->GetPrice(), double(tick->GetTimestamp()));
+        EXPECT_EQ(tick->GetVolume(), uint32_t(tick->GetTimestamp()));
+        EXPECT_GE(tick->GetTimestamp(), last_ts);
+        last_ts = tick->GetTimestamp();
+      }
+    });
+
+    for (uint32_t i = 1; i <= 200000; i++) {
+      cache.Update(Tick(i, double(i), i, 7, i % 5));
+      // Grows the tables while the reader is looking up
+      if (i % 100 == 0) cache.Update(Tick(i, 1.0, 1, 1000 + i, 1));
+    }
+    done.store(true, std::memory_order_release);
+    reader.join();
+
+    EXPECT_EQ(cache.Get(7)->GetTimestamp(), 200000);
+  }
+};
+
+}
+
+using namespace bolt;
+
+TEST(LastValueCacheTest, UpdateTest) {
+  LastValueCacheTest::update_test();
+}
+
+TEST(LastValueCacheTest, QuoteTest) {
+  LastValueCacheTest::quote_test();
+}
+
+TEST(LastValueCacheTest, GrowthTest) {
+  LastValueCacheTest::growth_test();
+}
+
+TEST(LastValueCacheTest, ConcurrentReadTest) {
+  LastValueCacheTest::concurrent_read_test();
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include "../src/headers/predicate_evaluator.hpp"
+#include "../src/headers/buffer.hpp"
+#include "../src/headers/constants.hpp"
+#include "../include/bolt/tick.hpp"
+#include <vector>
+
+namespace bolt {
+
+class PredicateEvaluatorTest {
+public:
+  static auto check_test() -> void {
+    auto zone_map = ZoneMap();
+    zone_map.Add(10, 1, 100.0, 5, TradeConditions::kRegularSale);
+    zone_map.Add(20, 1, 110.0, 50, TradeConditions::kOddLotTrade);
+
+    using ZoneMatch = PredicateEvaluator::ZoneMatch;
+    auto check = [&zone_map](const Predicate &predicate) {
+      return PredicateEvaluator(predicate).Check(zone_map);
+    };
+
+    EXPECT_EQ(check(Predicate()), ZoneMatch::kAll);
+    EXPECT_EQ(PredicateEvaluator(Predicate()).Check(ZoneMap()), ZoneMatch::kNone);
+
+    EXPECT_EQ(check(Predicate::SymbolIn({1, 2, 25})), ZoneMatch::kNone);
+    EXPECT_EQ(check(Predicate::SymbolIn({1, 15})), ZoneMatch::kSome);
+    EXPECT_EQ(check(Predicate::ExchangeIs(1)), ZoneMatch::kAll);
+    EXPECT_EQ(check(Predicate::ExchangeIs(2)), ZoneMatch::kNone);
+
+    EXPECT_EQ(check(Predicate::PriceBetween(111.0, 120.0)), ZoneMatch::kNone);
+    EXPECT_EQ(check(Predicate::PriceBetween(105.0, 120.0)), ZoneMatch::kSome);
+    EXPECT_EQ(check(Predicate::PriceBetween(100.0, 110.0)), ZoneMatch::kAll);
+
+    EXPECT_EQ(check(Predicate::VolumeAtLeast(51)), ZoneMatch::kNone);
+    EXPECT_EQ(check(Predicate::VolumeAtLeast(6)), ZoneMatch::kSome);
+    EXPECT_EQ(check(Predicate::VolumeAtLeast(5)), ZoneMatch::kAll);
+
+    EXPECT_EQ(check(Predicate::ConditionNotIn({TradeConditions::kCancelled})), ZoneMatch::kAll);
+    EXPECT_EQ(check(Predicate::ConditionNotIn({TradeConditions::kOddLotTrade})), ZoneMatch::kSome);
+    EXPECT_EQ(check(Predicate::ConditionNotIn({TradeConditions::kOddLotTrade,
+                                               TradeConditions::kRegularSale})), ZoneMatch::kNone);
+
+    EXPECT_EQ(check(Predicate::ExchangeIs(1) && Predicate::VolumeAtLeast(6)), ZoneMatch::kSome);
+    EXPECT_EQ(check(Predicate::ExchangeIs(2) && Predicate::VolumeAtLeast(5)), ZoneMatch::kNone);
+    EXPECT_EQ(check(Predicate::ExchangeIs(2) || Predicate::VolumeAtLeast(6)), ZoneMatch::kSome);
+    EXPECT_EQ(check(Predicate::ExchangeIs(2) || Predicate::VolumeAtLeast(5)), ZoneMatch::kAll);
+  }
+
+  static auto select_test() -> void {
+    for (auto price_scale : {PriceScale(), PriceScale(1e-2)}) {
+      auto buffer = Buffer(1000, price_scale);
+      for (uint64_t i = 0; i < 1000; i++) {
+        auto condition = i % 4 == 0 ? TradeConditions::kCancelled : TradeConditions::kRegularSale;
+        buffer.InsertTick(Tick(i, 10.0 + double(i % 17) / 10, uint32_t(i % 9),
+                               uint32_t(i % 23), uint32_t(i % 3), condition));
+      }
+
+      auto predicates = std::vector<Predicate>{
+        Predicate(),
+        Predicate::SymbolIn({1, 5, 7}),
+        Predicate::SymbolIn({0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10}),
+        Predicate::PriceBetween(10.5, 11.2) && Predicate::ExchangeIs(2),
+        Predicate::VolumeAtLeast(4) || Predicate::ConditionNotIn({TradeConditions::kRegularSale}),
+        (Predicate::SymbolIs(3) || Predicate::SymbolIs(4)) && Predicate::VolumeAtLeast(2)
+      };
+
+      auto mask = std::vector<uint8_t>{};
+      for (const auto &predicate : predicates) {
+        auto evaluator = PredicateEvaluator(predicate);
+        evaluator.Select(buffer, 100, 900, mask);
+
+        ASSERT_EQ(mask.size(), 800);
+        for (size_t i = 100; i < 900; i++) {
+          EXPECT_EQ(bool(mask[i - 100]), predicate.Matches(buffer.GetTick(i)));
+        }
+      }
+    }
+  }
+
+  static auto for_each_match_test() -> void {
+    // Symbol i / 256, so every block holds a single symbol
+    auto buffer = Buffer(1024);
+    for (uint64_t i = 0; i < 1024; i++) {
+      buffer.InsertTick(Tick(i, 1.0, uint32_t(i % 5), uint32_t(i / 256), 1));
+    }
+
+    auto collect = [&buffer](const Predicate &predicate, size_t begin, size_t end,
+                             size_t &skipped_masks) {
+      auto rows = std::vector<size_t>{};
+      PredicateEvaluator(predicate).ForEachMatch(buffer, begin, end,
+                                                 [&](size_t begin, size_t end, const uint8_t *mask) {
+        if (!mask) skipped_masks++;
+        for (auto i = begin; i < end; i++) {
+          if (!mask || mask[i - begin]) rows.push_back(i);
+        }
+      });
+      return rows;
+    };
+
+    auto expected = [&buffer](const Predicate &predicate, size_t begin, size_t end) {
+      auto rows = std::vector<size_t>{};
+      for (auto i = begin; i < end; i++) {
+        if (predicate.Matches(buffer.GetTick(i))) rows.push_back(i);
+      }
+      return rows;
+    };
+
+    auto predicate = Predicate::SymbolIs(1) && Predicate::VolumeAtLeast(3);
+    size_t unmasked = 0;
+
+    // Without zone maps the whole range is selected at once
+    EXPECT_EQ(collect(predicate, 10, 1000, unmasked), expected(predicate, 10, 1000));
+    EXPECT_EQ(unmasked, 0);
+
+    buffer.ComputeSummary();
+    EXPECT_EQ(collect(predicate, 10, 1000, unmasked), expected(predicate, 10, 1000));
+    EXPECT_EQ(unmasked, 0);
+
+    // Blocks of a single symbol match as a whole
+    predicate = Predicate::SymbolIn({1, 2});
+    EXPECT_EQ(collect(predicate, 300, 1000, unmasked), expected(predicate, 300, 1000));
+    EXPECT_EQ(unmasked, 2);
+
+    unmasked = 0;
+    EXPECT_TRUE(collect(Predicate::ExchangeIs(2), 0, 1024, unmasked).empty());
+    EXPECT_EQ(collect(Predicate::ExchangeIs(1), 5, 7, unmasked).size(), 2);
+    EXPECT_EQ(unmasked, 1);
+  }
+};
+
+}
+
+using namespace bolt;
+
+TEST(PredicateEvaluatorTest, CheckTest) {
+  PredicateEvaluatorTest::check_test();
+}
+
+TEST(PredicateEvaluatorTest, SelectTest) {
+  PredicateEvaluatorTest::select_test();
+}
+
+TEST(PredicateEvaluatorTest, ForEachMatchTest) {
+  PredicateEvaluatorTest::for_each_match_test();
+}
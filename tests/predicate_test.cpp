@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include "../include/bolt/predicate.hpp"
+#include "../include/bolt/tick.hpp"
+
+namespace bolt {
+
+class PredicateTest {
+public:
+  static auto constructor_test() -> void {
+    auto predicate = Predicate();
+    ASSERT_TRUE(predicate.node_);
+    EXPECT_EQ(predicate.node_->kind, Predicate::Kind::kAll);
+    EXPECT_TRUE(predicate.Matches(Tick(1, 1.0, 1)));
+
+    // Symbol sets are kept sorted and unique
+    predicate = Predicate::SymbolIn({5, 1, 5, 3});
+    EXPECT_EQ(predicate.node_->kind, Predicate::Kind::kSymbolIn);
+    EXPECT_EQ(predicate.node_->ids, (std::vector<uint32_t>{1, 3, 5}));
+
+    auto combined = predicate && Predicate::VolumeAtLeast(10);
+    EXPECT_EQ(combined.node_->kind, Predicate::Kind::kAnd);
+    EXPECT_EQ(combined.node_->left, predicate.node_);
+  }
+
+  static auto matches_test() -> void {
+    auto tick = Tick(1, 100.5, 50, 3, 2, TradeConditions::kOddLotTrade);
+
+    EXPECT_TRUE(Predicate::SymbolIn({1, 3}).Matches(tick));
+    EXPECT_FALSE(Predicate::SymbolIs(1).Matches(tick));
+    EXPECT_TRUE(Predicate::ExchangeIs(2).Matches(tick));
+    EXPECT_FALSE(Predicate::ExchangeIs(3).Matches(tick));
+
+    EXPECT_TRUE(Predicate::PriceBetween(100.5, 101.0).Matches(tick));
+    EXPECT_TRUE(Predicate::PriceBetween(100.0, 100.5).Matches(tick));
+    EXPECT_FALSE(Predicate::PriceBetween(100.6, 101.0).Matches(tick));
+
+    EXPECT_TRUE(Predicate::VolumeAtLeast(50).Matches(tick));
+    EXPECT_FALSE(Predicate::VolumeAtLeast(51).Matches(tick));
+
+    EXPECT_FALSE(Predicate::ConditionNotIn({TradeConditions::kOddLotTrade}).Matches(tick));
+    EXPECT_TRUE(Predicate::ConditionNotIn({TradeConditions::kCancelled}).Matches(tick));
+    EXPECT_TRUE(Predicate::ConditionNotIn({}).Matches(tick));
+  }
+
+  static auto combine_test() -> void {
+    auto tick = Tick(1, 100.5, 50, 3, 2);
+    auto symbol = Predicate::SymbolIs(3), volume = Predicate::VolumeAtLeast(100);
+
+    EXPECT_FALSE((symbol && volume).Matches(tick));
+    EXPECT_FALSE(symbol.And(volume).Matches(tick));
+    EXPECT_TRUE((symbol || volume).Matches(tick));
+    EXPECT_TRUE(volume.Or(symbol).Matches(tick));
+
+    auto nested = (Predicate::ExchangeIs(1) || Predicate::ExchangeIs(2)) &&
+                  Predicate::PriceBetween(100.0, 101.0);
+    EXPECT_TRUE(nested.Matches(tick));
+    EXPECT_FALSE((nested && volume).Matches(tick));
+  }
+};
+
+}
+
+using namespace bolt;
+
+TEST(PredicateTest, ConstructorTest) {
+  PredicateTest::constructor_test();
+}
+
+TEST(PredicateTest, MatchesTest) {
+  PredicateTest::matches_test();
+}
+
+TEST(PredicateTest, CombineTest) {
+  PredicateTest::combine_test();
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include "../src/headers/price_scale.hpp"
+#include <cmath>
+
+namespace bolt {
+
+class PriceScaleTest {
+public:
+  static auto constructor_test() -> void {
+    auto scale = PriceScale();
+    EXPECT_FALSE(scale.IsFixedPoint());
+    EXPECT_DOUBLE_EQ(scale.scale_, 0);
+
+    scale = PriceScale(1e-4);
+    EXPECT_TRUE(scale.IsFixedPoint());
+    EXPECT_DOUBLE_EQ(scale.GetScale(), 1e-4);
+    EXPECT_DOUBLE_EQ(scale.ticks_per_unit_, 10000.0);
+
+    // Non positive scales keep the prices as double
+    scale = PriceScale(-1.0);
+    EXPECT_FALSE(scale.IsFixedPoint());
+  }
+
+  static auto conversion_test() -> void {
+    auto scale = PriceScale(1e-4);
+
+    EXPECT_EQ(scale.ToTicks(100.0123), 1000123);
+    EXPECT_EQ(scale.ToTicks(0.00005), 1);
+    EXPECT_EQ(scale.ToTicks(-1.5), -15000);
+
+    EXPECT_EQ(scale.ToPrice(int64_t(1000123)), 100.0123);
+    EXPECT_EQ(scale.ToPrice(scale.ToTicks(150.25)), 150.25);
+  }
+
+  static auto round_trip_test() -> void {
+    // Scales whose reciprocal is not exactly representable as well
+    for (auto exponent : {2, 4, 5, 9}) {
+      auto units = std::pow(10.0, exponent);
+      auto scale = PriceScale(1.0 / units);
+      EXPECT_EQ(scale.GetTicksPerUnit(), units);
+
+      for (int64_t ticks = 0; ticks < 100000; ticks += 7) {
+        auto price = double(ticks) / units;
+        EXPECT_EQ(scale.ToTicks(price), ticks);
+        EXPECT_EQ(scale.ToPrice(ticks), price);
+      }
+    }
+
+    // A scale without an integral number of ticks per unit is kept as is
+    EXPECT_DOUBLE_EQ(PriceScale(0.3).GetTicksPerUnit(), 1.0 / 0.3);
+  }
+
+  static auto equality_test() -> void {
+    EXPECT_TRUE(PriceScale(1e-4) == PriceScale(1e-4));
+    EXPECT_TRUE(PriceScale(1e-4) != PriceScale(1e-2));
+    EXPECT_TRUE(PriceScale() == PriceScale(0));
+  }
+};
+
+}
+
+using namespace bolt;
+
+TEST(PriceScaleTest, ConstructorTest) {
+  PriceScaleTest::constructor_test();
+}
+
+TEST(PriceScaleTest, ConversionTest) {
+  PriceScaleTest::conversion_test();
+}
+
+TEST(PriceScaleTest, RoundTripTest) {
+  PriceScaleTest::round_trip_test();
+}
+
+TEST(PriceScaleTest, EqualityTest) {
+  PriceScaleTest::equality_test();
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "../src/headers/quantile_sketch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace bolt {
+
+class QuantileSketchTest {
+public:
+  // The rank (fraction of the values strictly below) of a value
+  static auto rank(const std::vector<double> &sorted, double value) -> double {
+    auto below = std::lower_bound(sorted.begin(), sorted.end(), value) - sorted.begin();
+    return double(below) / double(sorted.size());
+  }
+
+  static auto empty_test() -> void {
+    auto sketch = QuantileSketch();
+    EXPECT_EQ(sketch.Count(), 0);
+    EXPECT_EQ(sketch.Quantiles(std::vector<double>{0.0, 0.5, 1.0}),
+              (std::vector<double>{0.0, 0.0, 0.0}));
+  }
+
+  static auto exact_test() -> void {
+    auto sketch = QuantileSketch();
+    for (auto value : {5.0, 1.0, 4.0, 2.0, 3.0}) sketch.Add(value);
+
+    EXPECT_EQ(sketch.Count(), 5);
+    EXPECT_EQ(sketch.levels_.size(), 1);
+    EXPECT_EQ(sketch.Quantiles(std::vector<double>{0.0, 0.4, 0.5, 0.99, 1.0}),
+              (std::vector<double>{1.0, 2.0, 3.0, 5.0, 5.0}));
+  }
+
+  static auto rank_error_test() -> void {
+    auto values = std::vector<double>{};
+    auto sketch = QuantileSketch();
+    for (uint64_t i = 0; i < 200000; i++) {
+      // A permutation of [0, 200000)
+      auto value = double((i * 7919) % 200000);
+      values.push_back(value);
+      sketch.Add(value);
+    }
+    std::sort(values.begin(), values.end());
+
+    EXPECT_EQ(sketch.Count(), values.size());
+    EXPECT_LT(sketch.size_, 2000);
+
+    auto qs = std::vector<double>{0.0, 0.01, 0.25, 0.5, 0.75, 0.95, 0.99, 1.0};
+    auto result = sketch.Quantiles(qs);
+    for (size_t i = 0; i < qs.size(); i++) {
+      EXPECT_NEAR(rank(values, result[i]), qs[i], 0.01) << qs[i];
+    }
+    EXPECT_EQ(result.front(), values.front());
+    EXPECT_EQ(result.back(), values.back());
+  }
+
+  static auto merge_test() -> void {
+    auto values = std::vector<double>{};
+    auto merged = QuantileSketch();
+    for (uint64_t part = 0; part < 20; part++) {
+      auto sketch = QuantileSketch();
+      for (uint64_t i = 0; i < 10000; i++) {
+        auto value = double(part * 10000 + i) + (part % 2 ? 0.5 : 0.0);
+        values.push_back(value);
+        sketch.Add(value);
+      }
+      merged.Merge(sketch);
+    }
+    std::sort(values.begin(), values.end());
+
+    EXPECT_EQ(merged.Count(), values.size());
+    EXPECT_LT(merged.size_, 2000);
+
+    auto qs = std::vector<double>{0.1, 0.5, 0.9, 0.99};
+    auto result = merged.Quantiles(qs);
+    for (size_t i = 0; i < qs.size(); i++) {
+      EXPECT_NEAR(rank(values, result[i]), qs[i], 0.01) << qs[i];
+    }
+
+    // Merging an empty sketch changes nothing
+    merged.Merge(QuantileSketch());
+    EXPECT_EQ(merged.Quantiles(qs), result);
+  }
+};
+
+TEST(QuantileSketchTest, EmptyTest) {
+  QuantileSketchTest::empty_test();
+}
+
+TEST(QuantileSketchTest, ExactTest) {
+  QuantileSketchTest::exact_test();
+}
+
+TEST(QuantileSketchTest, RankErrorTest) {
+  QuantileSketchTest::rank_error_test();
+}
+
+TEST(QuantileSketchTest, MergeTest) {
+  QuantileSketchTest::merge_test();
+}
+
+}
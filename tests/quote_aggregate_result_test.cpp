@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include "../include/bolt/quote_aggregate_result.hpp"
+
+namespace bolt {
+
+class QuoteAggregateResultTest {
+public:
+  static auto constructor_test() -> void {
+    auto obj = QuoteAggregateResult();
+
+    EXPECT_EQ(obj.count_, {});
+    EXPECT_DOUBLE_EQ(obj.max_spread_, {});
+    EXPECT_DOUBLE_EQ(obj.min_spread_, {});
+    EXPECT_DOUBLE_EQ(obj.avg_spread_, {});
+    EXPECT_DOUBLE_EQ(obj.time_weighted_spread_, {});
+
+    obj = QuoteAggregateResult(10, 0.5, 0.1, 0.25, 0.2);
+
+    EXPECT_EQ(obj.count_, 10);
+    EXPECT_DOUBLE_EQ(obj.max_spread_, 0.5);
+    EXPECT_DOUBLE_EQ(obj.min_spread_, 0.1);
+    EXPECT_DOUBLE_EQ(obj.avg_spread_, 0.25);
+    EXPECT_DOUBLE_EQ(obj.time_weighted_spread_, 0.2);
+  }
+
+  static auto getter_and_setter_test() -> void {
+    auto obj = QuoteAggregateResult();
+
+    obj.SetCount(10);
+    obj.SetMaxSpread(0.5);
+    obj.SetMinSpread(0.1);
+    obj.SetAvgSpread(0.25);
+    obj.SetTimeWeightedSpread(0.2);
+
+    EXPECT_EQ(obj.GetCount(), 10);
+    EXPECT_DOUBLE_EQ(obj.GetMaxSpread(), 0.5);
+    EXPECT_DOUBLE_EQ(obj.GetMinSpread(), 0.1);
+    EXPECT_DOUBLE_EQ(obj.GetAvgSpread(), 0.25);
+    EXPECT_DOUBLE_EQ(obj.GetTimeWeightedSpread(), 0.2);
+  }
+
+  static auto equality_test() -> void {
+    auto obj = QuoteAggregateResult(10, 0.5, 0.1, 0.25, 0.2);
+
+    EXPECT_TRUE(obj == QuoteAggregateResult(10, 0.5, 0.1, 0.25, 0.2));
+    EXPECT_TRUE(obj != QuoteAggregateResult(10, 0.5, 0.1, 0.25, 0.3));
+    EXPECT_TRUE(obj != QuoteAggregateResult());
+  }
+};
+
+}
+
+using namespace bolt;
+
+TEST(QuoteAggregateResultTest, ConstructorTest) {
+  QuoteAggregateResultTest::constructor_test();
+}
+
+TEST(QuoteAggregateResultTest, GetterAndSetterTest) {
+  QuoteAggregateResultTest::getter_and_setter_test();
+}
+
+TEST(QuoteAggregateResultTest, EqualityTest) {
+  QuoteAggregateResultTest::equality_test();
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include "../include/bolt/quote.hpp"
+
+namespace bolt {
+
+class QuoteTest {
+public:
+  static auto constructor_test() -> void {
+    auto quote = Quote();
+    EXPECT_EQ(quote.timestamp_, 0);
+    EXPECT_EQ(quote.symbol_id_, 0);
+    EXPECT_EQ(quote.exchange_id_, 0);
+    EXPECT_DOUBLE_EQ(quote.bid_price_, 0);
+    EXPECT_DOUBLE_EQ(quote.ask_price_, 0);
+    EXPECT_EQ(quote.bid_size_, 0);
+    EXPECT_EQ(quote.ask_size_, 0);
+
+    quote = Quote(1001, 99.5, 100, 100.5, 200);
+    EXPECT_EQ(quote.timestamp_, 1001);
+    EXPECT_DOUBLE_EQ(quote.bid_price_, 99.5);
+    EXPECT_EQ(quote.bid_size_, 100);
+    EXPECT_DOUBLE_EQ(quote.ask_price_, 100.5);
+    EXPECT_EQ(quote.ask_size_, 200);
+    EXPECT_EQ(quote.symbol_id_, 0);
+
+    quote = Quote(1001, 99.5, 100, 100.5, 200, 7, 2);
+    EXPECT_EQ(quote.symbol_id_, 7);
+    EXPECT_EQ(quote.exchange_id_, 2);
+  }
+
+  static auto getters_and_setters_test() -> void {
+    auto quote = Quote(1001, 99.5, 100, 100.5, 200, 7, 2);
+
+    EXPECT_EQ(quote.GetTimestamp(), 1001);
+    EXPECT_DOUBLE_EQ(quote.GetBidPrice(), 99.5);
+    EXPECT_EQ(quote.GetBidSize(), 100);
+    EXPECT_DOUBLE_EQ(quote.GetAskPrice(), 100.5);
+    EXPECT_EQ(quote.GetAskSize(), 200);
+    EXPECT_EQ(quote.GetSymbolId(), 7);
+    EXPECT_EQ(quote.GetExchangeId(), 2);
+    EXPECT_DOUBLE_EQ(quote.GetSpread(), 1.0);
+
+    quote.SetTimeStamp(1002);
+    quote.SetBid(99.75, 50);
+    quote.SetAsk(100.25, 60);
+    quote.SetSymbolId(8);
+    quote.SetExchangeId(3);
+
+    EXPECT_TRUE(quote == Quote(1002, 99.75, 50, 100.25, 60, 8, 3));
+    EXPECT_DOUBLE_EQ(quote.GetSpread(), 0.5);
+  }
+
+  static auto serialize_and_deserialize_test() -> void {
+    auto quote = Quote(1001, 99.5, 100, 100.5, 200, 7, 2);
+
+    char serialized_buffer[Quote::GetSerializedSize()];
+    quote.Serialize(serialized_buffer);
+
+    auto deserialized_quote = Quote();
+    deserialized_quote.Deserialize(serialized_buffer);
+
+    EXPECT_TRUE(deserialized_quote == quote);
+    EXPECT_TRUE(Quote(quote.ToRecord()) == quote);
+    EXPECT_EQ(Quote::GetSerializedSize(), 40);
+  }
+};
+
+}
+
+using namespace bolt;
+
+TEST(QuoteTest, ConstructorTest) {
+  QuoteTest::constructor_test();
+}
+
+TEST(QuoteTest, GettersAndSettersTest) {
+  QuoteTest::getters_and_setters_test();
+}
+
+TEST(QuoteTest, SerializeAndDeserializeTest) {
+  QuoteTest::serialize_and_deserialize_test();
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+
+#include "../include/bolt/database.hpp"
+#include "../include/bolt/range_cursor.hpp"
+#include "../include/bolt/tick.hpp"
+#include "../src/headers/buffer.hpp"
+
+namespace bolt {
+
+class RangeCursorTest {
+public:
+  static auto slice_test() -> void {
+    auto buffer = Buffer(std::vector<Tick>{
+      Tick(100, 1.5, 10, 1, 2, TradeConditions::kCashSale),
+      Tick(101, 2.5, 20, 3, 4),
+      Tick(102, 3.5, 30, 5, 6)
+    });
+
+    auto slice = TickSlice(buffer, 1, 3, true);
+    EXPECT_EQ(slice.Size(), 2);
+    EXPECT_TRUE(slice.IsSorted());
+    EXPECT_FALSE(slice.IsFixedPoint());
+
+    EXPECT_EQ(slice.GetTimestamps().data(), buffer.GetTimestamps().data() + 1);
+    EXPECT_EQ(slice.GetTimestamps()[0], 101);
+    EXPECT_DOUBLE_EQ(slice.GetPrices()[1], 3.5);
+    EXPECT_TRUE(slice.GetPriceTicks().empty());
+
+    auto view = slice[1];
+    EXPECT_EQ(view.GetTimestamp(), 102);
+    EXPECT_DOUBLE_EQ(view.GetPrice(), 3.5);
+    EXPECT_EQ(view.GetVolume(), 30);
+    EXPECT_EQ(view.GetSymbolId(), 5);
+    EXPECT_EQ(view.GetExchangeId(), 6);
+    EXPECT_TRUE(view.ToTick() == buffer.GetTick(2));
+
+    auto volumes = uint64_t{};
+    for (const auto &row : slice) volumes += row.GetVolume();
+    EXPECT_EQ(volumes, 50);
+
+    auto fixed_buffer = Buffer(2, PriceScale(0.01));
+    fixed_buffer.InsertTick(Tick(100, 100.25, 10));
+
+    auto fixed_slice = TickSlice(fixed_buffer, 0, 1, true);
+    EXPECT_TRUE(fixed_slice.IsFixedPoint());
+    EXPECT_TRUE(fixed_slice.GetPrices().empty());
+    EXPECT_EQ(fixed_slice.GetPriceTicks()[0], 10025);
+    EXPECT_EQ(fixed_slice[0].GetPrice(), 100.25);
+  }
+
+  static auto cursor_test() -> void {
+    auto db = Database();
+    db.Insert({
+      Tick(100, 1.1, 1),
+      Tick(101, 1.1, 2),
+      Tick(99, 1.1, 3),
+      Tick(102, 1.1, 4),
+      Tick(103, 1.1, 5)
+    });
+    db.Flush();
+
+    // {100, 101} and {102, 103} are in range, 99 splits them
+    auto cursor = db.GetRangeCursor(100, 103);
+    EXPECT_EQ(cursor.Size(), 4);
+    EXPECT_EQ(cursor.GetSlices().size(), 2);
+    EXPECT_TRUE(cursor.IsSorted());
+
+    auto timestamps = std::vector<uint64_t>{};
+    for (const auto &row : cursor) timestamps.push_back(row.GetTimestamp());
+    EXPECT_EQ(timestamps, (std::vector<uint64_t>{100, 101, 102, 103}));
+
+    cursor = db.GetRangeCursor(99, 103);
+    EXPECT_EQ(cursor.Size(), 5);
+    EXPECT_EQ(cursor.GetSlices().size(), 1);
+    EXPECT_FALSE(cursor.IsSorted());
+
+    EXPECT_TRUE(db.GetRangeCursor(300, 200).Empty());
+
+    cursor = db.GetRangeCursor(200, 300);
+    EXPECT_TRUE(cursor.Empty());
+    EXPECT_TRUE(cursor.begin() == cursor.end());
+  }
+
+  static auto pinned_state_test() -> void {
+    auto db = Database();
+
+    auto ticks = std::vector<Tick>{};
+    for (int i = 0; i < 100; i++) {
+      ticks.emplace_back(Tick(1000 - i, 1.0 * i, i));
+    }
+    db.Insert(ticks);
+    db.Flush();
+
+    auto cursor = db.GetRangeCursor(0, 2000);
+    ASSERT_EQ(cursor.Size(), 100);
+    auto first = (*cursor.begin()).ToTick();
+
+    // Seals (and sorts) the buffer the cursor is reading from
+    ticks.clear();
+    for (int i = 0; i < 20000; i++) {
+      ticks.emplace_back(Tick(i, 1.0, 1));
+    }
+    db.Insert(ticks);
+    db.Flush();
+
+    EXPECT_EQ(cursor.Size(), 100);
+    EXPECT_TRUE((*cursor.begin()).ToTick() == first);
+
+    auto volumes = uint64_t{};
+    for (const auto &row : cursor) volumes += row.GetVolume();
+    EXPECT_EQ(volumes, 99 * 100 / 2);
+
+    auto sealed_cursor = db.GetRangeCursor(0, 999);
+    EXPECT_TRUE(std::all_of(sealed_cursor.GetSlices().begin(),
+                            sealed_cursor.GetSlices().end(),
+                            [](const TickSlice &slice) { return slice.IsSorted(); }));
+  }
+};
+
+}
+
+using namespace bolt;
+
+TEST(RangeCursorTest, SliceTest) {
+  RangeCursorTest::slice_test();
+}
+
+TEST(RangeCursorTest, CursorTest) {
+  RangeCursorTest::cursor_test();
+}
+
+TEST(RangeCursorTest, PinnedStateTest) {
+  RangeCursorTest::pinned_state_test();
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include "../src/headers/raw_buffer.hpp"
+#include "../include/bolt/schema.hpp"
+
+namespace bolt {
+
+using FeedSchema = Schema<
+  Column<columns::Timestamp, uint64_t>,
+  Column<columns::ExchangeId, uint16_t>,
+  Column<columns::Price, double>
+>;
+
+using FeedRecord = Record<FeedSchema>;
+
+class RawBufferTest {
+public:
+  static auto make_layout() -> RawLayout {
+    return std::make_shared<const std::vector<size_t>>(FeedSchema::GetColumnWidths());
+  }
+
+  static auto insert(RawBuffer &buffer, const FeedRecord &record) -> void {
+    char row[FeedSchema::kRowSize];
+    record.Serialize(row);
+    buffer.InsertRecord(RawRecord(row));
+  }
+
+  static auto read(const RawBuffer &buffer, size_t index) -> FeedRecord {
+    char row[FeedSchema::kRowSize];
+    buffer.GetRow(index, row);
+
+    auto record = FeedRecord();
+    record.Deserialize(row);
+    return record;
+  }
+
+  static auto insert_and_read_test() -> void {
+    auto buffer = RawBuffer(make_layout(), 4);
+    EXPECT_EQ(buffer.columns_.size(), 2);
+    EXPECT_EQ(buffer.columns_[0].capacity(), 4 * sizeof(uint16_t));
+    EXPECT_EQ(buffer.columns_[1].capacity(), 4 * sizeof(double));
+    EXPECT_EQ(buffer.GetRowSize(), FeedSchema::kRowSize);
+
+    insert(buffer, FeedRecord(1001, uint16_t(1), 100.5));
+    insert(buffer, FeedRecord(1002, uint16_t(2), 100.6));
+
+    EXPECT_EQ(buffer.Size(), 2);
+    EXPECT_EQ(buffer.GetTimestamps(), (std::vector<uint64_t>{1001, 1002}));
+    EXPECT_TRUE(read(buffer, 0) == FeedRecord(1001, uint16_t(1), 100.5));
+    EXPECT_TRUE(read(buffer, 1) == FeedRecord(1002, uint16_t(2), 100.6));
+
+    auto exchange = uint16_t{};
+    std::memcpy(&exchange, buffer.GetValue(1, 1), sizeof(exchange));
+    EXPECT_EQ(exchange, 2);
+  }
+
+  static auto sort_test() -> void {
+    auto buffer = RawBuffer(make_layout());
+    insert(buffer, FeedRecord(1003, uint16_t(3), 100.7));
+    insert(buffer, FeedRecord(1001, uint16_t(1), 100.5));
+    insert(buffer, FeedRecord(1002, uint16_t(2), 100.6));
+    EXPECT_FALSE(buffer.IsSorted());
+
+    auto sorted = buffer.SortedCopy();
+    EXPECT_TRUE(sorted.IsSorted());
+    EXPECT_EQ(sorted.GetTimestamps(), (std::vector<uint64_t>{1001, 1002, 1003}));
+    EXPECT_TRUE(read(sorted, 0) == FeedRecord(1001, uint16_t(1), 100.5));
+    EXPECT_TRUE(read(sorted, 2) == FeedRecord(1003, uint16_t(3), 100.7));
+
+    EXPECT_EQ(sorted.GetRange(1002, 1003), (std::pair<size_t, size_t>{1, 3}));
+    EXPECT_EQ(sorted.GetRange(1004, 1005), (std::pair<size_t, size_t>{3, 3}));
+
+    auto copy = buffer.Copy();
+    EXPECT_TRUE(copy == buffer);
+    EXPECT_TRUE(copy != sorted);
+  }
+
+  static auto memory_usage_test() -> void {
+    auto buffer = RawBuffer(make_layout(), 10);
+    EXPECT_EQ(buffer.MemoryUsage(),
+              sizeof(RawBuffer) + 10 * (sizeof(uint64_t) + sizeof(uint16_t) + sizeof(double)));
+  }
+};
+
+TEST(RawBufferTest, InsertAndReadTest) {
+  RawBufferTest::insert_and_read_test();
+}
+
+TEST(RawBufferTest, SortTest) {
+  RawBufferTest::sort_test();
+}
+
+TEST(RawBufferTest, MemoryUsageTest) {
+  RawBufferTest::memory_usage_test();
+}
+
+}
@@ -2,6 +2,7 @@
 
 #include "../src/headers/ring_buffer.hpp"
 #include "../include/bolt/tick.hpp"
+#include "../include/bolt/quote.hpp"
 
 namespace bolt {
 
@@ -120,6 +121,24 @@ public:
     }
   }
 
+  static auto quote_ingestion_test() -> void {
+    auto ring_buffer = QuoteRingBuffer();
+
+    auto quotes = std::vector<Quote>{
+      Quote(100, 9.9, 10, 10.1, 20, 1, 1),
+      Quote(101, 9.8, 10, 10.2, 20, 2, 1)
+    };
+
+    for (const auto &quote : quotes) {
+      EXPECT_TRUE(ring_buffer.Insert(quote));
+    }
+
+    EXPECT_TRUE(*ring_buffer.Read() == quotes[0]);
+    EXPECT_TRUE(*ring_buffer.Read() == quotes[1]);
+    EXPECT_FALSE(ring_buffer.Read());
+    EXPECT_TRUE(ring_buffer.IsEmpty());
+  }
+
 private:
   static auto get_n_dummy_ticks_(int iterations, int multiple) -> std::vector<Tick> {
     if (iterations <= 0) return {};
@@ -148,3 +167,7 @@ TEST(RingBufferTest, EmptyFullBufferTest) {
 TEST(RingBufferTest, SingleConsumerMultipleProducerTest) {
   RingBufferTest::scmp_test();
 }
+
+TEST(RingBufferTest, QuoteIngestionTest) {
+  RingBufferTest::quote_ingestion_test();
+}
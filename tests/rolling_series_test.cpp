@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <cmath>
+
+#include "../include/bolt/database.hpp"
+#include "../include/bolt/rolling_series.hpp"
+#include "../include/bolt/tick.hpp"
+
+namespace bolt {
+
+class RollingSeriesTest {
+public:
+  static auto metrics_test() -> void {
+    auto series = RollingSeries(RollingMetric::kSma | RollingMetric::kVolume);
+    EXPECT_EQ(series.Size(), 0);
+    EXPECT_TRUE(series.Has_(RollingMetric::kSma));
+    EXPECT_FALSE(series.Has_(RollingMetric::kEma));
+    EXPECT_EQ(series.GetMetrics(), RollingMetric::kSma | RollingMetric::kVolume);
+
+    auto db = Database();
+    db.Insert({
+      Tick(100, 10.0, 1, 1, 0),
+      Tick(103, 20.0, 3, 2, 0),
+      Tick(101, 14.0, 2, 1, 0),
+      Tick(106, 12.0, 1, 1, 0)
+    });
+    db.Flush();
+
+    series = db.Rolling(101, 110, 5, RollingMetric::kSma | RollingMetric::kVolume);
+    EXPECT_EQ(series.GetTimestamps(), (std::vector<uint64_t>{101, 103, 106}));
+    EXPECT_EQ(series.GetSma(), (std::vector<double>{12.0, 44.0 / 3, 46.0 / 3}));
+    EXPECT_EQ(series.GetVolumes(), (std::vector<uint64_t>{3, 6, 6}));
+    EXPECT_TRUE(series.GetEma().empty());
+    EXPECT_TRUE(series.GetMinPrices().empty());
+
+    series = db.Rolling(0, 1000, 5, RollingMetric::kAll, 1);
+    EXPECT_EQ(series.GetTimestamps(), (std::vector<uint64_t>{100, 101, 106}));
+    EXPECT_EQ(series.GetMinPrices(), (std::vector<double>{10.0, 10.0, 12.0}));
+    EXPECT_EQ(series.GetMaxPrices(), (std::vector<double>{10.0, 14.0, 14.0}));
+    EXPECT_DOUBLE_EQ(series.GetVwap()[1], (10.0 + 28.0) / 3);
+    EXPECT_DOUBLE_EQ(series.GetStdDev()[1], 2.0);
+    EXPECT_DOUBLE_EQ(series.GetStdDev()[0], 0.0);
+
+    auto ema = 10.0 + (1.0 - std::exp(-1.0 / 5)) * 4.0;
+    EXPECT_DOUBLE_EQ(series.GetEma()[1], ema);
+    EXPECT_DOUBLE_EQ(series.GetEma()[2], ema + (1.0 - std::exp(-1.0)) * (12.0 - ema));
+
+    EXPECT_EQ(db.Rolling(200, 300, 5).Size(), 0);
+    EXPECT_EQ(db.Rolling(300, 200, 5).Size(), 0);
+  }
+
+  static auto overlapping_buffers_test() -> void {
+    auto config = Config();
+    config.SetPriceScale(1e-4);
+    auto db = Database(config);
+
+    // Overlapping sealed buffers and an unsorted active one
+    auto ticks = std::vector<Tick>{};
+    for (uint32_t i = 0; i < 35000; i++) {
+      auto ts = (uint64_t(i) * 7919) % 20000;
+      ticks.emplace_back(Tick(ts, 100.0 + double(i % 17) * 1e-4, i % 9 + 1, i % 3, 0));
+    }
+    db.Insert(ticks);
+    db.Flush();
+
+    auto window = uint64_t{250};
+    auto series = db.Rolling(5000, 15000, window, RollingMetric::kAll, 2);
+    auto expected = db.GetForRange(5000, 15000, Predicate::SymbolIs(2));
+    ASSERT_EQ(series.Size(), expected.size());
+
+    // Every point matches aggregating its window from scratch, the ticks
+    // sharing the timestamp of the point only up to the point itself.
+    for (size_t i = 0; i < series.Size(); i += 97) {
+      auto ts = expected[i].GetTimestamp();
+      ASSERT_EQ(series.GetTimestamps()[i], ts);
+
+      auto ties = size_t{};
+      for (auto j = i + 1; j < expected.size() && expected[j].GetTimestamp() == ts; j++) ties++;
+      if (ties > 0) continue;
+
+      auto result = db.Aggregate(ts - window, ts, Predicate::SymbolIs(2));
+      EXPECT_EQ(series.GetSma()[i], result.GetAvgPrice());
+      EXPECT_EQ(series.GetVwap()[i], result.GetVwap());
+      EXPECT_EQ(series.GetMinPrices()[i], result.GetMinPrice());
+      EXPECT_EQ(series.GetMaxPrices()[i], result.GetMaxPrice());
+      EXPECT_EQ(series.GetVolumes()[i], result.GetTotalVolume());
+    }
+  }
+};
+
+}
+
+using namespace bolt;
+
+TEST(RollingSeriesTest, MetricsTest) {
+  RollingSeriesTest::metrics_test();
+}
+
+TEST(RollingSeriesTest, OverlappingBuffersTest) {
+  RollingSeriesTest::overlapping_buffers_test();
+}
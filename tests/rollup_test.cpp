@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include "../src/headers/rollup.hpp"
+#include "../include/bolt/aggregate_result.hpp"
+
+#include <vector>
+
+namespace bolt {
+
+class RollupTest {
+public:
+  static auto leaf(int64_t price_ticks, uint32_t volume) -> AggregateAccumulator {
+    auto summary = AggregateAccumulator(PriceScale(1e-2));
+    summary.AddFixed(price_ticks, volume);
+    return summary;
+  }
+
+  static auto expected(const std::vector<AggregateAccumulator> &leaves,
+                       size_t begin, size_t end) -> AggregateResult {
+    auto result = AggregateAccumulator(PriceScale(1e-2));
+    for (auto i = begin; i < end; i++) result.Merge(leaves[i]);
+    return result.ToResult();
+  }
+
+  static auto query(const Rollup &rollup, size_t begin, size_t end) -> AggregateResult {
+    auto result = AggregateAccumulator(PriceScale(1e-2));
+    result.Merge(rollup.Query(begin, end));
+    return result.ToResult();
+  }
+
+  static auto push_back_test() -> void {
+    auto rollup = Rollup();
+    auto leaves = std::vector<AggregateAccumulator>{};
+
+    for (int64_t i = 0; i < 37; i++) {
+      leaves.push_back(leaf(1000 + (i * 37) % 11, uint32_t(i + 1)));
+      rollup = rollup.PushBack(leaves.back(), i * 10, i * 10 + 9);
+    }
+
+    EXPECT_EQ(rollup.Size(), 37);
+    EXPECT_EQ(rollup.capacity_, 64);
+    EXPECT_TRUE(rollup.IsOrdered());
+
+    for (size_t begin = 0; begin <= leaves.size(); begin++) {
+      for (auto end = begin; end <= leaves.size(); end++) {
+        EXPECT_TRUE(query(rollup, begin, end) == expected(leaves, begin, end));
+      }
+    }
+  }
+
+  static auto pop_front_test() -> void {
+    auto rollup = Rollup();
+    auto leaves = std::vector<AggregateAccumulator>{};
+
+    for (int64_t i = 0; i < 20; i++) {
+      leaves.push_back(leaf(1000 + i, 1));
+      rollup = rollup.PushBack(leaves.back(), i, i);
+    }
+
+    // Earlier versions stay untouched
+    auto before = rollup;
+    for (int i = 0; i < 5; i++) rollup = rollup.PopFront();
+    leaves.erase(leaves.begin(), leaves.begin() + 5);
+
+    EXPECT_EQ(before.Size(), 20);
+    EXPECT_EQ(rollup.Size(), 15);
+    EXPECT_TRUE(query(rollup, 0, 15) == expected(leaves, 0, 15));
+    EXPECT_TRUE(query(rollup, 3, 7) == expected(leaves, 3, 7));
+    EXPECT_EQ(before.Query(0, 20).GetCount(), 20);
+
+    // Growing after popping keeps the positions
+    leaves.push_back(leaf(5, 3));
+    rollup = rollup.PushBack(leaves.back(), 100, 100);
+    EXPECT_TRUE(query(rollup, 0, 16) == expected(leaves, 0, 16));
+    EXPECT_TRUE(query(rollup, 15, 16) == expected(leaves, 15, 16));
+
+    while (rollup.Size() > 0) rollup = rollup.PopFront();
+    EXPECT_FALSE(rollup.root_);
+    EXPECT_EQ(rollup.Query(0, 0).GetCount(), 0);
+  }
+
+  static auto ordered_test() -> void {
+    auto rollup = Rollup()
+      .PushBack(leaf(1, 1), 0, 10)
+      .PushBack(leaf(1, 1), 10, 20);
+    EXPECT_TRUE(rollup.IsOrdered());
+
+    rollup = rollup.PushBack(leaf(1, 1), 15, 30);
+    EXPECT_FALSE(rollup.IsOrdered());
+  }
+};
+
+}
+
+using namespace bolt;
+
+TEST(RollupTest, PushBackTest) {
+  RollupTest::push_back_test();
+}
+
+TEST(RollupTest, PopFrontTest) {
+  RollupTest::pop_front_test();
+}
+
+TEST(RollupTest, OrderedTest) {
+  RollupTest::ordered_test();
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "../include/bolt/schema.hpp"
+
+namespace bolt {
+
+using NarrowSchema = Schema<
+  Column<columns::Timestamp, uint64_t>,
+  Column<columns::ExchangeId, uint16_t>,
+  Column<columns::Price, double>,
+  Column<columns::AggressorSide, uint8_t>
+>;
+
+class SchemaTest {
+public:
+  static auto schema_properties_test() -> void {
+    EXPECT_EQ(TickSchema::kColumnCount, 6);
+    EXPECT_EQ(TickSchema::kRowSize, 29);
+
+    EXPECT_EQ(NarrowSchema::kColumnCount, 4);
+    EXPECT_EQ(NarrowSchema::kRowSize, 19);
+
+    EXPECT_EQ(NarrowSchema::IndexOf<columns::Timestamp>, 0);
+    EXPECT_EQ(NarrowSchema::IndexOf<columns::AggressorSide>, 3);
+
+    EXPECT_TRUE(NarrowSchema::kHasColumn<columns::Price>);
+    EXPECT_FALSE(NarrowSchema::kHasColumn<columns::TradeCondition>);
+
+    EXPECT_TRUE((std::is_same_v<NarrowSchema::type_of<columns::ExchangeId>, uint16_t>));
+  }
+
+  static auto record_test() -> void {
+    auto record = Record<NarrowSchema>(1001, 7, 100.5, 1);
+
+    EXPECT_EQ(record.GetTimestamp(), 1001);
+    EXPECT_EQ(record.Get<columns::ExchangeId>(), 7);
+    EXPECT_DOUBLE_EQ(record.Get<columns::Price>(), 100.5);
+    EXPECT_EQ(record.Get<columns::AggressorSide>(), 1);
+
+    record.Set<columns::Price>(101.25);
+    EXPECT_DOUBLE_EQ(record.Get<columns::Price>(), 101.25);
+
+    EXPECT_TRUE(record == Record<NarrowSchema>(1001, 7, 101.25, 1));
+    EXPECT_TRUE(record != Record<NarrowSchema>(1002, 7, 101.25, 1));
+  }
+
+  static auto serialize_and_deserialize_test() -> void {
+    auto record = Record<NarrowSchema>(1001, 7, 100.5, 1);
+
+    char serialized_buffer[Record<NarrowSchema>::GetSerializedSize()];
+    record.Serialize(serialized_buffer);
+
+    auto timestamp = uint64_t{};
+    std::memcpy(&timestamp, serialized_buffer, sizeof(timestamp));
+    EXPECT_EQ(timestamp, 1001);
+
+    auto deserialized_record = Record<NarrowSchema>();
+    deserialized_record.Deserialize(serialized_buffer);
+    EXPECT_TRUE(deserialized_record == record);
+  }
+};
+
+}
+
+using namespace bolt;
+
+TEST(SchemaTest, SchemaPropertiesTest) {
+  SchemaTest::schema_properties_test();
+}
+
+TEST(SchemaTest, RecordTest) {
+  SchemaTest::record_test();
+}
+
+TEST(SchemaTest, SerializeAndDeserializeTest) {
+  SchemaTest::serialize_and_deserialize_test();
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include "../src/headers/sliding_window.hpp"
+#include "../src/headers/aggregate_accumulator.hpp"
+#include "../include/bolt/aggregate_result.hpp"
+#include <cmath>
+#include <vector>
+
+namespace bolt {
+
+class SlidingWindowTest {
+public:
+  static auto window_test() -> void {
+    auto window = SlidingWindow(10, PriceScale());
+    EXPECT_EQ(window.Size(), 0);
+    EXPECT_TRUE(window.ToResult() == AggregateResult());
+
+    window.Add(100, 5.0, 1);
+    window.Add(104, 3.0, 2);
+    window.Add(108, 4.0, 3);
+    EXPECT_EQ(window.Size(), 3);
+
+    auto result = window.ToResult();
+    EXPECT_EQ(result.GetCount(), 3);
+    EXPECT_EQ(result.GetTotalVolume(), 6);
+    EXPECT_EQ(result.GetMinPrice(), 3.0);
+    EXPECT_EQ(result.GetMaxPrice(), 5.0);
+
+    // [101, 111], the max retires with the first row
+    window.Add(111, 3.5, 4);
+    result = window.ToResult();
+    EXPECT_EQ(window.Size(), 3);
+    EXPECT_EQ(result.GetTotalVolume(), 9);
+    EXPECT_EQ(result.GetMinPrice(), 3.0);
+    EXPECT_EQ(result.GetMaxPrice(), 4.0);
+
+    // [105, 115], the min retires as well
+    window.Slide(115);
+    result = window.ToResult();
+    EXPECT_EQ(window.Size(), 2);
+    EXPECT_EQ(result.GetMinPrice(), 3.5);
+    EXPECT_EQ(result.GetMaxPrice(), 4.0);
+    EXPECT_DOUBLE_EQ(result.GetVwap(), (4.0 * 3 + 3.5 * 4) / 7);
+
+    // Already before the start of the window
+    window.Add(104, 1.0, 1);
+    EXPECT_EQ(window.Size(), 2);
+
+    // An earlier latest timestamp does not move the window back
+    window.Slide(50);
+    window.Add(106, 1.0, 1);
+    EXPECT_EQ(window.Size(), 3);
+    EXPECT_EQ(window.ToResult().GetMinPrice(), 1.0);
+
+    window.Slide(1000);
+    EXPECT_EQ(window.Size(), 0);
+    EXPECT_EQ(window.GetStdDev(), 0.0);
+    EXPECT_TRUE(window.ToResult() == AggregateResult());
+  }
+
+  static auto exact_test() -> void {
+    auto price_scale = PriceScale(1e-4);
+    auto window = SlidingWindow(100, price_scale);
+
+    auto prices = std::vector<double>{};
+    for (uint64_t ts = 0; ts < 1000; ts++) {
+      prices.push_back(100.0 + double((ts * 37) % 101) * 1e-4);
+      window.Add(ts, prices.back(), uint32_t(ts % 7 + 1));
+
+      // The same values as aggregating the window from scratch
+      auto expected = AggregateAccumulator(price_scale);
+      for (auto row = ts >= 100 ? ts - 100 : 0; row <= ts; row++) {
+        expected.Add(prices[row], uint32_t(row % 7 + 1));
+      }
+      ASSERT_TRUE(window.ToResult() == expected.ToResult());
+    }
+  }
+
+  static auto std_dev_test() -> void {
+    auto window = SlidingWindow(2, PriceScale());
+
+    window.Add(1, 1e9 + 2.0, 1);
+    window.Add(2, 1e9 + 4.0, 1);
+    window.Add(3, 1e9 + 4.0, 1);
+    window.Add(4, 1e9 + 5.0, 1);
+    window.Add(5, 1e9 + 7.0, 1);
+
+    // {4, 5, 7} around 1e9, without cancelling out
+    EXPECT_NEAR(window.GetStdDev(), std::sqrt(14.0 / 9), 1e-6);
+  }
+
+  static auto drift_test() -> void {
+    auto window = SlidingWindow(100, PriceScale());
+
+    // Far away prices leave rounding errors in the sums once subtracted again
+    for (uint64_t i = 0; i < 10000; i++) {
+      window.Add(i, i < 5000 ? 1e15 + double(i) : 0.1, 1);
+    }
+    EXPECT_EQ(window.Size(), 101);
+    EXPECT_LT(window.retired_since_rebuild_, 4096);
+
+    auto result = window.ToResult();
+    EXPECT_EQ(result.GetCount(), 101);
+    EXPECT_NEAR(result.GetVwap(), 0.1, 1e-12);
+    EXPECT_DOUBLE_EQ(result.GetMaxPrice(), 0.1);
+    EXPECT_NEAR(window.GetStdDev(), 0.0, 1e-12);
+  }
+};
+
+}
+
+using namespace bolt;
+
+TEST(SlidingWindowTest, WindowTest) {
+  SlidingWindowTest::window_test();
+}
+
+TEST(SlidingWindowTest, ExactTest) {
+  SlidingWindowTest::exact_test();
+}
+
+TEST(SlidingWindowTest, StdDevTest) {
+  SlidingWindowTest::std_dev_test();
+}
+
+TEST(SlidingWindowTest, DriftTest) {
+  SlidingWindowTest::drift_test();
+}
@@ -88,6 +88,25 @@ public:
 
     EXPECT_TRUE(state.active_buffer_ == state.GetActiveBuffer());
     EXPECT_TRUE(state.sealed_buffers_ == state.GetSealedBuffers());
+    EXPECT_EQ(state.GetRetentionHorizon(), 0);
+
+    state = State(
+      std::make_shared<Buffer>(active_buffer.Copy()),
+      std::make_shared<State::sealed_list>(sealed_buffer),
+      100
+    );
+    EXPECT_EQ(state.retention_horizon_, state.GetRetentionHorizon());
+    EXPECT_EQ(state.GetRetentionHorizon(), 100);
+
+    // Without a published size the whole active buffer is visible
+    EXPECT_EQ(state.GetActiveSize(), 1);
+
+    state = State(
+      std::make_shared<Buffer>(active_buffer.Copy()),
+      std::make_shared<State::sealed_list>(sealed_buffer),
+      100, 0
+    );
+    EXPECT_EQ(state.GetActiveSize(), 0);
   }
 
   static auto setters_test() -> void {
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include "../src/headers/subscription.hpp"
+#include "../include/bolt/aggregate_result.hpp"
+#include "../include/bolt/tick.hpp"
+#include <vector>
+
+namespace bolt {
+
+class SubscriptionTest {
+public:
+  static auto update_test() -> void {
+    auto results = std::vector<AggregateResult>{};
+    auto subscription = Subscription(10, Predicate::SymbolIs(1), PriceScale(),
+                                     [&results](const AggregateResult &result) {
+      results.push_back(result);
+    });
+
+    EXPECT_EQ(subscription.GetWindow(), 10);
+    EXPECT_TRUE(subscription.GetResult() == AggregateResult());
+
+    subscription.Update(Tick(100, 2.0, 10, 1, 0));
+    subscription.Update(Tick(101, 9.0, 10, 2, 0));
+    subscription.Update(Tick(105, 4.0, 30, 1, 0));
+
+    // The other symbol neither changes the values nor notifies
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_TRUE(subscription.GetResult() == results.back());
+    EXPECT_TRUE(subscription.GetResult() == AggregateResult(2, 40, 4.0, 2.0, 3.0, 3.5));
+
+    // Slides the window past the first tick of the symbol
+    subscription.Update(Tick(111, 9.0, 10, 2, 0));
+    ASSERT_EQ(results.size(), 3);
+    EXPECT_TRUE(subscription.GetResult() == AggregateResult(1, 30, 4.0, 4.0, 4.0, 4.0));
+
+    subscription.Update(Tick(112, 9.0, 10, 2, 0));
+    EXPECT_EQ(results.size(), 3);
+
+    subscription.Update(Tick(200, 9.0, 10, 2, 0));
+    ASSERT_EQ(results.size(), 4);
+    EXPECT_TRUE(subscription.GetResult() == AggregateResult());
+  }
+};
+
+}
+
+using namespace bolt;
+
+TEST(SubscriptionTest, UpdateTest) {
+  SubscriptionTest::update_test();
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include "../include/bolt/database.hpp"
+#include "../src/headers/constants.hpp"
+#include "../src/headers/buffer_manager.hpp"
+#include "../src/headers/state.hpp"
+
+namespace bolt {
+
+using FeedSchema = Schema<
+  Column<columns::Timestamp, uint64_t>,
+  Column<columns::ExchangeId, uint16_t>,
+  Column<columns::SequenceNumber, uint64_t>
+>;
+
+using FeedRecord = Record<FeedSchema>;
+
+class TableTest {
+public:
+  static auto insert_and_range_test() -> void {
+    auto db = Database();
+    auto feed = db.CreateTable<FeedSchema>();
+
+    feed.Insert(FeedRecord(1003, uint16_t(3), uint64_t(12)));
+    feed.Insert({
+      FeedRecord(1001, uint16_t(1), uint64_t(10)),
+      FeedRecord(1002, uint16_t(2), uint64_t(11))
+    });
+    db.Flush();
+
+    auto records = feed.GetForRange(1001, 1002);
+    ASSERT_EQ(records.size(), 2);
+    EXPECT_TRUE(records[0] == FeedRecord(1001, uint16_t(1), uint64_t(10)));
+    EXPECT_TRUE(records[1] == FeedRecord(1002, uint16_t(2), uint64_t(11)));
+
+    EXPECT_EQ(feed.GetColumnForRange<columns::ExchangeId>(1000, 2000),
+              (std::vector<uint16_t>{1, 2, 3}));
+    EXPECT_EQ(feed.GetColumnForRange<columns::SequenceNumber>(1003, 1003),
+              (std::vector<uint64_t>{12}));
+    EXPECT_TRUE(feed.GetForRange(2000, 3000).empty());
+
+    // The tables are kept apart from the ticks
+    EXPECT_EQ(db.Size(), 0);
+  }
+
+  static auto sealed_buffers_test() -> void {
+    auto db = Database();
+    auto feed = db.CreateTable<FeedSchema>();
+
+    auto total = size_t(Constants::kMAXIMUM_SEALED_BUFFER_SIZE) * 2 + 10;
+    auto records = std::vector<FeedRecord>{};
+    for (size_t i = 0; i < total; i++) {
+      // Every other record arrives out of order
+      auto timestamp = uint64_t(i % 2 == 0 ? total + i : i);
+      records.emplace_back(timestamp, uint16_t(i % 4), uint64_t(i));
+    }
+    feed.Insert(records);
+    db.Flush();
+
+    auto state = feed.raw_table_->storage_handler_->GetState();
+    EXPECT_EQ(state->GetSealedBuffers()->size(), 2);
+    EXPECT_EQ(state->GetActiveSize(), 10);
+
+    auto stored = feed.GetForRange(0, 3 * total);
+    ASSERT_EQ(stored.size(), total);
+    EXPECT_TRUE(std::is_sorted(stored.begin(), stored.end(), [](const auto &a, const auto &b) {
+      return a.GetTimestamp() < b.GetTimestamp();
+    }));
+    EXPECT_GT(feed.MemoryUsage(), total * FeedSchema::kRowSize);
+  }
+
+  static auto retention_test() -> void {
+    auto config = Config();
+    config.SetRetentionPeriod(100);
+
+    auto db = Database(config);
+    auto feed = db.CreateTable<FeedSchema>();
+
+    feed.Insert(std::vector<FeedRecord>{
+      FeedRecord(1000, uint16_t(1), uint64_t(1)),
+      FeedRecord(1150, uint16_t(1), uint64_t(2)),
+      FeedRecord(1200, uint16_t(1), uint64_t(3))
+    });
+    db.Flush();
+
+    EXPECT_EQ(feed.GetColumnForRange<columns::SequenceNumber>(0, 2000),
+              (std::vector<uint64_t>{2, 3}));
+  }
+
+  static auto memory_budget_test() -> void {
+    auto config = Config();
+    config.SetMemoryBudget(1000000);
+    config.SetQuoteMemoryShare(0.2);
+    config.SetTableMemoryShare(0.3);
+    auto db = Database(config);
+
+    auto feed = db.CreateTable<FeedSchema>();
+    auto other = db.CreateTable<FeedSchema>();
+    auto last = db.CreateTable<FeedSchema>();
+
+    // Every table takes its share from the ticks, as long as they have any left
+    EXPECT_EQ(db.storage_handler_->memory_budget_, 0);
+    EXPECT_EQ(feed.raw_table_->storage_handler_->memory_budget_, 300000);
+    EXPECT_EQ(other.raw_table_->storage_handler_->memory_budget_, 300000);
+    EXPECT_EQ(last.raw_table_->storage_handler_->memory_budget_, 200000);
+
+    // The stored rows of the tables count towards the footprint of the Database
+    feed.Insert(FeedRecord(1001, uint16_t(1), uint64_t(10)));
+    db.Flush();
+
+    EXPECT_GT(feed.MemoryUsage(), 0);
+    EXPECT_EQ(db.MemoryUsage(), db.storage_handler_->MemoryUsage() +
+                                db.quote_storage_handler_->MemoryUsage() +
+                                feed.MemoryUsage() + other.MemoryUsage() + last.MemoryUsage());
+  }
+};
+
+TEST(TableTest, InsertAndRangeTest) {
+  TableTest::insert_and_range_test();
+}
+
+TEST(TableTest, SealedBuffersTest) {
+  TableTest::sealed_buffers_test();
+}
+
+TEST(TableTest, RetentionTest) {
+  TableTest::retention_test();
+}
+
+TEST(TableTest, MemoryBudgetTest) {
+  TableTest::memory_budget_test();
+}
+
+}
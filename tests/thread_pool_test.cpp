@@ -8,6 +8,7 @@ public:
   static auto constructors_test() -> void {
     auto pool = ThreadPool();
     EXPECT_EQ(pool.workers_.size(), pool.number_of_threads_);
+    EXPECT_EQ(pool.GetThreadCount(), pool.number_of_threads_);
     EXPECT_TRUE(pool.tasks_.empty());
     EXPECT_FALSE(pool.stop_workers_.load(std::memory_order_acquire));
   }
@@ -28,6 +29,30 @@ public:
     }
   }
 
+  static auto queued_task_count_test() -> void {
+    auto pool = ThreadPool();
+    EXPECT_EQ(pool.GetQueuedTaskCount(), 0);
+
+    // Every worker is blocked, the tasks assigned after them stay queued
+    auto release = std::promise<void>();
+    auto released = release.get_future().share();
+    auto results = std::vector<std::future<void>>{};
+
+    for (size_t i = 0; i < pool.GetThreadCount() + 2; i++) {
+      results.push_back(pool.AssignTask([released] { released.wait(); }));
+    }
+    while (pool.GetQueuedTaskCount() > 2) {
+      std::this_thread::yield();
+    }
+    EXPECT_EQ(pool.GetQueuedTaskCount(), 2);
+
+    release.set_value();
+    for (auto &result : results) {
+      result.get();
+    }
+    EXPECT_EQ(pool.GetQueuedTaskCount(), 0);
+  }
+
   static auto shutdown_test() -> void {
     auto pool = ThreadPool();
     auto n = 10;
@@ -89,6 +114,10 @@ TEST(ThreadPoolTest, AssignTaskTest) {
   ThreadPoolTest::assign_task_test();
 }
 
+TEST(ThreadPoolTest, QueuedTaskCountTest) {
+  ThreadPoolTest::queued_task_count_test();
+}
+
 TEST(ThreadPoolTest, ShutdownTest) {
   ThreadPoolTest::shutdown_test();
 }
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include "../include/bolt/database.hpp"
+#include "../include/bolt/tick_columns.hpp"
+#include "../include/bolt/tick.hpp"
+
+namespace bolt {
+
+class TickColumnsTest {
+public:
+  static auto column_selection_test() -> void {
+    auto columns = TickColumns(TickColumn::kPrice | TickColumn::kVolume);
+
+    EXPECT_TRUE(columns.Has_(TickColumn::kPrice));
+    EXPECT_TRUE(columns.Has_(TickColumn::kVolume));
+    EXPECT_FALSE(columns.Has_(TickColumn::kTimestamp));
+    EXPECT_EQ(columns.GetColumns(), TickColumn::kPrice | TickColumn::kVolume);
+
+    EXPECT_TRUE(TickColumns(TickColumn::kAll).Has_(TickColumn::kTradeCondition));
+    EXPECT_FALSE(TickColumns().Has_(TickColumn::kTimestamp));
+  }
+
+  static auto get_columns_for_range_test() -> void {
+    auto db = Database();
+    db.Insert({
+      Tick(100, 1.0, 10, 1, 2),
+      Tick(101, 2.0, 20, 3, 4),
+      Tick(99, 3.0, 30, 5, 6),
+      Tick(102, 4.0, 40, 7, 8, TradeConditions::kCashSale)
+    });
+    db.Flush();
+
+    auto columns = db.GetColumnsForRange(100, 102);
+    EXPECT_EQ(columns.Size(), 3);
+    EXPECT_EQ(columns.GetTimestamps(), (std::vector<uint64_t>{100, 101, 102}));
+    EXPECT_EQ(columns.GetPrices(), (std::vector<double>{1.0, 2.0, 4.0}));
+    EXPECT_EQ(columns.GetVolumes(), (std::vector<uint32_t>{10, 20, 40}));
+    EXPECT_EQ(columns.GetSymbolIds(), (std::vector<uint32_t>{1, 3, 7}));
+    EXPECT_EQ(columns.GetExchangeIds(), (std::vector<uint32_t>{2, 4, 8}));
+    EXPECT_EQ(columns.GetTradeConditions().back(), TradeConditions::kCashSale);
+
+    // Unsorted rows are reordered even without the timestamps requested
+    columns = db.GetColumnsForRange(0, 200, TickColumn::kVolume);
+    EXPECT_EQ(columns.Size(), 4);
+    EXPECT_TRUE(columns.GetTimestamps().empty());
+    EXPECT_TRUE(columns.GetPrices().empty());
+    EXPECT_EQ(columns.GetVolumes(), (std::vector<uint32_t>{30, 10, 20, 40}));
+
+    EXPECT_EQ(db.GetColumnsForRange(200, 300).Size(), 0);
+  }
+
+  static auto fixed_point_test() -> void {
+    auto config = Config();
+    config.SetPriceScale(0.01);
+
+    auto db = Database(config);
+    db.Insert({Tick(100, 100.25, 10), Tick(101, 100.5, 20)});
+    db.Flush();
+
+    auto columns = db.GetColumnsForRange(0, 200, TickColumn::kPrice);
+    EXPECT_EQ(columns.GetPrices(), (std::vector<double>{100.25, 100.5}));
+  }
+};
+
+}
+
+using namespace bolt;
+
+TEST(TickColumnsTest, ColumnSelectionTest) {
+  TickColumnsTest::column_selection_test();
+}
+
+TEST(TickColumnsTest, GetColumnsForRangeTest) {
+  TickColumnsTest::get_columns_for_range_test();
+}
+
+TEST(TickColumnsTest, FixedPointTest) {
+  TickColumnsTest::fixed_point_test();
+}
@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+
+#include "../include/bolt/database.hpp"
+#include "../include/bolt/tick_page.hpp"
+#include "../include/bolt/tick.hpp"
+#include "../src/headers/buffer.hpp"
+
+namespace bolt {
+
+class TickPageTest {
+public:
+  static auto read_all(const Database &db, uint64_t start_ts, uint64_t end_ts,
+                       size_t limit, bool descending) -> std::vector<Tick> {
+    auto ticks = std::vector<Tick>{};
+    auto page = db.GetPage(start_ts, end_ts, limit, descending);
+
+    while (true) {
+      EXPECT_LE(page.GetTicks().size(), limit);
+      ticks.insert(ticks.end(), page.GetTicks().begin(), page.GetTicks().end());
+      if (!page.HasMore()) break;
+
+      EXPECT_EQ(page.GetTicks().size(), limit);
+      page = db.GetPage(page.GetContinuationToken());
+    }
+    return ticks;
+  }
+
+  static auto page_test() -> void {
+    auto db = Database();
+    db.Insert({
+      Tick(103, 1.0, 1),
+      Tick(100, 1.0, 2),
+      Tick(102, 1.0, 3),
+      Tick(100, 1.0, 4),
+      Tick(101, 1.0, 5)
+    });
+    db.Flush();
+
+    auto page = db.GetPage(100, 102, 2);
+    ASSERT_EQ(page.GetTicks().size(), 2);
+    EXPECT_EQ(page.GetTicks()[0].GetVolume(), 2);
+    EXPECT_EQ(page.GetTicks()[1].GetVolume(), 4);
+    EXPECT_TRUE(page.HasMore());
+    EXPECT_TRUE(page.GetContinuationToken().HasMore());
+
+    page = db.GetPage(page.GetContinuationToken());
+    ASSERT_EQ(page.GetTicks().size(), 2);
+    EXPECT_EQ(page.GetTicks()[0].GetVolume(), 5);
+    EXPECT_EQ(page.GetTicks()[1].GetVolume(), 3);
+    EXPECT_FALSE(page.HasMore());
+
+    // Ties are returned in reverse as well
+    page = db.GetPage(0, 1000, 3, true);
+    ASSERT_EQ(page.GetTicks().size(), 3);
+    EXPECT_EQ(page.GetTicks()[0].GetVolume(), 1);
+    EXPECT_EQ(page.GetTicks()[1].GetVolume(), 3);
+    EXPECT_EQ(page.GetTicks()[2].GetVolume(), 5);
+
+    page = db.GetPage(page.GetContinuationToken());
+    ASSERT_EQ(page.GetTicks().size(), 2);
+    EXPECT_EQ(page.GetTicks()[0].GetVolume(), 4);
+    EXPECT_EQ(page.GetTicks()[1].GetVolume(), 2);
+    EXPECT_FALSE(page.HasMore());
+    EXPECT_TRUE(db.GetPage(page.GetContinuationToken()).GetTicks().empty());
+
+    EXPECT_TRUE(db.GetPage(200, 300, 10).GetTicks().empty());
+    EXPECT_TRUE(db.GetPage(300, 200, 10).GetTicks().empty());
+    EXPECT_TRUE(db.GetPage(ContinuationToken()).GetTicks().empty());
+
+    // A page of no rows carries no token, so a page loop never spins
+    page = db.GetPage(0, 1000, 0);
+    EXPECT_TRUE(page.GetTicks().empty());
+    EXPECT_FALSE(page.HasMore());
+
+    // The page is full exactly at the end of the range
+    page = db.GetPage(0, 1000, 5);
+    EXPECT_EQ(page.GetTicks().size(), 5);
+    EXPECT_FALSE(page.HasMore());
+  }
+
+  static auto overlapping_buffers_test() -> void {
+    auto db = Database();
+
+    // Several sealed buffers overlapping each other, the last one still active
+    auto ticks = std::vector<Tick>{};
+    for (uint32_t i = 0; i < 45000; i++) {
+      ticks.emplace_back(Tick((uint64_t(i) * 7919) % 30000, 1.0, i));
+    }
+    db.Insert(ticks);
+    db.Flush();
+
+    auto expected = db.GetForRange(1000, 25000);
+    ASSERT_FALSE(expected.empty());
+
+    EXPECT_EQ(read_all(db, 1000, 25000, 997, false), expected);
+
+    std::reverse(expected.begin(), expected.end());
+    EXPECT_EQ(read_all(db, 1000, 25000, 997, true), expected);
+  }
+
+  static auto pinned_state_test() -> void {
+    auto db = Database();
+
+    auto ticks = std::vector<Tick>{};
+    for (uint32_t i = 0; i < 100; i++) {
+      ticks.emplace_back(Tick(1000 - i, 1.0, i));
+    }
+    db.Insert(ticks);
+    db.Flush();
+
+    auto page = db.GetPage(0, 2000, 30);
+    auto fetched = page.GetTicks();
+
+    // Seals the buffer the token is reading from and adds rows to the range
+    ticks.clear();
+    for (uint32_t i = 0; i < 20000; i++) {
+      ticks.emplace_back(Tick(i % 2000, 1.0, 1));
+    }
+    db.Insert(ticks);
+    db.Flush();
+
+    while (page.HasMore()) {
+      page = db.GetPage(page.GetContinuationToken());
+      fetched.insert(fetched.end(), page.GetTicks().begin(), page.GetTicks().end());
+    }
+
+    ASSERT_EQ(fetched.size(), 100);
+    for (uint32_t i = 0; i < 100; i++) {
+      EXPECT_EQ(fetched[i].GetTimestamp(), 901 + i);
+      EXPECT_EQ(fetched[i].GetVolume(), 99 - i);
+    }
+  }
+
+  static auto pinned_buffers_test() -> void {
+    auto db = Database();
+
+    auto ticks = std::vector<Tick>{};
+    for (uint32_t i = 0; i < 30000; i++) {
+      ticks.emplace_back(Tick(i, 1.0, i));
+    }
+    db.Insert(ticks);
+    db.Flush();
+
+    // Three sealed buffers, only the one holding the range is kept alive by the token
+    auto page = db.GetPage(10000, 10010, 5);
+    ASSERT_TRUE(page.HasMore());
+
+    const auto &token = page.GetContinuationToken();
+    ASSERT_EQ(token.buffers_.size(), 1);
+    EXPECT_EQ(token.buffers_[0]->GetTimestamps().front(), 10000);
+  }
+};
+
+}
+
+using namespace bolt;
+
+TEST(TickPageTest, PageTest) {
+  TickPageTest::page_test();
+}
+
+TEST(TickPageTest, OverlappingBuffersTest) {
+  TickPageTest::overlapping_buffers_test();
+}
+
+TEST(TickPageTest, PinnedStateTest) {
+  TickPageTest::pinned_state_test();
+}
+
+TEST(TickPageTest, PinnedBuffersTest) {
+  TickPageTest::pinned_buffers_test();
+}
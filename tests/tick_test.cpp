@@ -97,6 +97,21 @@ public:
     check_objects_equality_(deserialized_tick, tick);
   }
 
+  static auto record_conversion_test() -> void {
+    auto tick = Tick(1001, 100.223, 100, 1, 2, TradeConditions::kCashSale);
+    auto record = tick.ToRecord();
+
+    EXPECT_EQ(record.Get<columns::Timestamp>(), 1001);
+    EXPECT_DOUBLE_EQ(record.Get<columns::Price>(), 100.223);
+    EXPECT_EQ(record.Get<columns::Volume>(), 100);
+    EXPECT_EQ(record.Get<columns::SymbolId>(), 1);
+    EXPECT_EQ(record.Get<columns::ExchangeId>(), 2);
+    EXPECT_EQ(record.Get<columns::TradeCondition>(), TradeConditions::kCashSale);
+
+    check_objects_equality_(Tick(record), tick);
+    EXPECT_EQ(Tick::GetSerializedSize(), Record<TickSchema>::GetSerializedSize());
+  }
+
 private:
   static auto check_objects_equality_(const Tick &tick1,
                                       const Tick &tick2) -> void {
@@ -136,3 +151,7 @@ TEST(TickTest, EqualityOperatorCheck) {
 TEST(TickTest, SerializeAndDeserializeTest) {
   TickTest::serialize_and_deserialize_test();
 }
+
+TEST(TickTest, RecordConversionTest) {
+  TickTest::record_conversion_test();
+}